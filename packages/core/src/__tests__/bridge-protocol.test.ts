@@ -43,6 +43,20 @@ describe("NativeBridge", () => {
 
   // ---------- message types ------------------------------------------------
 
+  it("should dispatch batched parameter changes", () => {
+    const handler = vi.fn();
+    bridge.onMessage(handler);
+
+    const msg: BridgeInMessage = {
+      type: "parametersChanged",
+      values: { gain: 0.5, cutoff: 1200 },
+    };
+    bridge.dispatch(msg);
+
+    expect(handler).toHaveBeenCalledTimes(1);
+    expect(handler).toHaveBeenCalledWith(msg);
+  });
+
   it("should dispatch transport messages", () => {
     const handler = vi.fn();
     bridge.onMessage(handler);
@@ -140,6 +154,15 @@ describe("NativeBridge", () => {
     expect(handler.mock.calls[1][0].state).toBe('{"gain":0.5,"delay":100}');
   });
 
+  it("should dispatch graphRestored", () => {
+    const handler = vi.fn();
+    bridge.onMessage(handler);
+
+    bridge.dispatch({ type: "graphRestored" });
+
+    expect(handler).toHaveBeenCalledWith({ type: "graphRestored" });
+  });
+
   // ---------- sendGraphOps --------------------------------------------------
 
   it("should format graphOps messages correctly", () => {
@@ -169,6 +192,31 @@ describe("NativeBridge", () => {
     expect(bridge.send).not.toHaveBeenCalled();
   });
 
+  // ---------- sendGraph -----------------------------------------------------
+
+  it("should format setGraph messages correctly", () => {
+    const sent: BridgeOutMessage[] = [];
+    bridge.send = vi.fn((msg: BridgeOutMessage) => sent.push(msg));
+
+    const ops: GraphOp[] = [
+      { op: "addNode", nodeId: "g0", nodeType: "gain", params: { gain: 0.5 } },
+      { op: "setOutput", nodeId: "g0" },
+    ];
+
+    bridge.sendGraph(ops);
+
+    expect(sent).toEqual([{ type: "setGraph", ops }]);
+  });
+
+  it("should send an empty graph so the native side clears", () => {
+    const sent: BridgeOutMessage[] = [];
+    bridge.send = vi.fn((msg: BridgeOutMessage) => sent.push(msg));
+
+    bridge.sendGraph([]);
+
+    expect(sent).toEqual([{ type: "setGraph", ops: [] }]);
+  });
+
   // ---------- sendParamUpdate -----------------------------------------------
 
   it("should format paramUpdate messages correctly", () => {
@@ -236,6 +284,92 @@ describe("NativeBridge", () => {
     });
   });
 
+  // ---------- bindParameter / unbindParameter ------------------------------
+
+  it("should format bindParameter messages correctly", () => {
+    const sent: BridgeOutMessage[] = [];
+    bridge.send = vi.fn((msg: BridgeOutMessage) => sent.push(msg));
+
+    bridge.bindParameter("cutoff", "filter_0", "cutoff");
+    bridge.bindParameter("tone", "filter_0", "cutoff", {
+      min: 200,
+      max: 8000,
+      curve: "logarithmic",
+    });
+
+    expect(sent).toEqual([
+      {
+        type: "bindParameter",
+        id: "cutoff",
+        nodeId: "filter_0",
+        paramName: "cutoff",
+      },
+      {
+        type: "bindParameter",
+        id: "tone",
+        nodeId: "filter_0",
+        paramName: "cutoff",
+        range: { min: 200, max: 8000, curve: "logarithmic" },
+      },
+    ]);
+  });
+
+  it("should format unbindParameter messages correctly", () => {
+    const sent: BridgeOutMessage[] = [];
+    bridge.send = vi.fn((msg: BridgeOutMessage) => sent.push(msg));
+
+    bridge.unbindParameter("filter_0", "cutoff");
+
+    expect(sent[0]).toEqual({
+      type: "unbindParameter",
+      nodeId: "filter_0",
+      paramName: "cutoff",
+    });
+  });
+
+  // ---------- prewarmNodes --------------------------------------------------
+
+  it("should format prewarmNodes messages correctly", () => {
+    const sent: BridgeOutMessage[] = [];
+    bridge.send = vi.fn((msg: BridgeOutMessage) => sent.push(msg));
+
+    bridge.prewarmNodes("delay", 8);
+
+    expect(sent).toEqual([
+      { type: "prewarmNodes", nodeType: "delay", count: 8 },
+    ]);
+  });
+
+  // ---------- memory ----------------------------------------------------------
+
+  it("should format memory budget and report requests correctly", () => {
+    const sent: BridgeOutMessage[] = [];
+    bridge.send = vi.fn((msg: BridgeOutMessage) => sent.push(msg));
+
+    bridge.setMemoryBudget(64 * 1024 * 1024);
+    bridge.requestMemoryReport();
+
+    expect(sent).toEqual([
+      { type: "setMemoryBudget", bytes: 64 * 1024 * 1024 },
+      { type: "getMemoryReport" },
+    ]);
+  });
+
+  // ---------- scheduling -----------------------------------------------------
+
+  it("should format sub-block size messages correctly", () => {
+    const sent: BridgeOutMessage[] = [];
+    bridge.send = vi.fn((msg: BridgeOutMessage) => sent.push(msg));
+
+    bridge.setSubBlockSize(64);
+    bridge.setSubBlockSize(0);
+
+    expect(sent).toEqual([
+      { type: "setSubBlockSize", size: 64 },
+      { type: "setSubBlockSize", size: 0 },
+    ]);
+  });
+
   // ---------- multiple handlers ordering ------------------------------------
 
   it("should call handlers in registration order", () => {
@@ -204,6 +204,133 @@ describe("diffGraphs", () => {
     expect((disconnects[0] as any).to.nodeId).toBe("b");
   });
 
+  it("should pass connection gain through to connect ops", () => {
+    const next = buildSnapshot([
+      makeNode("a", "gain", { gain: 1 }),
+      makeNode("bus", "sum", {}, [
+        { fromNodeId: "a", fromOutlet: 0, toInlet: 0, gain: 0.5 },
+      ]),
+    ]);
+
+    const ops = diffGraphs(null, next);
+    const connect = ops.find((o) => o.op === "connect");
+    expect((connect as any).gain).toBe(0.5);
+  });
+
+  it("should re-send connect when only the connection gain changes", () => {
+    const prev = buildSnapshot([
+      makeNode("a", "gain", { gain: 1 }),
+      makeNode("bus", "sum", {}, [
+        { fromNodeId: "a", fromOutlet: 0, toInlet: 0, gain: 0.5 },
+      ]),
+    ]);
+    const next = buildSnapshot([
+      makeNode("a", "gain", { gain: 1 }),
+      makeNode("bus", "sum", {}, [
+        { fromNodeId: "a", fromOutlet: 0, toInlet: 0 },
+      ]),
+    ]);
+
+    const ops = diffGraphs(prev, next);
+    expect(ops).toEqual([
+      {
+        op: "connect",
+        from: { nodeId: "a", outlet: 0 },
+        to: { nodeId: "bus", inlet: 0 },
+        gain: 1,
+      },
+    ]);
+  });
+
+  it("should target the parameter in modulation connect ops", () => {
+    const next = buildSnapshot([
+      makeNode("lfo", "lfo", { rate: 1 }),
+      makeNode("f", "filter", { cutoff: 800 }, [
+        {
+          fromNodeId: "lfo",
+          fromOutlet: 0,
+          toInlet: 0,
+          toParam: "cutoff",
+          gain: 600,
+        },
+      ]),
+    ]);
+
+    const ops = diffGraphs(null, next);
+    const connect = ops.find((o) => o.op === "connect");
+    expect(connect).toEqual({
+      op: "connect",
+      from: { nodeId: "lfo", outlet: 0 },
+      to: { nodeId: "f", inlet: 0, param: "cutoff" },
+      gain: 600,
+    });
+  });
+
+  it("should keep audio and parameter connections from one source apart", () => {
+    const prev = buildSnapshot([
+      makeNode("lfo", "lfo", { rate: 1 }),
+      makeNode("g", "gain", { gain: 1 }, [
+        { fromNodeId: "lfo", fromOutlet: 0, toInlet: 0 },
+        { fromNodeId: "lfo", fromOutlet: 0, toInlet: 0, toParam: "gain" },
+      ]),
+    ]);
+    const next = buildSnapshot([
+      makeNode("lfo", "lfo", { rate: 1 }),
+      makeNode("g", "gain", { gain: 1 }, [
+        { fromNodeId: "lfo", fromOutlet: 0, toInlet: 0 },
+      ]),
+    ]);
+
+    const ops = diffGraphs(prev, next);
+    expect(ops).toEqual([
+      {
+        op: "disconnect",
+        from: { nodeId: "lfo", outlet: 0 },
+        to: { nodeId: "g", inlet: 0, param: "gain" },
+      },
+    ]);
+  });
+
+  it("should re-send connect when modulation depth or curve changes", () => {
+    const prev = buildSnapshot([
+      makeNode("lfo", "lfo", { rate: 1 }),
+      makeNode("f", "filter", { cutoff: 800 }, [
+        {
+          fromNodeId: "lfo",
+          fromOutlet: 0,
+          toInlet: 0,
+          toParam: "cutoff",
+          gain: 600,
+        },
+      ]),
+    ]);
+    const next = buildSnapshot([
+      makeNode("lfo", "lfo", { rate: 1 }),
+      makeNode("f", "filter", { cutoff: 800 }, [
+        {
+          fromNodeId: "lfo",
+          fromOutlet: 0,
+          toInlet: 0,
+          toParam: "cutoff",
+          gain: 600,
+          curve: "exponential",
+        },
+      ]),
+    ]);
+
+    const ops = diffGraphs(prev, next);
+    expect(ops).toEqual([
+      {
+        op: "connect",
+        from: { nodeId: "lfo", outlet: 0 },
+        to: { nodeId: "f", inlet: 0, param: "cutoff" },
+        gain: 600,
+        offset: 0,
+        curve: "exponential",
+      },
+    ]);
+  });
+
   // ---------- output node change -------------------------------------------
 
   it("should emit setOutput when output node changes", () => {
@@ -2,6 +2,7 @@ import type {
   BridgeOutMessage,
   BridgeInMessage,
   GraphOp,
+  ParameterBindingRange,
   ParameterConfig,
 } from "./types.js";
 
@@ -86,6 +87,15 @@ export class NativeBridge {
     this.send({ type: "graphOps", ops });
   }
 
+  /**
+   * Send the whole graph as the ops that build it from empty. The native
+   * side diffs it against its own graph, keeping nodes whose ID and type
+   * match along with their state.
+   */
+  sendGraph(ops: GraphOp[]): void {
+    this.send({ type: "setGraph", ops });
+  }
+
   sendParamUpdate(nodeId: string, paramName: string, value: number): void {
     this.send({ type: "paramUpdate", nodeId, paramName, value });
   }
@@ -102,6 +112,56 @@ export class NativeBridge {
     this.send({ type: "setParameterValue", id, value });
   }
 
+  bindParameter(
+    id: string,
+    nodeId: string,
+    paramName: string,
+    range?: ParameterBindingRange,
+  ): void {
+    this.send(
+      range
+        ? { type: "bindParameter", id, nodeId, paramName, range }
+        : { type: "bindParameter", id, nodeId, paramName },
+    );
+  }
+
+  unbindParameter(nodeId: string, paramName: string): void {
+    this.send({ type: "unbindParameter", nodeId, paramName });
+  }
+
+  /**
+   * Ask the native engine to keep `count` spare nodes of a type
+   * constructed and prepared, so adding one (a voice, a section toggled
+   * on) doesn't allocate. Removed nodes are recycled into the same pool.
+   */
+  prewarmNodes(nodeType: string, count: number): void {
+    this.send({ type: "prewarmNodes", nodeType, count });
+  }
+
+  /**
+   * Cap the memory the native engine reserves for node state. Past it,
+   * nodes still get their memory and the report shows the overrun.
+   * 0 lifts the cap.
+   */
+  setMemoryBudget(bytes: number): void {
+    this.send({ type: "setMemoryBudget", bytes });
+  }
+
+  /** Ask for a `memoryReport` message with every node's footprint. */
+  requestMemoryReport(): void {
+    this.send({ type: "getMemoryReport" });
+  }
+
+  /**
+   * Process the graph in sub-blocks of at most `size` samples, with
+   * parameter updates applied between them, whatever the host's buffer
+   * size. Capped at the host's prepared block size; 0 processes whole
+   * host blocks.
+   */
+  setSubBlockSize(size: number): void {
+    this.send({ type: "setSubBlockSize", size });
+  }
+
   // --- Internal --------------------------------------------------------------
 
   /** Dispatch an incoming message to all registered handlers. */
@@ -11,12 +11,13 @@ import {
   VirtualAudioGraph,
   type VirtualAudioGraphSnapshot,
 } from "./virtual-graph.js";
-import { diffGraphsFull } from "./graph-differ.js";
+import { diffGraphs, diffGraphsFull } from "./graph-differ.js";
 import { bridge, NativeBridge } from "./bridge.js";
 import { autoInstallDevBridge } from "./dev-bridge.js";
 import type {
   AudioNodeDescriptor,
   BridgeInMessage,
+  GraphCycle,
   GraphOp,
   MidiEvent,
   ParameterConfig,
@@ -101,11 +102,14 @@ export const MidiContext = createContext<MidiEvent[]>([]);
 export interface HostInfo {
   sampleRate: number;
   blockSize: number;
+  /** Feedback loops in the native graph (each adds one block of delay). */
+  graphCycles: GraphCycle[];
 }
 
 export const HostInfoContext = createContext<HostInfo>({
   sampleRate: 44100,
   blockSize: 512,
+  graphCycles: [],
 });
 
 // ---------------------------------------------------------------------------
@@ -140,6 +144,7 @@ export function PluginHost({ children }: PluginHostProps) {
   const [hostInfo, setHostInfo] = useState<HostInfo>({
     sampleRate: 44100,
     blockSize: 512,
+    graphCycles: [],
   });
 
   // Start a fresh graph collection for this render cycle. Doing this in render
@@ -160,6 +165,13 @@ export function PluginHost({ children }: PluginHostProps) {
           if (entry) entry.setValue(msg.value);
           break;
         }
+        case "parametersChanged": {
+          for (const [id, value] of Object.entries(msg.values)) {
+            const entry = paramRegistryRef.current.get(id);
+            if (entry) entry.setValue(value);
+          }
+          break;
+        }
         case "transport":
           setTransport({
             playing: msg.playing,
@@ -178,6 +190,15 @@ export function PluginHost({ children }: PluginHostProps) {
         case "blockSize":
           setHostInfo((prev) => ({ ...prev, blockSize: msg.value }));
           break;
+        case "graphCycles":
+          setHostInfo((prev) => ({ ...prev, graphCycles: msg.cycles }));
+          break;
+        case "graphRestored": {
+          // The native graph no longer matches what we last sent
+          const current = prevSnapshotRef.current;
+          if (current) bridge.sendGraph(diffGraphs(null, current));
+          break;
+        }
         case "requestState": {
           // Native side requesting plugin state for save
           const state: Record<string, number> = {};
@@ -263,6 +284,17 @@ export function PluginHost({ children }: PluginHostProps) {
     }
 
     const nextSnapshot = graphRef.current.snapshot();
+
+    // First sync after a (re)mount or reload: the native graph may already
+    // exist (restored from the session, or from before a hot reload), so
+    // send the whole graph and let the native side keep what matches.
+    if (prevSnapshotRef.current === null) {
+      bridge.sendGraph(diffGraphs(null, nextSnapshot));
+      prevSnapshotRef.current = nextSnapshot;
+      graphRef.current.clear();
+      return;
+    }
+
     const { ops, paramOnly } = diffGraphsFull(
       prevSnapshotRef.current,
       nextSnapshot,
@@ -74,13 +74,17 @@ class DevAudioEngine {
           break;
         }
         case "connect": {
+          // Parameter modulation isn't previewed
+          if (op.to.param !== undefined) break;
           const toNode = this.nodes.get(op.to.nodeId);
-          if (toNode) {
+          // A repeated connect only changes the gain, which the preview ignores
+          if (toNode && !toNode.inputs.includes(op.from.nodeId)) {
             toNode.inputs.push(op.from.nodeId);
           }
           break;
         }
         case "disconnect": {
+          if (op.to.param !== undefined) break;
           const toNode = this.nodes.get(op.to.nodeId);
           if (toNode) {
             toNode.inputs = toNode.inputs.filter((id) => id !== op.from.nodeId);
@@ -95,6 +99,13 @@ class DevAudioEngine {
     }
   }
 
+  setGraph(ops: GraphOp[]): void {
+    // The preview keeps no node state worth diffing for
+    this.nodes.clear();
+    this.outputNodeId = "";
+    this.applyOps(ops);
+  }
+
   setParam(nodeId: string, param: string, value: number): void {
     const node = this.nodes.get(nodeId);
     if (node) {
@@ -202,6 +213,9 @@ function handleDevMessage(msg: BridgeOutMessage): void {
     case "graphOps":
       devEngine?.applyOps(msg.ops);
       break;
+    case "setGraph":
+      devEngine?.setGraph(msg.ops);
+      break;
     case "paramUpdate":
       devEngine?.setParam(msg.nodeId, msg.paramName, msg.value);
       break;
@@ -211,6 +225,29 @@ function handleDevMessage(msg: BridgeOutMessage): void {
     case "setParameterValue":
       // In dev mode, parameters are managed in-memory only
       break;
+    case "bindParameter":
+    case "unbindParameter":
+      // No host automation in dev mode; bound params follow re-renders
+      break;
+    case "prewarmNodes":
+      // Web Audio nodes are cheap to create; nothing to pool
+      break;
+    case "setMemoryBudget":
+      // Web Audio manages its own memory
+      break;
+    case "setSubBlockSize":
+      // Web Audio always renders in 128-sample quanta
+      break;
+    case "getMemoryReport":
+      dispatchToJS?.({
+        type: "memoryReport",
+        total: 0,
+        reserved: 0,
+        budget: 0,
+        overBudget: 0,
+        nodes: {},
+      });
+      break;
     case "getState":
       dispatchToJS?.({ type: "requestState" });
       break;
@@ -1,4 +1,4 @@
-import type { GraphOp } from "./types.js";
+import type { ConnectionDescriptor, GraphOp } from "./types.js";
 import type { VirtualAudioGraphSnapshot } from "./virtual-graph.js";
 
 /**
@@ -43,11 +43,7 @@ export function diffGraphsFull(
     if (!nextNodes.has(id)) {
       // Disconnect inputs before removing
       for (const conn of node.inputs) {
-        ops.push({
-          op: "disconnect",
-          from: { nodeId: conn.fromNodeId, outlet: conn.fromOutlet },
-          to: { nodeId: id, inlet: conn.toInlet },
-        });
+        ops.push(disconnectOp(id, conn));
       }
       ops.push({ op: "removeNode", nodeId: id });
       topologyChanged = true;
@@ -64,11 +60,7 @@ export function diffGraphsFull(
         params: node.params,
       });
       for (const conn of node.inputs) {
-        ops.push({
-          op: "connect",
-          from: { nodeId: conn.fromNodeId, outlet: conn.fromOutlet },
-          to: { nodeId: id, inlet: conn.toInlet },
-        });
+        ops.push(connectOp(id, conn));
       }
       topologyChanged = true;
     }
@@ -85,18 +77,28 @@ export function diffGraphsFull(
     }
 
     // 3b. Connection changes
-    const prevConns = connectionSet(id, prevNode.inputs);
-    const nextConns = connectionSet(id, nextNode.inputs);
+    const prevConns = connectionMap(id, prevNode.inputs);
+    const nextConns = connectionMap(id, nextNode.inputs);
 
-    // New connections
+    // New connections, and existing ones whose gain (or modulation
+    // shaping) changed
     for (const conn of nextNode.inputs) {
-      const key = connectionKey(id, conn);
-      if (!prevConns.has(key)) {
-        ops.push({
-          op: "connect",
-          from: { nodeId: conn.fromNodeId, outlet: conn.fromOutlet },
-          to: { nodeId: id, inlet: conn.toInlet },
-        });
+      const prevConn = prevConns.get(connectionKey(id, conn));
+      if (!prevConn) {
+        ops.push(connectOp(id, conn));
+        topologyChanged = true;
+      } else if (
+        (prevConn.gain ?? 1) !== (conn.gain ?? 1) ||
+        (prevConn.offset ?? 0) !== (conn.offset ?? 0) ||
+        (prevConn.curve ?? "linear") !== (conn.curve ?? "linear")
+      ) {
+        const op = connectOp(id, conn);
+        op.gain = conn.gain ?? 1;
+        if (conn.toParam !== undefined) {
+          op.offset = conn.offset ?? 0;
+          op.curve = conn.curve ?? "linear";
+        }
+        ops.push(op);
         topologyChanged = true;
       }
     }
@@ -104,11 +106,7 @@ export function diffGraphsFull(
     for (const conn of prevNode.inputs) {
       const key = connectionKey(id, conn);
       if (!nextConns.has(key)) {
-        ops.push({
-          op: "disconnect",
-          from: { nodeId: conn.fromNodeId, outlet: conn.fromOutlet },
-          to: { nodeId: id, inlet: conn.toInlet },
-        });
+        ops.push(disconnectOp(id, conn));
         topologyChanged = true;
       }
     }
@@ -129,16 +127,59 @@ export function diffGraphsFull(
 
 function connectionKey(
   toNodeId: string,
-  conn: { fromNodeId: string; fromOutlet: number; toInlet: number },
+  conn: {
+    fromNodeId: string;
+    fromOutlet: number;
+    toInlet: number;
+    toParam?: string;
+  },
 ): string {
-  return `${conn.fromNodeId}:${conn.fromOutlet}->${toNodeId}:${conn.toInlet}`;
+  const target =
+    conn.toParam !== undefined ? `.${conn.toParam}` : `:${conn.toInlet}`;
+  return `${conn.fromNodeId}:${conn.fromOutlet}->${toNodeId}${target}`;
+}
+
+function connectionMap(
+  toNodeId: string,
+  inputs: ConnectionDescriptor[],
+): Map<string, ConnectionDescriptor> {
+  return new Map(inputs.map((c) => [connectionKey(toNodeId, c), c]));
+}
+
+type ConnectOp = Extract<GraphOp, { op: "connect" }>;
+type DisconnectOp = Extract<GraphOp, { op: "disconnect" }>;
+
+function connectionTarget(
+  toNodeId: string,
+  conn: ConnectionDescriptor,
+): ConnectOp["to"] {
+  return conn.toParam !== undefined
+    ? { nodeId: toNodeId, inlet: conn.toInlet, param: conn.toParam }
+    : { nodeId: toNodeId, inlet: conn.toInlet };
+}
+
+function connectOp(toNodeId: string, conn: ConnectionDescriptor): ConnectOp {
+  const op: ConnectOp = {
+    op: "connect",
+    from: { nodeId: conn.fromNodeId, outlet: conn.fromOutlet },
+    to: connectionTarget(toNodeId, conn),
+  };
+  if (conn.gain !== undefined && conn.gain !== 1) op.gain = conn.gain;
+  if (conn.offset !== undefined && conn.offset !== 0) op.offset = conn.offset;
+  if (conn.curve !== undefined && conn.curve !== "linear")
+    op.curve = conn.curve;
+  return op;
 }
 
-function connectionSet(
+function disconnectOp(
   toNodeId: string,
-  inputs: { fromNodeId: string; fromOutlet: number; toInlet: number }[],
-): Set<string> {
-  return new Set(inputs.map((c) => connectionKey(toNodeId, c)));
+  conn: ConnectionDescriptor,
+): DisconnectOp {
+  return {
+    op: "disconnect",
+    from: { nodeId: conn.fromNodeId, outlet: conn.fromOutlet },
+    to: connectionTarget(toNodeId, conn),
+  };
 }
 
 function shallowEqual(
@@ -3,10 +3,14 @@ export type {
   Signal,
   AudioNodeDescriptor,
   ConnectionDescriptor,
+  ModulationCurve,
   GraphOp,
   BridgeOutMessage,
   BridgeInMessage,
+  GraphCycle,
+  MemoryReport,
   ParameterConfig,
+  ParameterBindingRange,
   MidiEvent,
   PluginConfig,
 } from "./types.js";
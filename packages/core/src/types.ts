@@ -32,8 +32,31 @@ export interface ConnectionDescriptor {
   fromNodeId: string;
   fromOutlet: number;
   toInlet: number;
+  /**
+   * Scale applied to this connection. Several connections into the same
+   * inlet are summed natively (a summing junction). Default 1. For a
+   * parameter connection this is the modulation depth.
+   */
+  gain?: number;
+  /**
+   * Set to connect into a parameter of the node instead of an inlet
+   * (`toInlet` is then ignored). The first channel of the source,
+   * shaped by `curve`, times `gain`, plus `offset` is added to the
+   * parameter's value sample by sample.
+   */
+  toParam?: string;
+  /** Parameter connections: added after scaling. Default 0. */
+  offset?: number;
+  /** Parameter connections: shaping applied to the source. Default "linear". */
+  curve?: ModulationCurve;
 }
 
+/**
+ * Shaping for a parameter connection: `exponential` is x·|x|,
+ * `logarithmic` is sign(x)·√|x|.
+ */
+export type ModulationCurve = "linear" | "exponential" | "logarithmic";
+
 // ---------------------------------------------------------------------------
 // Graph operations — the "DOM operations" of our reconciler
 // ---------------------------------------------------------------------------
@@ -54,12 +77,20 @@ export type GraphOp =
   | {
       op: "connect";
       from: { nodeId: string; outlet: number };
-      to: { nodeId: string; inlet: number };
+      /** `param` targets a parameter instead of the inlet. */
+      to: { nodeId: string; inlet: number; param?: string };
+      /**
+       * Connection gain (modulation depth for a parameter). Re-sending a
+       * connect with a new gain, offset or curve updates it.
+       */
+      gain?: number;
+      offset?: number;
+      curve?: ModulationCurve;
     }
   | {
       op: "disconnect";
       from: { nodeId: string; outlet: number };
-      to: { nodeId: string; inlet: number };
+      to: { nodeId: string; inlet: number; param?: string };
     }
   | { op: "setOutput"; nodeId: string };
 
@@ -70,16 +101,35 @@ export type GraphOp =
 /** JS → Native */
 export type BridgeOutMessage =
   | { type: "graphOps"; ops: GraphOp[] }
+  /** The whole graph, as addNode/connect/setOutput ops building it from empty */
+  | { type: "setGraph"; ops: GraphOp[] }
   | { type: "paramUpdate"; nodeId: string; paramName: string; value: number }
   | { type: "registerParameter"; id: string; config: ParameterConfig }
   | { type: "unregisterParameter"; id: string }
   | { type: "setParameterValue"; id: string; value: number }
+  | {
+      type: "bindParameter";
+      id: string;
+      nodeId: string;
+      paramName: string;
+      range?: ParameterBindingRange;
+    }
+  | { type: "unbindParameter"; nodeId: string; paramName: string }
+  /** Keep `count` prepared spare nodes of a type for instant adds */
+  | { type: "prewarmNodes"; nodeType: string; count: number }
+  /** Cap, in bytes, on the memory reserved for node state; 0 for none */
+  | { type: "setMemoryBudget"; bytes: number }
+  | { type: "getMemoryReport" }
+  /** Process host blocks in pieces of at most `size` samples; 0 for whole blocks */
+  | { type: "setSubBlockSize"; size: number }
   | { type: "getState" }
   | { type: "setState"; state: string };
 
 /** Native → JS */
 export type BridgeInMessage =
   | { type: "parameterChanged"; id: string; value: number }
+  /** Host changes since the last UI frame, latest value per parameter */
+  | { type: "parametersChanged"; values: Record<string, number> }
   | { type: "meterData"; nodeId: string; rms: number[]; peak: number[] }
   | { type: "spectrumData"; nodeId: string; magnitudes: number[] }
   | {
@@ -94,7 +144,39 @@ export type BridgeInMessage =
   | { type: "requestState" }
   | { type: "restoreState"; state: string }
   | { type: "sampleRate"; value: number }
-  | { type: "blockSize"; value: number };
+  | { type: "blockSize"; value: number }
+  | { type: "graphCycles"; cycles: GraphCycle[] }
+  | ({ type: "memoryReport" } & MemoryReport)
+  /** The native graph was rebuilt from saved state; resend the whole graph */
+  | { type: "graphRestored" };
+
+/**
+ * A feedback loop in the native graph. The native side breaks each loop
+ * by running the listed connections with a one-block delay.
+ */
+export interface GraphCycle {
+  nodeIds: string[];
+  feedback: {
+    from: { nodeId: string; outlet: number };
+    to: { nodeId: string; inlet: number; param?: string };
+  }[];
+}
+
+/**
+ * What the native graph's nodes hold for their DSP state (delay lines,
+ * reverb pre-delays), in bytes. `total` also counts spare and
+ * just-removed nodes, which aren't listed.
+ */
+export interface MemoryReport {
+  total: number;
+  /** Reserved from the system, including room not yet handed out */
+  reserved: number;
+  /** 0 when there is no budget */
+  budget: number;
+  /** Allocated past the budget */
+  overBudget: number;
+  nodes: Record<string, { type: string; bytes: number }>;
+}
 
 // ---------------------------------------------------------------------------
 // Parameter types
@@ -110,6 +192,16 @@ export interface ParameterConfig {
   steps?: number;
 }
 
+/**
+ * Maps a bound host parameter onto a node parameter. The parameter's
+ * normalised position is spread over [min, max] along `curve`.
+ */
+export interface ParameterBindingRange {
+  min: number;
+  max: number;
+  curve?: "linear" | "logarithmic" | "exponential";
+}
+
 // ---------------------------------------------------------------------------
 // MIDI
 // ---------------------------------------------------------------------------
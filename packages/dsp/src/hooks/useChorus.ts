@@ -1,11 +1,20 @@
 import type { Signal } from "@react-audio-unit/core";
-import { useDelay } from "./useDelay.js";
-import { useMix } from "./useMix.js";
+import { useAudioNode } from "../useAudioNode.js";
+import {
+  PARAM_DELAY_TIME,
+  PARAM_LFO_DEPTH,
+  PARAM_LFO_RATE,
+  PARAM_VOICES,
+  PARAM_SPREAD,
+  PARAM_FEEDBACK,
+  PARAM_MIX,
+  PARAM_BYPASS,
+} from "../param-keys.js";
 
 export interface ChorusParams {
   /** LFO rate in Hz. Default 1.5. */
   rate?: number;
-  /** Modulation depth in ms. Default 5. */
+  /** Modulation depth in ms (peak to peak). Default 5. */
   depth?: number;
   /** Base delay time in ms. Default 15. */
   delayMs?: number;
@@ -13,21 +22,17 @@ export interface ChorusParams {
   mix?: number;
   /** Number of voices (1–4). Default 2. */
   voices?: number;
+  /** Stereo LFO phase offset (0 = mono sweep, 1 = 90°). Default 0.5. */
+  spread?: number;
   bypass?: boolean;
 }
 
 /**
- * useChorus — chorus effect, composable from delay + LFO modulation.
+ * useChorus — chorus effect on a single native modulated delay node.
  *
- * Creates multiple delayed copies of the input with slightly
- * different delay times, producing a thickening/doubling effect.
- * The native delay node handles the modulation internally when
- * its time parameter is varied per-sample by the LFO.
- *
- * For simplicity, this hook creates multiple delay nodes with
- * slightly offset delay times to simulate chorus. The LFO
- * modulation would ideally be sample-accurate on the C++ side;
- * here we use static offsets that still produce a chorus-like effect.
+ * Each voice is a tap into one shared delay line, swept by its own LFO
+ * around the base delay time, producing a thickening/doubling effect.
+ * Voices are spread evenly in LFO phase.
  */
 export function useChorus(input: Signal, params: ChorusParams = {}): Signal {
   const {
@@ -36,34 +41,22 @@ export function useChorus(input: Signal, params: ChorusParams = {}): Signal {
     delayMs = 15,
     mix = 0.5,
     voices = 2,
+    spread = 0.5,
     bypass = false,
   } = params;
 
-  // Create offset delays for each voice
-  // Voice 1: slightly shorter, Voice 2: slightly longer, etc.
-  const voiceCount = Math.max(1, Math.min(4, Math.round(voices)));
-
-  // First voice
-  const voice1 = useDelay(input, {
-    time: delayMs - depth * 0.5,
-    feedback: 0,
-    mix: 1,
-    bypass,
-  });
-
-  if (voiceCount === 1) {
-    return useMix(input, voice1, mix);
-  }
-
-  // Second voice with different offset
-  const voice2 = useDelay(input, {
-    time: delayMs + depth * 0.5,
-    feedback: 0,
-    mix: 1,
-    bypass,
-  });
-
-  // Mix voices together, then mix with dry signal
-  const wet = useMix(voice1, voice2, 0.5);
-  return useMix(input, wet, mix);
+  return useAudioNode(
+    "modDelay",
+    {
+      [PARAM_DELAY_TIME]: delayMs,
+      [PARAM_LFO_DEPTH]: depth,
+      [PARAM_LFO_RATE]: rate,
+      [PARAM_VOICES]: Math.max(1, Math.min(4, Math.round(voices))),
+      [PARAM_SPREAD]: spread,
+      [PARAM_FEEDBACK]: 0,
+      [PARAM_MIX]: mix,
+      [PARAM_BYPASS]: bypass,
+    },
+    [input],
+  );
 }
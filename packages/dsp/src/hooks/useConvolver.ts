@@ -1,20 +1,33 @@
 import type { Signal } from "@react-audio-unit/core";
 import { useAudioNode } from "../useAudioNode.js";
-import { PARAM_MIX, PARAM_GAIN, PARAM_BYPASS } from "../param-keys.js";
+import {
+  PARAM_MIX,
+  PARAM_GAIN,
+  PARAM_BYPASS,
+  PARAM_STORAGE,
+} from "../param-keys.js";
+import type { SampleStorage } from "./useDelay.js";
 
 export interface ConvolverParams {
   /** Dry/wet mix (0 = fully dry, 1 = fully wet). Default 0.5. */
   mix?: number;
   /** Output gain (linear). Default 1. */
   gain?: number;
+  /**
+   * IR partition storage. Default "float32". The 16-bit formats halve the
+   * IR's memory and bandwidth. Applied when the node is created.
+   */
+  storage?: SampleStorage;
   bypass?: boolean;
 }
 
 /**
  * useConvolver — convolution reverb using an impulse response.
  *
- * The native ConvolverNode uses JUCE's uniformly-partitioned
- * convolution engine for efficient frequency-domain processing.
+ * The native ConvolverNode uses a zero-latency, non-uniformly
+ * partitioned FFT engine. IRs are shared between instances through a
+ * process-wide cache and prepared on a background thread, so the node
+ * passes the dry signal through until its IR is ready.
  *
  * Note: The IR must be loaded on the C++ side via loadIR() or
  * loadIRFromFile(). This hook sets up the convolution node in
@@ -29,6 +42,7 @@ export function useConvolver(
     {
       [PARAM_MIX]: params.mix ?? 0.5,
       [PARAM_GAIN]: params.gain ?? 1,
+      [PARAM_STORAGE]: params.storage ?? "float32",
       [PARAM_BYPASS]: params.bypass ?? false,
     },
     [input],
@@ -0,0 +1,63 @@
+import { useMemo } from "react";
+import type { Signal } from "@react-audio-unit/core";
+import { createSignal } from "@react-audio-unit/core";
+import { useAudioNode } from "../useAudioNode.js";
+import {
+  PARAM_LOW_CROSSOVER,
+  PARAM_MID_CROSSOVER,
+  PARAM_HIGH_CROSSOVER,
+  PARAM_BYPASS,
+} from "../param-keys.js";
+
+export interface CrossoverParams {
+  /** Frequency between the low and low-mid bands in Hz. Default 200. */
+  lowFrequency?: number;
+  /** Frequency between the low-mid and high-mid bands in Hz. Default 1000. */
+  midFrequency?: number;
+  /** Frequency between the high-mid and high bands in Hz. Default 5000. */
+  highFrequency?: number;
+  bypass?: boolean;
+}
+
+/**
+ * useCrossover — 4-band Linkwitz-Riley crossover.
+ *
+ * A single native node produces all four bands, so the shared filter
+ * stages run once. The bands sum back to the (allpassed) input:
+ *   - `low`     (outlet 0)
+ *   - `lowMid`  (outlet 1)
+ *   - `highMid` (outlet 2)
+ *   - `high`    (outlet 3)
+ *
+ * When bypassed, `low` carries the input and the other bands are silent.
+ */
+export function useCrossover(
+  input: Signal,
+  params: CrossoverParams = {},
+): {
+  low: Signal;
+  lowMid: Signal;
+  highMid: Signal;
+  high: Signal;
+} {
+  const signal = useAudioNode(
+    "crossover",
+    {
+      [PARAM_LOW_CROSSOVER]: params.lowFrequency ?? 200,
+      [PARAM_MID_CROSSOVER]: params.midFrequency ?? 1000,
+      [PARAM_HIGH_CROSSOVER]: params.highFrequency ?? 5000,
+      [PARAM_BYPASS]: params.bypass ?? false,
+    },
+    [input],
+  );
+
+  return useMemo(
+    () => ({
+      low: signal, // outlet 0 (default)
+      lowMid: createSignal(signal.nodeId, 1),
+      highMid: createSignal(signal.nodeId, 2),
+      high: createSignal(signal.nodeId, 3),
+    }),
+    [signal],
+  );
+}
@@ -2,14 +2,31 @@ import type { Signal } from "@react-audio-unit/core";
 import { useAudioNode } from "../useAudioNode.js";
 import {
   PARAM_DELAY_TIME,
+  PARAM_MAX_DELAY_TIME,
   PARAM_FEEDBACK,
   PARAM_MIX,
   PARAM_BYPASS,
+  PARAM_STORAGE,
 } from "../param-keys.js";
 
+/**
+ * How a node stores its long buffers. The 16-bit formats halve their
+ * memory: "float16" keeps about 66 dB of signal-to-noise, "bfloat16"
+ * about 48 dB.
+ */
+export type SampleStorage = "float32" | "float16" | "bfloat16";
+
 export interface DelayParams {
   /** Delay time in milliseconds. */
   time: number;
+  /**
+   * Longest delay time in milliseconds, 1–5000 (default 5000). The
+   * native delay line is sized for it, so a short delay can save memory.
+   * Applied when the node is created.
+   */
+  maxTime?: number;
+  /** Delay line storage. Default "float32". Applied when the node is created. */
+  storage?: SampleStorage;
   /** Feedback amount (0–1). 0 = no feedback, approaching 1 = infinite. */
   feedback?: number;
   /** Dry/wet mix (0 = fully dry, 1 = fully wet). */
@@ -28,6 +45,8 @@ export function useDelay(input: Signal, params: DelayParams): Signal {
     "delay",
     {
       [PARAM_DELAY_TIME]: params.time,
+      [PARAM_MAX_DELAY_TIME]: params.maxTime ?? 5000,
+      [PARAM_STORAGE]: params.storage ?? "float32",
       [PARAM_FEEDBACK]: params.feedback ?? 0,
       [PARAM_MIX]: params.mix ?? 1,
       [PARAM_BYPASS]: params.bypass ?? false,
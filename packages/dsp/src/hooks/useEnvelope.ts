@@ -5,6 +5,7 @@ import {
   PARAM_DECAY,
   PARAM_SUSTAIN,
   PARAM_RELEASE,
+  PARAM_CONTROL_INTERVAL,
 } from "../param-keys.js";
 
 export interface EnvelopeParams {
@@ -16,6 +17,11 @@ export interface EnvelopeParams {
   sustain: number;
   /** Release time in ms. */
   release: number;
+  /**
+   * Samples between computed values; the rest are interpolated. Default
+   * 16. Use 1 for attacks of a few samples.
+   */
+  controlInterval?: number;
 }
 
 /**
@@ -51,6 +57,7 @@ export function useEnvelope(
       [PARAM_DECAY]: params.decay,
       [PARAM_SUSTAIN]: params.sustain,
       [PARAM_RELEASE]: params.release,
+      [PARAM_CONTROL_INTERVAL]: params.controlInterval ?? 16,
     },
     inputs,
   );
@@ -1,11 +1,20 @@
 import type { Signal } from "@react-audio-unit/core";
-import { useDelay } from "./useDelay.js";
-import { useMix } from "./useMix.js";
+import { useAudioNode } from "../useAudioNode.js";
+import {
+  PARAM_DELAY_TIME,
+  PARAM_LFO_DEPTH,
+  PARAM_LFO_RATE,
+  PARAM_VOICES,
+  PARAM_SPREAD,
+  PARAM_FEEDBACK,
+  PARAM_MIX,
+  PARAM_BYPASS,
+} from "../param-keys.js";
 
 export interface FlangerParams {
   /** LFO rate in Hz. Default 0.5. */
   rate?: number;
-  /** Modulation depth in ms. Default 2. */
+  /** Modulation depth in ms (peak to peak). Default 2. */
   depth?: number;
   /** Base delay time in ms (very short for flanging). Default 3. */
   delayMs?: number;
@@ -13,31 +22,41 @@ export interface FlangerParams {
   feedback?: number;
   /** Dry/wet mix (0–1). Default 0.5. */
   mix?: number;
+  /** Stereo LFO phase offset (0 = mono sweep, 1 = 90°). Default 0. */
+  spread?: number;
   bypass?: boolean;
 }
 
 /**
  * useFlanger — flanger effect from a short modulated delay with feedback.
  *
- * A flanger is essentially a very short delay (1–10ms) with feedback
- * and time modulation, creating a comb-filter sweep effect.
+ * A flanger is a very short delay (1–10ms) with feedback whose time is
+ * swept by an LFO, creating a moving comb-filter effect. Runs on the
+ * same native modulated delay node as useChorus, with a single voice.
  */
 export function useFlanger(input: Signal, params: FlangerParams = {}): Signal {
   const {
+    rate = 0.5,
     depth = 2,
     delayMs = 3,
     feedback = 0.5,
     mix = 0.5,
+    spread = 0,
     bypass = false,
   } = params;
 
-  // Short delay with feedback creates the comb-filter effect
-  const delayed = useDelay(input, {
-    time: delayMs + depth * 0.5, // Offset simulates LFO center position
-    feedback: Math.max(-0.95, Math.min(0.95, feedback)),
-    mix: 1,
-    bypass,
-  });
-
-  return useMix(input, delayed, mix);
+  return useAudioNode(
+    "modDelay",
+    {
+      [PARAM_DELAY_TIME]: delayMs,
+      [PARAM_LFO_DEPTH]: depth,
+      [PARAM_LFO_RATE]: rate,
+      [PARAM_VOICES]: 1,
+      [PARAM_SPREAD]: spread,
+      [PARAM_FEEDBACK]: Math.max(-0.95, Math.min(0.95, feedback)),
+      [PARAM_MIX]: mix,
+      [PARAM_BYPASS]: bypass,
+    },
+    [input],
+  );
 }
@@ -4,7 +4,8 @@ import { HostInfoContext, type HostInfo } from "@react-audio-unit/core";
 /**
  * useHostInfo — access host audio configuration.
  *
- * Returns the current sample rate and block size.
+ * Returns the current sample rate and block size, plus any feedback
+ * loops the native graph is running with a one-block delay.
  */
 export function useHostInfo(): HostInfo {
   return useContext(HostInfoContext);
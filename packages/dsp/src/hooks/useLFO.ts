@@ -5,6 +5,7 @@ import {
   PARAM_LFO_SHAPE,
   PARAM_LFO_DEPTH,
   PARAM_LFO_PHASE,
+  PARAM_CONTROL_INTERVAL,
 } from "../param-keys.js";
 
 export type LFOShape = "sine" | "triangle" | "saw" | "square" | "random";
@@ -18,6 +19,11 @@ export interface LFOParams {
   depth?: number;
   /** Phase offset in degrees (0–360). */
   phase?: number;
+  /**
+   * Samples between computed values; the rest are interpolated. Default
+   * 16. Use 1 for sharp square/random edges.
+   */
+  controlInterval?: number;
 }
 
 /**
@@ -32,5 +38,6 @@ export function useLFO(params: LFOParams): Signal {
     [PARAM_LFO_SHAPE]: params.shape,
     [PARAM_LFO_DEPTH]: params.depth ?? 1,
     [PARAM_LFO_PHASE]: params.phase ?? 0,
+    [PARAM_CONTROL_INTERVAL]: params.controlInterval ?? 16,
   });
 }
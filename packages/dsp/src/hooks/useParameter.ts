@@ -41,13 +41,16 @@ export function useParameter(
   // safety net that ensures the local React state is always up-to-date.
   useEffect(() => {
     return bridge.onMessage((msg) => {
-      if (msg.type === "parameterChanged" && msg.id === id) {
-        setValueInternal(msg.value);
-        // Keep registry in sync (may be redundant if PluginHost already
-        // dispatched through entry.setValue, but harmless to double-set).
-        const entry = registry?.getAll().get(id);
-        if (entry) entry.value = msg.value;
-      }
+      let value: number | undefined;
+      if (msg.type === "parameterChanged" && msg.id === id) value = msg.value;
+      else if (msg.type === "parametersChanged") value = msg.values[id];
+      if (value === undefined) return;
+
+      setValueInternal(value);
+      // Keep registry in sync (may be redundant if PluginHost already
+      // dispatched through entry.setValue, but harmless to double-set).
+      const entry = registry?.getAll().get(id);
+      if (entry) entry.value = value;
     });
   }, [id, registry]);
 
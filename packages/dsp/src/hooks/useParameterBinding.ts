@@ -0,0 +1,43 @@
+import { useEffect } from "react";
+import {
+  type ParameterBindingRange,
+  type Signal,
+  bridge,
+} from "@react-audio-unit/core";
+
+/**
+ * useParameterBinding — lets a host parameter drive a node parameter
+ * natively.
+ *
+ * DAW automation on the parameter is applied to the node in the same
+ * audio block, without waiting for a React render, and keeps working
+ * while the editor is closed. The value returned by useParameter still
+ * follows the host, so the UI updates as before.
+ *
+ * @param id        - Parameter id passed to useParameter
+ * @param node      - Signal of the node to drive
+ * @param paramName - Parameter name on that node
+ * @param range     - Maps the parameter's position onto the node
+ *                    parameter. Defaults to the parameter's own range.
+ */
+export function useParameterBinding(
+  id: string,
+  node: Signal,
+  paramName: string,
+  range?: ParameterBindingRange,
+): void {
+  const { nodeId } = node;
+  const min = range?.min;
+  const max = range?.max;
+  const curve = range?.curve;
+
+  useEffect(() => {
+    bridge.bindParameter(
+      id,
+      nodeId,
+      paramName,
+      min !== undefined && max !== undefined ? { min, max, curve } : undefined,
+    );
+    return () => bridge.unbindParameter(nodeId, paramName);
+  }, [id, nodeId, paramName, min, max, curve]);
+}
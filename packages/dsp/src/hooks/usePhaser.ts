@@ -1,6 +1,15 @@
 import type { Signal } from "@react-audio-unit/core";
-import { useFilter } from "./useFilter.js";
-import { useMix } from "./useMix.js";
+import { useAudioNode } from "../useAudioNode.js";
+import {
+  PARAM_FREQUENCY,
+  PARAM_LFO_DEPTH,
+  PARAM_LFO_RATE,
+  PARAM_STAGES,
+  PARAM_FEEDBACK,
+  PARAM_SPREAD,
+  PARAM_MIX,
+  PARAM_BYPASS,
+} from "../param-keys.js";
 
 export interface PhaserParams {
   /** LFO rate in Hz. Default 0.5. */
@@ -9,53 +18,51 @@ export interface PhaserParams {
   depth?: number;
   /** Center frequency in Hz. Default 1000. */
   centerFreq?: number;
-  /** Feedback amount (0–0.95). Default 0.5. */
+  /** Feedback amount (-0.95–0.95). Default 0.5. */
   feedback?: number;
-  /** Number of allpass stages (2, 4, 6, 8). Default 4. */
+  /** Number of allpass stages (2–12, even). Default 4. */
   stages?: number;
+  /** Stereo LFO phase offset (0 = mono sweep, 1 = 90°). Default 0. */
+  spread?: number;
   /** Dry/wet mix (0–1). Default 0.5. */
   mix?: number;
   bypass?: boolean;
 }
 
 /**
- * usePhaser — phaser effect from cascaded allpass filters.
+ * usePhaser — phaser effect on a single native swept allpass node.
  *
- * A phaser works by running the signal through a chain of allpass
- * filters with swept center frequencies, then mixing the result
- * with the dry signal. The phase cancellation creates the
- * characteristic swooshing sound.
+ * The signal runs through a cascade of first-order allpass stages whose
+ * shared corner frequency is swept by an LFO, with the cascade output fed
+ * back to its input. Mixing the result with the dry signal produces
+ * moving notches — the characteristic swooshing sound.
  */
 export function usePhaser(input: Signal, params: PhaserParams = {}): Signal {
   const {
+    rate = 0.5,
     depth = 0.7,
     centerFreq = 1000,
     feedback = 0.5,
     stages = 4,
+    spread = 0,
     mix = 0.5,
     bypass = false,
   } = params;
 
-  const stageCount = Math.max(2, Math.min(8, Math.round(stages / 2) * 2)); // must be even
+  const stageCount = Math.max(2, Math.min(12, Math.round(stages / 2) * 2)); // must be even
 
-  // Create a chain of allpass filters at logarithmically spaced frequencies
-  // This simulates the swept allpass filter bank of a classic phaser
-  const minFreq = centerFreq * (1 - depth * 0.9);
-  const maxFreq = centerFreq * (1 + depth * 0.9);
-
-  let signal = input;
-  for (let i = 0; i < stageCount; i++) {
-    // Logarithmically space the allpass frequencies
-    const t = stageCount > 1 ? i / (stageCount - 1) : 0.5;
-    const freq = minFreq * Math.pow(maxFreq / minFreq, t);
-
-    signal = useFilter(signal, {
-      type: "allpass",
-      cutoff: freq,
-      resonance: 0.707 + feedback * 0.3,
-      bypass,
-    });
-  }
-
-  return useMix(input, signal, mix);
+  return useAudioNode(
+    "phaser",
+    {
+      [PARAM_FREQUENCY]: centerFreq,
+      [PARAM_LFO_DEPTH]: depth,
+      [PARAM_LFO_RATE]: rate,
+      [PARAM_STAGES]: stageCount,
+      [PARAM_FEEDBACK]: feedback,
+      [PARAM_SPREAD]: spread,
+      [PARAM_MIX]: mix,
+      [PARAM_BYPASS]: bypass,
+    },
+    [input],
+  );
 }
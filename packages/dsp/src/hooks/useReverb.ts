@@ -5,9 +5,17 @@ import {
   PARAM_DAMPING,
   PARAM_MIX,
   PARAM_PRE_DELAY,
+  PARAM_REVERB_ENGINE,
   PARAM_BYPASS,
 } from "../param-keys.js";
 
+/**
+ * Reverb algorithm. `"freeverb"` is the classic comb/allpass design;
+ * `"fdn"` is an 8-line feedback delay network with a denser, smoother
+ * tail at lower CPU cost.
+ */
+export type ReverbEngine = "freeverb" | "fdn";
+
 export interface ReverbParams {
   /** Room size (0–1). */
   roomSize: number;
@@ -17,11 +25,13 @@ export interface ReverbParams {
   mix: number;
   /** Pre-delay in ms. */
   preDelay?: number;
+  /** Reverb algorithm. Default "freeverb". */
+  engine?: ReverbEngine;
   bypass?: boolean;
 }
 
 /**
- * useReverb — algorithmic reverb (Freeverb-based).
+ * useReverb — algorithmic reverb (Freeverb or feedback delay network).
  */
 export function useReverb(input: Signal, params: ReverbParams): Signal {
   return useAudioNode(
@@ -31,6 +41,7 @@ export function useReverb(input: Signal, params: ReverbParams): Signal {
       [PARAM_DAMPING]: params.damping,
       [PARAM_MIX]: params.mix,
       [PARAM_PRE_DELAY]: params.preDelay ?? 0,
+      [PARAM_REVERB_ENGINE]: params.engine ?? "freeverb",
       [PARAM_BYPASS]: params.bypass ?? false,
     },
     [input],
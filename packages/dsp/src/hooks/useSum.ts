@@ -0,0 +1,28 @@
+import type { Signal } from "@react-audio-unit/core";
+import { useAudioNode } from "../useAudioNode.js";
+import { PARAM_BYPASS } from "../param-keys.js";
+
+export interface SumParams {
+  /** Per-input linear gains, matched to `inputs` by index. Default 1. */
+  gains?: number[];
+  bypass?: boolean;
+}
+
+/**
+ * useSum — bus any number of signals into one.
+ *
+ * Every input connects to the same inlet of a native `sum` node, and the
+ * graph adds them (with per-input gain) in a single vectorised pass. Use
+ * it instead of chains of `useMix` to build submixes.
+ *
+ * @param inputs - Signals to sum
+ */
+export function useSum(inputs: Signal[], params: SumParams = {}): Signal {
+  const { gains, bypass = false } = params;
+
+  return useAudioNode("sum", { [PARAM_BYPASS]: bypass }, [
+    inputs.map((signal, i) =>
+      gains?.[i] !== undefined ? { signal, gain: gains[i] } : signal,
+    ),
+  ]);
+}
@@ -3,6 +3,7 @@ export * from "./param-keys.js";
 
 // Core audio node hook
 export { useAudioNode } from "./useAudioNode.js";
+export type { SummedInput, ModulationInput } from "./useAudioNode.js";
 
 // I/O
 export { useInput } from "./hooks/useInput.js";
@@ -10,18 +11,21 @@ export { useOutput } from "./hooks/useOutput.js";
 
 // Parameters
 export { useParameter } from "./hooks/useParameter.js";
+export { useParameterBinding } from "./hooks/useParameterBinding.js";
 
 // DSP nodes
 export { useGain } from "./hooks/useGain.js";
 export type { GainParams } from "./hooks/useGain.js";
 
 export { useDelay } from "./hooks/useDelay.js";
-export type { DelayParams } from "./hooks/useDelay.js";
+export type { DelayParams, SampleStorage } from "./hooks/useDelay.js";
 
 export { useFilter } from "./hooks/useFilter.js";
 export type { FilterParams, FilterType } from "./hooks/useFilter.js";
 
 export { useMix } from "./hooks/useMix.js";
+export { useSum } from "./hooks/useSum.js";
+export type { SumParams } from "./hooks/useSum.js";
 
 export { useOscillator } from "./hooks/useOscillator.js";
 export type { OscillatorParams, WaveformType } from "./hooks/useOscillator.js";
@@ -30,7 +34,7 @@ export { useCompressor } from "./hooks/useCompressor.js";
 export type { CompressorParams } from "./hooks/useCompressor.js";
 
 export { useReverb } from "./hooks/useReverb.js";
-export type { ReverbParams } from "./hooks/useReverb.js";
+export type { ReverbParams, ReverbEngine } from "./hooks/useReverb.js";
 
 export { useConvolver } from "./hooks/useConvolver.js";
 export type { ConvolverParams } from "./hooks/useConvolver.js";
@@ -67,6 +71,9 @@ export { useChannelMerge } from "./hooks/useChannelMerge.js";
 export { useChannelSplit as useSplit } from "./hooks/useChannelSplit.js";
 export { useChannelMerge as useMerge } from "./hooks/useChannelMerge.js";
 
+export { useCrossover } from "./hooks/useCrossover.js";
+export type { CrossoverParams } from "./hooks/useCrossover.js";
+
 // Analysis
 export { useMeter } from "./hooks/useMeter.js";
 export type { MeterData, MeterType } from "./hooks/useMeter.js";
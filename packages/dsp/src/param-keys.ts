@@ -12,12 +12,15 @@
 
 // --- Common (shared across many nodes) -----------------------------------
 export const PARAM_BYPASS = "bypass";
+/** Sample storage of long buffers (delay lines, IR partitions) */
+export const PARAM_STORAGE = "storage";
 
 // --- GainNode -------------------------------------------------------------
 export const PARAM_GAIN = "gain";
 
 // --- DelayNode ------------------------------------------------------------
 export const PARAM_DELAY_TIME = "time";
+export const PARAM_MAX_DELAY_TIME = "maxTime";
 export const PARAM_FEEDBACK = "feedback";
 export const PARAM_MIX = "mix";
 
@@ -40,6 +43,7 @@ export const PARAM_MAKEUP_DB = "makeupDb";
 export const PARAM_ROOM_SIZE = "roomSize";
 export const PARAM_DAMPING = "damping";
 export const PARAM_PRE_DELAY = "preDelay";
+export const PARAM_REVERB_ENGINE = "engine";
 
 // --- DistortionNode -------------------------------------------------------
 export const PARAM_DISTORTION_TYPE = "distortionType";
@@ -61,6 +65,9 @@ export const PARAM_LFO_RATE = "rate";
 export const PARAM_LFO_DEPTH = "depth";
 export const PARAM_LFO_PHASE = "phase";
 
+// --- Control-rate modulators (LFO & envelope) ----------------------------
+export const PARAM_CONTROL_INTERVAL = "controlInterval";
+
 // --- Shared time-based params (compressor & envelope) ---------------------
 export const PARAM_ATTACK = "attack";
 export const PARAM_RELEASE = "release";
@@ -73,6 +80,22 @@ export const PARAM_SUSTAIN = "sustain";
 export const PARAM_METER_TYPE = "meterType";
 export const PARAM_REFRESH_RATE = "refreshRate";
 
+// --- ModDelayNode (chorus / flanger) --------------------------------------
+// Uses PARAM_DELAY_TIME, PARAM_LFO_DEPTH, PARAM_LFO_RATE, PARAM_FEEDBACK
+// and PARAM_MIX
+export const PARAM_VOICES = "voices";
+export const PARAM_SPREAD = "spread";
+
+// --- PhaserNode -----------------------------------------------------------
+// Uses PARAM_FREQUENCY, PARAM_LFO_RATE, PARAM_LFO_DEPTH, PARAM_FEEDBACK,
+// PARAM_SPREAD and PARAM_MIX
+export const PARAM_STAGES = "stages";
+
+// --- CrossoverNode --------------------------------------------------------
+export const PARAM_LOW_CROSSOVER = "lowCrossover";
+export const PARAM_MID_CROSSOVER = "midCrossover";
+export const PARAM_HIGH_CROSSOVER = "highCrossover";
+
 // --- ConvolverNode --------------------------------------------------------
 // Uses PARAM_MIX and PARAM_GAIN
 
@@ -2,6 +2,8 @@ import { useRef, useMemo } from "react";
 import {
   useAudioGraphContext,
   type Signal,
+  type ConnectionDescriptor,
+  type ModulationCurve,
   createSignal,
 } from "@react-audio-unit/core";
 
@@ -13,6 +15,28 @@ import {
  */
 let globalNodeCounter = 0;
 
+/**
+ * One connection into a summing inlet: a signal, optionally scaled.
+ */
+export type SummedInput = Signal | { signal: Signal; gain: number };
+
+/**
+ * A signal driving a parameter. Each sample the parameter's value is
+ * offset by `offset + depth · curve(signal)`, read from the signal's
+ * first channel.
+ */
+export type ModulationInput =
+  | Signal
+  | {
+      signal: Signal;
+      /** Default 1. */
+      depth?: number;
+      /** Default 0. */
+      offset?: number;
+      /** Default "linear". */
+      curve?: ModulationCurve;
+    };
+
 /**
  * useAudioNode — the primitive that every DSP hook builds on.
  *
@@ -23,13 +47,20 @@ let globalNodeCounter = 0;
  *
  * @param type    - Node type identifier (must match a native C++ node)
  * @param params  - Node parameters (numbers, strings, booleans)
- * @param inputs  - Incoming audio signals (connections from other nodes)
+ * @param inputs  - Incoming audio signals (connections from other nodes),
+ *                  one entry per inlet. An array entry connects several
+ *                  signals to the same inlet; the native graph sums them.
+ * @param modulations - Signals driving parameters, keyed by parameter
+ *                  name. Several entries for one parameter are summed.
+ *                  Resolved natively at audio rate; nothing crosses the
+ *                  bridge per block.
  * @returns Signal handle pointing to this node's output
  */
 export function useAudioNode(
   type: string,
   params: Record<string, number | string | boolean>,
-  inputs: Signal[] = [],
+  inputs: (Signal | SummedInput[])[] = [],
+  modulations: Record<string, ModulationInput | ModulationInput[]> = {},
 ): Signal {
   const ctx = useAudioGraphContext();
 
@@ -42,17 +73,53 @@ export function useAudioNode(
   }
   const nodeId = nodeIdRef.current;
 
+  // Connections into parameters, after the inlet connections
+  const modulationInputs: ConnectionDescriptor[] = Object.entries(
+    modulations,
+  ).flatMap(([param, modulation]) => {
+    const entries = Array.isArray(modulation) ? modulation : [modulation];
+    return entries.map((entry) =>
+      "signal" in entry
+        ? {
+            fromNodeId: entry.signal.nodeId,
+            fromOutlet: entry.signal.outlet,
+            toInlet: 0,
+            toParam: param,
+            gain: entry.depth,
+            offset: entry.offset,
+            curve: entry.curve,
+          }
+        : {
+            fromNodeId: entry.nodeId,
+            fromOutlet: entry.outlet,
+            toInlet: 0,
+            toParam: param,
+          },
+    );
+  });
+
   // Register this node in the virtual graph (happens every render).
   // The reconciler will diff against the previous render's graph.
   ctx.registerNode({
     id: nodeId,
     type,
     params,
-    inputs: inputs.map((sig, i) => ({
-      fromNodeId: sig.nodeId,
-      fromOutlet: sig.outlet,
-      toInlet: i,
-    })),
+    inputs: [
+      ...inputs.flatMap((input, i) => {
+        const entries: SummedInput[] = Array.isArray(input) ? input : [input];
+        return entries.map((entry) =>
+          "signal" in entry
+            ? {
+                fromNodeId: entry.signal.nodeId,
+                fromOutlet: entry.signal.outlet,
+                toInlet: i,
+                gain: entry.gain,
+              }
+            : { fromNodeId: entry.nodeId, fromOutlet: entry.outlet, toInlet: i },
+        );
+      }),
+      ...modulationInputs,
+    ],
   });
 
   // Return a stable Signal reference (only changes if nodeId changes, which it won't)
@@ -0,0 +1,174 @@
+/**
+ * GraphEditBenchmark — measures how fast the AudioGraph absorbs topology
+ * edits on a large graph.
+ *
+ * Builds a layered graph of gain nodes, then applies a stream of random
+ * single edits (connect, disconnect, add, remove) through queueOp(), each
+ * of which publishes a new snapshot. New connections mostly run from an
+ * earlier layer to a later one, with an occasional one running backwards
+ * to create a feedback loop; pass "random" to wire arbitrary pairs, which
+ * quickly tangles most of the graph into one big cycle, or "loop" to start
+ * from a graph that already holds a small feedback loop, so every edit
+ * re-selects feedback edges from the first. A block is processed after
+ * every edit so retired snapshots and nodes are collected as they would
+ * be in a running plugin.
+ *
+ * Usage: RauGraphEditBenchmark [numNodes=1000] [numEdits=20000] [random|loop]
+ */
+
+#include "AudioGraph.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    rau::GraphOp makeAddNode(const std::string &id, const std::string &type)
+    {
+        rau::GraphOp op;
+        op.type = rau::GraphOp::AddNode;
+        op.nodeId = id;
+        op.nodeType = type;
+        return op;
+    }
+
+    rau::GraphOp makeConnection(rau::GraphOp::Type type, const std::string &from, const std::string &to)
+    {
+        rau::GraphOp op;
+        op.type = type;
+        op.fromNodeId = from;
+        op.toNodeId = to;
+        return op;
+    }
+
+    double percentile(std::vector<double> &sorted, double p)
+    {
+        const auto index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1));
+        return sorted[index];
+    }
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    const int numNodes = argc > 1 ? std::max(16, std::atoi(argv[1])) : 1000;
+    const int numEdits = argc > 2 ? std::max(1, std::atoi(argv[2])) : 20000;
+    const std::string wiring = argc > 3 ? argv[3] : "layered";
+    const bool randomWiring = wiring == "random";
+    constexpr int layerSize = 32;
+    constexpr int blockSize = 256;
+
+    rau::AudioGraph graph;
+    graph.prepare(48000.0, blockSize, 2);
+
+    std::mt19937 rng(1234);
+    std::vector<std::string> ids;
+    std::unordered_map<std::string, int> layerOf;
+    std::vector<std::pair<std::string, std::string>> connections;
+
+    // Initial graph: layers of gain nodes, each fed by a few nodes of the
+    // layer before it
+    std::vector<rau::GraphOp> ops;
+    ops.push_back(makeAddNode("in", "input"));
+    for (int i = 0; i < numNodes; ++i)
+    {
+        const int layer = i / layerSize;
+        ids.push_back("g" + std::to_string(i));
+        layerOf[ids.back()] = layer;
+        ops.push_back(makeAddNode(ids.back(), "gain"));
+
+        for (int k = 0; k < 2; ++k)
+        {
+            const std::string from = layer == 0
+                                         ? std::string("in")
+                                         : ids[static_cast<size_t>((layer - 1) * layerSize) + rng() % layerSize];
+            ops.push_back(makeConnection(rau::GraphOp::Connect, from, ids.back()));
+            connections.emplace_back(from, ids.back());
+        }
+    }
+    if (wiring == "loop")
+    {
+        // Two nodes of the first layer feeding each other. The loop isn't
+        // in `connections`, so only removing one of its nodes breaks it.
+        ops.push_back(makeConnection(rau::GraphOp::Connect, ids[0], ids[1]));
+        ops.push_back(makeConnection(rau::GraphOp::Connect, ids[1], ids[0]));
+    }
+
+    rau::GraphOp setOutput;
+    setOutput.type = rau::GraphOp::SetOutput;
+    setOutput.nodeId = ids.back();
+    ops.push_back(setOutput);
+
+    auto start = juce::Time::getHighResolutionTicks();
+    graph.queueOps(std::move(ops));
+    const double buildMs = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start) * 1000.0;
+
+    juce::AudioBuffer<float> buffer(2, blockSize);
+    juce::MidiBuffer midi;
+    graph.processBlock(buffer, midi);
+
+    std::vector<double> latencies;
+    latencies.reserve(static_cast<size_t>(numEdits));
+    int nextId = numNodes;
+    const int numLayers = (numNodes + layerSize - 1) / layerSize;
+    double totalSeconds = 0.0;
+
+    for (int i = 0; i < numEdits; ++i)
+    {
+        // Random edits, biased towards rewiring so the node count stays put
+        rau::GraphOp op;
+        const auto kind = rng() % 8;
+        if (kind < 4)
+        {
+            auto from = ids[rng() % ids.size()];
+            auto to = ids[rng() % ids.size()];
+            const bool backwards = randomWiring || rng() % 32 == 0;
+            if ((layerOf[from] > layerOf[to]) != backwards)
+                std::swap(from, to);
+            op = makeConnection(rau::GraphOp::Connect, from, to);
+            connections.emplace_back(from, to);
+        }
+        else if (kind < 7 && !connections.empty())
+        {
+            const auto index = rng() % connections.size();
+            op = makeConnection(rau::GraphOp::Disconnect, connections[index].first, connections[index].second);
+            connections[index] = connections.back();
+            connections.pop_back();
+        }
+        else if (rng() % 2 == 0)
+        {
+            ids.push_back("g" + std::to_string(nextId++));
+            layerOf[ids.back()] = static_cast<int>(rng() % static_cast<unsigned>(numLayers));
+            op = makeAddNode(ids.back(), "gain");
+        }
+        else
+        {
+            const auto index = rng() % ids.size();
+            op.type = rau::GraphOp::RemoveNode;
+            op.nodeId = ids[index];
+            ids[index] = ids.back();
+            ids.pop_back();
+        }
+
+        start = juce::Time::getHighResolutionTicks();
+        graph.queueOp(std::move(op));
+        const double seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+        totalSeconds += seconds;
+        latencies.push_back(seconds * 1.0e6);
+        graph.processBlock(buffer, midi);
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+
+    std::printf("nodes: %d, edits: %d (%s wiring), initial build: %.2f ms\n",
+                numNodes, numEdits, wiring.c_str(), buildMs);
+    std::printf("throughput: %.0f edits/s\n", static_cast<double>(numEdits) / totalSeconds);
+    std::printf("latency (us): median %.1f, p99 %.1f, max %.1f\n",
+                percentile(latencies, 0.5), percentile(latencies, 0.99), latencies.back());
+    std::printf("cycles in final graph: %zu\n", graph.getCycles().size());
+    return 0;
+}
@@ -1,78 +1,247 @@
 #include "AudioGraph.h"
 #include "nodes/MidiInputNode.h"
 #include <algorithm>
-#include <queue>
+#include <array>
 #include <cassert>
+#include <chrono>
+#include <cmath>
+#include <queue>
+#include <thread>
+#include <tuple>
 
 namespace rau
 {
 
     static constexpr int BUFFER_POOL_SIZE = 32;
 
+    // Samples per tile when running a fused chain: small enough that a tile
+    // of every channel stays in L1 from the first node to the last.
+    static constexpr int FUSION_TILE_SIZE = 64;
+
+    static bool sameConnection(const GraphSnapshot::Connection &a, const GraphSnapshot::Connection &b)
+    {
+        return a.fromNodeId == b.fromNodeId && a.fromOutlet == b.fromOutlet &&
+               a.toNodeId == b.toNodeId && a.toInlet == b.toInlet && a.toParam == b.toParam;
+    }
+
+    namespace
+    {
+        // Run fn(items[i]) for every item, on the shared prepare threads
+        template <typename T, typename Fn>
+        void parallelFor(PrepareThreads &threads, const std::vector<T> &items, Fn &&fn)
+        {
+            threads.run(static_cast<int>(items.size()), [&](int i)
+                        { fn(items[static_cast<size_t>(i)]); });
+        }
+
+        // Runs in place of a node that is still being prepared in the
+        // background: inlet 0 passes through, as if the node were bypassed
+        class PlaceholderNode : public AudioNodeBase
+        {
+        public:
+            explicit PlaceholderNode(int numOutlets) { setNumOutlets(numOutlets); }
+            void process(int numSamples) override { processBypass(numSamples); }
+        };
+    } // namespace
+
+    bool GraphCycle::operator==(const GraphCycle &other) const
+    {
+        return nodeIds == other.nodeIds &&
+               std::equal(feedbackConnections.begin(), feedbackConnections.end(),
+                          other.feedbackConnections.begin(), other.feedbackConnections.end(), sameConnection);
+    }
+
+    // ---------------------------------------------------------------------------
+    // FeedbackLine
+    // ---------------------------------------------------------------------------
+
+    void FeedbackLine::prepare(int numChannels, int maxBlockSize)
+    {
+        if (delay == maxBlockSize && ring.getNumChannels() == numChannels)
+            return; // keep the circulating signal
+
+        delay = maxBlockSize;
+        ring.setSize(numChannels, 2 * maxBlockSize);
+        ring.clear();
+        output.setSize(numChannels, maxBlockSize);
+        output.clear();
+        writePos = 0;
+    }
+
+    void FeedbackLine::read(int numSamples)
+    {
+        const int size = ring.getNumSamples();
+        const int start = (writePos - delay + size) % size;
+        const int first = juce::jmin(numSamples, size - start);
+
+        for (int ch = 0; ch < ring.getNumChannels(); ++ch)
+        {
+            output.copyFrom(ch, 0, ring, ch, start, first);
+            if (first < numSamples)
+                output.copyFrom(ch, first, ring, ch, 0, numSamples - first);
+        }
+    }
+
+    void FeedbackLine::write(const juce::AudioBuffer<float> &source, int numSamples)
+    {
+        const int size = ring.getNumSamples();
+        const int first = juce::jmin(numSamples, size - writePos);
+
+        for (int ch = 0; ch < ring.getNumChannels(); ++ch)
+        {
+            // A mono source is broadcast
+            const int sourceCh = source.getNumChannels() == 1 ? 0 : ch;
+            if (sourceCh >= source.getNumChannels())
+            {
+                ring.clear(ch, writePos, first);
+                if (first < numSamples)
+                    ring.clear(ch, 0, numSamples - first);
+                continue;
+            }
+
+            ring.copyFrom(ch, writePos, source, sourceCh, 0, first);
+            if (first < numSamples)
+                ring.copyFrom(ch, 0, source, sourceCh, first, numSamples - first);
+        }
+
+        writePos = (writePos + numSamples) % size;
+    }
+
     AudioGraph::AudioGraph()
     {
-        snapshotA = std::make_unique<GraphSnapshot>();
-        snapshotB = std::make_unique<GraphSnapshot>();
-        activeSnapshot.store(snapshotA.get(), std::memory_order_relaxed);
+        published = std::make_shared<GraphSnapshot>();
+        activeSnapshot.store(published.get(), std::memory_order_relaxed);
     }
 
-    AudioGraph::~AudioGraph() = default;
+    AudioGraph::~AudioGraph()
+    {
+        // Jobs still preparing our nodes write to them; wait them out, then
+        // for the last one to leave the callback
+        waitForPreparedNodes();
+        std::lock_guard<std::mutex> lock(preparedLock);
+    }
 
     void AudioGraph::prepare(double sampleRate, int maxBlockSize, int numChannels)
     {
+        numChannels = juce::jlimit(1, MAX_LAYOUT_CHANNELS, numChannels);
+        const bool layoutChanged = numChannels != currentNumChannels;
         currentSampleRate = sampleRate;
         currentBlockSize = maxBlockSize;
         currentNumChannels = numChannels;
 
-        // Pre-allocate buffer pool
-        bufferPool.resize(BUFFER_POOL_SIZE);
-        bufferInUse.resize(BUFFER_POOL_SIZE, false);
-        for (auto &buf : bufferPool)
+        // Room for a typical block's worth of MIDI per sub-block
+        subBlockMidi.ensureSize(4096);
+
+        // Pool buffers hold the full layout. The audio thread isn't
+        // running, so the live pool is resized in place.
+        if (bufferPool)
         {
-            buf.setSize(numChannels, maxBlockSize);
-            buf.clear();
+            for (auto &buf : bufferPool->buffers)
+            {
+                buf.setSize(numChannels, maxBlockSize);
+                buf.clear();
+            }
+        }
+        else
+        {
+            allocateBufferPool(BUFFER_POOL_SIZE);
         }
 
-        // Prepare all existing nodes
+        // Prepare all existing nodes, in parallel. Nodes still preparing in
+        // the background are finished here too, so they can be swapped in
+        // before the audio thread starts.
+        waitForPreparedNodes();
+
+        // The audio thread isn't running, so nothing retired is in use.
+        // Updates still queued for removed nodes land first; the nodes then
+        // go back to the pool, to be prepared with the other spares.
+        paramMailbox.deliver();
+        for (auto &r : retired)
+            nodePool.recycle(std::move(r.node));
+        retired.clear();
+
+        std::vector<AudioNodeBase *> toPrepare;
         for (auto &[id, node] : nodes)
         {
             if (node)
             {
-                node->prepare(sampleRate, maxBlockSize);
+                node->setMaxChannels(numChannels);
+                toPrepare.push_back(node.get());
             }
         }
+        for (auto &[id, preparation] : preparing)
+            toPrepare.push_back(preparation.placeholder.get());
+        for (auto *spare : nodePool.getSpares())
+        {
+            spare->setMaxChannels(numChannels);
+            toPrepare.push_back(spare);
+        }
+        parallelFor(*prepareThreads, toPrepare, [sampleRate, maxBlockSize](AudioNodeBase *node)
+                    { node->prepare(sampleRate, maxBlockSize); });
+        unprepared.clear();
+        publishPreparedNodes();
+
+        for (auto &edge : edges)
+            if (edge.alive && edge.feedback)
+                edge.feedback->prepare(numChannels, maxBlockSize);
+
+        // Node widths are bounded by the layout, so a new one re-infers
+        // them all
+        if (layoutChanged && !vertexIds.empty())
+        {
+            for (auto &[id, v] : vertexIds)
+                markDirty(v);
+            rebuildAndPublishSnapshot();
+        }
     }
 
-    int AudioGraph::acquireBuffer()
+    void AudioGraph::allocateBufferPool(int numBuffers)
     {
-        for (int i = 0; i < static_cast<int>(bufferInUse.size()); ++i)
+        auto pool = std::make_shared<BufferPool>();
+        pool->buffers.resize(static_cast<size_t>(numBuffers));
+        for (auto &buf : pool->buffers)
         {
-            if (!bufferInUse[i])
-            {
-                bufferInUse[i] = true;
-                bufferPool[i].clear();
-                return i;
-            }
+            buf.setSize(currentNumChannels, currentBlockSize);
+            buf.clear();
         }
-        // Pool exhausted — grow it (safety net; pool should be sized to avoid this)
-        int idx = static_cast<int>(bufferPool.size());
-        bufferPool.emplace_back();
-        bufferPool.back().setSize(currentNumChannels, currentBlockSize);
-        bufferPool.back().clear();
-        bufferInUse.push_back(true);
-        return idx;
+        bufferPool = std::move(pool);
     }
 
-    void AudioGraph::releaseBuffer(int index)
+    BufferRef AudioGraph::acquireBuffer(int numChannels, int numSamples)
     {
-        if (index >= 0 && index < static_cast<int>(bufferInUse.size()))
+        // The pool holds every entry's worst case, so running out means an
+        // entry took more than it counted. Never allocate here: the caller
+        // gets no buffer, and what it would have written reads as silence.
+        auto &pool = *activeBuffers;
+        if (pool.numUsed >= static_cast<int>(pool.buffers.size()))
         {
-            bufferInUse[index] = false;
+            jassertfalse;
+            return {};
         }
+
+        // Narrowing keeps the allocation, so widening again is free too
+        numChannels = juce::jlimit(1, currentNumChannels, numChannels);
+        const int idx = pool.numUsed++;
+        auto &buf = pool.buffers[static_cast<size_t>(idx)];
+        buf.setSize(numChannels, currentBlockSize, false, false, true);
+
+        // Nothing reads past the sub-block, so only it needs clearing
+        buf.clear(0, numSamples);
+        return {&buf, idx};
+    }
+
+    BufferRef AudioGraph::broadcast(const juce::AudioBuffer<float> &mono, int numChannels, int numSamples)
+    {
+        auto wide = acquireBuffer(numChannels, numSamples);
+        if (!wide.isValid())
+            return {};
+        for (int ch = 0; ch < wide.buffer->getNumChannels(); ++ch)
+            juce::FloatVectorOperations::copy(wide.buffer->getWritePointer(ch), mono.getReadPointer(0), numSamples);
+        return wide;
     }
 
     // ---------------------------------------------------------------------------
-    // Operation queue (message thread side)
+    // Topology model (message thread)
     // ---------------------------------------------------------------------------
 
     // Apply a single topology op to the authoritative state (message thread).
@@ -83,16 +252,69 @@ namespace rau
         {
         case GraphOp::AddNode:
         {
-            auto node = NodeFactory::create(op.nodeType);
+            // A node of the same type already under this ID (restored from
+            // saved state, or a UI resyncing after a reload) keeps its
+            // state; only its parameters change. It must still be the
+            // node its vertex runs (or is preparing to run).
+            auto existing = nodes.find(op.nodeId);
+            auto vertex = vertexIds.find(op.nodeId);
+            if (existing != nodes.end() && existing->second && existing->second->nodeType == op.nodeType &&
+                vertex != vertexIds.end() &&
+                (vertices[static_cast<size_t>(vertex->second)].node == existing->second.get() ||
+                 preparing.count(op.nodeId) > 0))
+            {
+                postParams(op);
+                break;
+            }
+
+            // A spare from the pool is already prepared for this config
+            auto node = nodePool.take(op.nodeType);
+            const bool recycled = node != nullptr;
+            if (!recycled)
+                node = NodeFactory::create(op.nodeType);
             if (node)
             {
                 node->nodeId = op.nodeId;
                 node->nodeType = op.nodeType;
+                node->setArena(&arena);
+                node->setSubBlockSize(subBlockSize.load(std::memory_order_relaxed));
                 for (auto &[k, v] : op.params)
                 {
                     node->setParam(k, v);
                 }
-                node->prepare(currentSampleRate, currentBlockSize);
+                // Bound parameters start at the host's value, so smoothers
+                // don't glide from the JS default
+                for (auto &binding : hostBindings)
+                {
+                    if (binding.nodeId != op.nodeId)
+                        continue;
+                    if (auto *storage = node->getParamStorage(binding.param))
+                        storage->store(binding.range.toActual(binding.source->load(std::memory_order_relaxed)));
+                }
+                retireNode(op.nodeId);
+                if (backgroundPreparation && node->hasHeavyPrepare())
+                {
+                    // A recycled node is reset there instead: that may
+                    // prepare again (a delay sized for a longer maximum)
+                    node->setMaxChannels(currentNumChannels);
+                    addVertex(op.nodeId, prepareInBackground(*node, recycled), -1);
+                }
+                else if (recycled)
+                {
+                    // Clears what it held for its last owner and settles
+                    // its smoothers on the new parameters. Usually that
+                    // keeps its storage, but reset() may prepare again
+                    // when the new parameters size it differently
+                    node->reset();
+                    addVertex(op.nodeId, node.get(), -1);
+                }
+                else
+                {
+                    // Prepared with the rest of the edit's new nodes
+                    node->setMaxChannels(currentNumChannels);
+                    unprepared.push_back(node.get());
+                    addVertex(op.nodeId, node.get(), -1);
+                }
                 nodes[op.nodeId] = std::move(node);
             }
             else if (op.nodeType == "input")
@@ -101,56 +323,49 @@ namespace rau
                 auto chIt = op.params.find("channel");
                 if (chIt != op.params.end())
                     busIndex = static_cast<int>(chIt->second);
-                inputNodeIds[busIndex] = op.nodeId;
-                if (busIndex == 0)
-                    inputNodeId = op.nodeId;
+                retireNode(op.nodeId);
+                addVertex(op.nodeId, nullptr, busIndex);
             }
             break;
         }
         case GraphOp::RemoveNode:
         {
-            connections.erase(
-                std::remove_if(connections.begin(), connections.end(),
+            pendingConnections.erase(
+                std::remove_if(pendingConnections.begin(), pendingConnections.end(),
                                [&](const GraphSnapshot::Connection &c)
                                {
                                    return c.fromNodeId == op.nodeId || c.toNodeId == op.nodeId;
                                }),
-                connections.end());
-            nodes.erase(op.nodeId);
-            if (op.nodeId == inputNodeId)
-                inputNodeId.clear();
-            // Clean up multi-bus input entries
-            for (auto it = inputNodeIds.begin(); it != inputNodeIds.end();)
-            {
-                if (it->second == op.nodeId)
-                    it = inputNodeIds.erase(it);
-                else
-                    ++it;
-            }
+                pendingConnections.end());
+
+            auto it = vertexIds.find(op.nodeId);
+            if (it != vertexIds.end())
+                removeVertex(it->second);
+
+            retireNode(op.nodeId);
             break;
         }
         case GraphOp::Connect:
         {
-            connections.push_back({op.fromNodeId, op.fromOutlet, op.toNodeId, op.toInlet});
+            connect({op.fromNodeId, op.fromOutlet, op.toNodeId, op.toInlet, op.gain, op.toParam, op.offset, op.curve});
             break;
         }
         case GraphOp::Disconnect:
         {
-            connections.erase(
-                std::remove_if(connections.begin(), connections.end(),
-                               [&](const GraphSnapshot::Connection &c)
-                               {
-                                   return c.fromNodeId == op.fromNodeId &&
-                                          c.fromOutlet == op.fromOutlet &&
-                                          c.toNodeId == op.toNodeId &&
-                                          c.toInlet == op.toInlet;
-                               }),
-                connections.end());
+            disconnect({op.fromNodeId, op.fromOutlet, op.toNodeId, op.toInlet, 1.0f, op.toParam});
             break;
         }
         case GraphOp::SetOutput:
         {
+            // The output node's buffer must stay visible, so it can't be
+            // fused into a chain that continues past it
+            auto oldIt = vertexIds.find(outputNodeId);
+            if (oldIt != vertexIds.end())
+                markDirty(oldIt->second);
             outputNodeId = op.nodeId;
+            auto newIt = vertexIds.find(outputNodeId);
+            if (newIt != vertexIds.end())
+                markDirty(newIt->second);
             break;
         }
         default:
@@ -158,327 +373,2132 @@ namespace rau
         }
     }
 
-    void AudioGraph::queueOp(GraphOp op)
+    // Hand the node under `id` (and its placeholder, if it's still being
+    // prepared) to the garbage collector
+    void AudioGraph::retireNode(const std::string &id)
     {
-        // UpdateParams go through the fast SPSC queue — audio thread applies
-        // them directly to the atomic params on existing nodes.
-        if (op.type == GraphOp::UpdateParams)
+        const auto epoch = blocksCompleted.load(std::memory_order_acquire);
+
+        std::shared_ptr<std::atomic<bool>> inFlight;
+        auto preparation = preparing.find(id);
+        if (preparation != preparing.end())
         {
-            paramOpQueue.push(std::move(op));
-            return;
+            inFlight = std::move(preparation->second.done);
+            retired.push_back({epoch, nullptr, std::move(preparation->second.placeholder), nullptr});
+            preparing.erase(preparation);
         }
 
-        // Topology changes are applied immediately on the message thread
-        // to the authoritative state, then a new snapshot is built and
-        // published atomically for the audio thread.
-        applyTopologyOp(op);
-        rebuildAndPublishSnapshot();
+        auto it = nodes.find(id);
+        if (it != nodes.end())
+        {
+            retired.push_back({epoch, nullptr, std::move(it->second), std::move(inFlight)});
+            nodes.erase(it);
+        }
     }
 
-    void AudioGraph::queueOps(std::vector<GraphOp> ops)
+    // ---------------------------------------------------------------------------
+    // Node preparation (message thread)
+    // ---------------------------------------------------------------------------
+
+    void AudioGraph::prepareNewNodes()
     {
-        bool topologyChanged = false;
+        if (unprepared.empty())
+            return;
+        parallelFor(*prepareThreads, unprepared, [this](AudioNodeBase *node)
+                    { node->prepare(currentSampleRate, currentBlockSize); });
+        unprepared.clear();
+    }
 
-        for (auto &op : ops)
-        {
-            if (op.type == GraphOp::UpdateParams)
-            {
-                paramOpQueue.push(std::move(op));
-            }
+    // Start preparing `node` on the worker (resetting it, if it's a pooled
+    // node already prepared for this config) and return the placeholder
+    // that runs in its place until publishPreparedNodes() swaps it in
+    AudioNodeBase *AudioGraph::prepareInBackground(AudioNodeBase &node, bool recycled)
+    {
+        auto placeholder = std::make_unique<PlaceholderNode>(node.getNumOutlets());
+        placeholder->nodeId = node.nodeId; // no type: the pool won't keep it
+        placeholder->setMaxChannels(currentNumChannels);
+        placeholder->prepare(currentSampleRate, currentBlockSize);
+
+        // The config can't change meanwhile: prepare() waits for every job
+        auto done = std::make_shared<std::atomic<bool>>(false);
+        worker->post([this, target = &node, recycled, done, sr = currentSampleRate, blockSize = currentBlockSize]
+                     {
+            if (recycled)
+                target->reset();
             else
+                target->prepare(sr, blockSize);
+            std::lock_guard<std::mutex> lock(preparedLock);
+            done->store(true, std::memory_order_release);
+            if (preparedCallback)
+                preparedCallback(); });
+
+        auto *standIn = placeholder.get();
+        preparing[node.nodeId] = {std::move(placeholder), std::move(done)};
+        return standIn;
+    }
+
+    void AudioGraph::onNodePrepared(std::function<void()> cb)
+    {
+        std::lock_guard<std::mutex> lock(preparedLock);
+        preparedCallback = std::move(cb);
+    }
+
+    void AudioGraph::publishPreparedNodes()
+    {
+        bool swapped = false;
+        for (auto it = preparing.begin(); it != preparing.end();)
+        {
+            if (!it->second.done->load(std::memory_order_acquire))
             {
-                applyTopologyOp(op);
-                topologyChanged = true;
+                ++it;
+                continue;
             }
+
+            // Swapping in place keeps the vertex's connections and
+            // rebuilds its consumers' entries
+            auto *node = nodes[it->first].get();
+            node->setSubBlockSize(subBlockSize.load(std::memory_order_relaxed));
+            addVertex(it->first, node, -1);
+            retired.push_back({blocksCompleted.load(std::memory_order_acquire), nullptr, std::move(it->second.placeholder), nullptr});
+            it = preparing.erase(it);
+            swapped = true;
         }
 
-        // Rebuild the snapshot only once after all ops are applied,
-        // so the audio thread never sees an intermediate state.
-        if (topologyChanged)
-        {
+        if (swapped)
             rebuildAndPublishSnapshot();
+    }
+
+    void AudioGraph::prewarmNodes(const std::string &type, int count)
+    {
+        auto created = nodePool.prewarm(type, count);
+        for (auto *node : created)
+        {
+            node->setArena(&arena);
+            node->setMaxChannels(currentNumChannels);
         }
+        parallelFor(*prepareThreads, created, [this](AudioNodeBase *node)
+                    { node->prepare(currentSampleRate, currentBlockSize); });
     }
 
-    void AudioGraph::setHostInputBuffer(int busIndex, juce::AudioBuffer<float> *buffer)
+    void AudioGraph::setMemoryBudget(size_t bytes)
     {
-        hostInputBuffers[busIndex] = buffer;
+        arena.setBudget(bytes);
     }
 
-    void AudioGraph::setNodeParam(const std::string &nodeId, const std::string &param, float value)
+    GraphMemoryReport AudioGraph::getMemoryReport() const
     {
-        // Message-thread only — safe to access the authoritative `nodes` map.
-        // The write itself is atomic (AtomicFloat), so the audio thread
-        // picks up the new value lock-free on its next block.
-        auto it = nodes.find(nodeId);
-        if (it != nodes.end() && it->second)
+        GraphMemoryReport report;
+        for (auto &[id, node] : nodes)
         {
-            it->second->setParam(param, value);
+            if (node)
+                report.nodes.push_back({id, node->nodeType, arena.getBytesOwnedBy(node.get())});
         }
+        std::sort(report.nodes.begin(), report.nodes.end(),
+                  [](const GraphMemoryReport::NodeMemory &a, const GraphMemoryReport::NodeMemory &b)
+                  { return a.nodeId < b.nodeId; });
+
+        const auto usage = arena.getUsage();
+        report.inUse = usage.inUse;
+        report.reserved = usage.reserved;
+        report.budget = usage.budget;
+        report.overBudget = usage.overBudget;
+        return report;
     }
 
-    AudioNodeBase *AudioGraph::getNode(const std::string &nodeId) const
+    void AudioGraph::waitForPreparedNodes()
     {
-        auto it = nodes.find(nodeId);
-        if (it != nodes.end())
-            return it->second.get();
-        return nullptr;
+        auto waitFor = [](const std::shared_ptr<std::atomic<bool>> &done)
+        {
+            while (done && !done->load(std::memory_order_acquire))
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        };
+        for (auto &[id, preparation] : preparing)
+            waitFor(preparation.done);
+        for (auto &r : retired)
+            waitFor(r.prepared);
     }
 
-    std::vector<AudioNodeBase *> AudioGraph::getNodesByType(const std::string &type) const
+    void AudioGraph::markDirty(int v)
     {
-        std::vector<AudioNodeBase *> result;
-        for (auto &[id, node] : nodes)
+        auto &flag = isDirty[static_cast<size_t>(v)];
+        if (!flag)
         {
-            if (node && node->nodeType == type)
-                result.push_back(node.get());
+            flag = 1;
+            dirtyVertices.push_back(v);
         }
-        return result;
     }
 
-    // ---------------------------------------------------------------------------
-    // Snapshot building (message thread)
-    // ---------------------------------------------------------------------------
-
-    void AudioGraph::rebuildAndPublishSnapshot()
+    void AudioGraph::markChainDirty(int v)
     {
-        // Determine which snapshot slot is NOT currently active
-        auto *current = activeSnapshot.load(std::memory_order_acquire);
-        GraphSnapshot *staging = (current == snapshotA.get()) ? snapshotB.get() : snapshotA.get();
+        const int tail = vertices[static_cast<size_t>(v)].fusedTail;
+        if (tail < 0)
+            return;
+        for (int u : vertices[static_cast<size_t>(tail)].fusedChain)
+            markDirty(u);
+    }
 
-        // Build the new snapshot in the staging slot
-        staging->connections = connections;
-        staging->outputNodeId = outputNodeId;
-        staging->inputNodeId = inputNodeId;
-        staging->inputNodeIds = inputNodeIds;
+    int AudioGraph::addVertex(const std::string &id, AudioNodeBase *node, int inputBus)
+    {
+        auto existing = vertexIds.find(id);
+        if (existing != vertexIds.end())
+        {
+            // Re-adding an ID swaps the node in place and keeps its connections
+            const int v = existing->second;
+            auto &vertex = vertices[static_cast<size_t>(v)];
+            vertex.node = node;
+            if (vertex.inputBus != inputBus)
+                feedbackEdits.push_back({v, v}); // it may now be a search root
+            vertex.inputBus = inputBus;
+            updateBatchable(v);
+            markDirty(v);
+            for (int e : vertex.outEdges)
+                markDirty(edges[static_cast<size_t>(e)].to);
+            return v;
+        }
 
-        // Build the node lookup map so the audio thread can find nodes
-        // without touching the authoritative `nodes` map (thread safety).
-        staging->nodeMap.clear();
-        for (auto &[id, node] : nodes)
+        const int v = order.addVertex();
+        if (v >= static_cast<int>(vertices.size()))
         {
-            if (node)
-                staging->nodeMap[id] = node.get();
+            vertices.resize(static_cast<size_t>(v) + 1);
+            isDirty.resize(static_cast<size_t>(v) + 1, 0);
         }
 
-        buildProcessingOrder(nodes, staging->connections, staging->processingOrder);
+        auto &vertex = vertices[static_cast<size_t>(v)];
+        vertex = Vertex{};
+        vertex.id = id;
+        vertex.node = node;
+        vertex.inputBus = inputBus;
+        vertexIds[id] = v;
+        verticesById.insert(std::lower_bound(verticesById.begin(), verticesById.end(), id, [this](int u, const std::string &key)
+                                             { return vertices[static_cast<size_t>(u)].id < key; }),
+                            v);
+        updateBatchable(v);
+        markDirty(v);
 
-        // Atomically publish — the audio thread will pick this up at the
-        // start of the next processBlock call.
-        activeSnapshot.store(staging, std::memory_order_release);
+        // Connections that arrived before this node did
+        if (!pendingConnections.empty())
+        {
+            std::vector<GraphSnapshot::Connection> waiting;
+            waiting.swap(pendingConnections);
+            for (auto &conn : waiting)
+                connect(conn);
+        }
+
+        return v;
     }
 
-    void AudioGraph::buildProcessingOrder(
-        const std::unordered_map<std::string, std::unique_ptr<AudioNodeBase>> &nodeMap,
-        const std::vector<GraphSnapshot::Connection> &conns,
-        std::vector<AudioNodeBase *> &outOrder)
+    void AudioGraph::removeVertex(int v)
     {
-        outOrder.clear();
+        auto &vertex = vertices[static_cast<size_t>(v)];
+        markChainDirty(v);
+
+        while (!vertex.inEdges.empty())
+            removeEdge(vertex.inEdges.back());
+        while (!vertex.outEdges.empty())
+            removeEdge(vertex.outEdges.back());
 
-        // Build adjacency info
-        std::unordered_map<std::string, int> inDegree;
-        std::unordered_map<std::string, std::vector<std::string>> adjacency;
+        // Its group is regrouped without it; the vertex is about to forget
+        // the group, so mark the members now
+        if (vertex.batchLeader >= 0)
+            for (int u : vertices[static_cast<size_t>(vertex.batchLeader)].batch)
+                markDirty(u);
+
+        order.removeVertex(v);
+        vertexIds.erase(vertex.id);
+        verticesById.erase(std::find(verticesById.begin(), verticesById.end(), v));
+        vertex = Vertex{};
+        updateBatchable(v);
+        markDirty(v);
+    }
 
-        for (auto &[id, _] : nodeMap)
+    void AudioGraph::connect(const GraphSnapshot::Connection &conn)
+    {
+        auto fromIt = vertexIds.find(conn.fromNodeId);
+        auto toIt = vertexIds.find(conn.toNodeId);
+        if (fromIt == vertexIds.end() || toIt == vertexIds.end())
         {
-            inDegree[id] = 0;
+            // A repeat replaces the waiting one (its gain may have changed)
+            auto waiting = std::find_if(pendingConnections.begin(), pendingConnections.end(),
+                                        [&](const GraphSnapshot::Connection &c)
+                                        { return sameConnection(c, conn); });
+            if (waiting != pendingConnections.end())
+                *waiting = conn;
+            else
+                pendingConnections.push_back(conn);
+            return;
         }
 
-        for (auto &conn : conns)
+        const int from = fromIt->second;
+        const int to = toIt->second;
+        const int toInlet = conn.toParam.empty() ? conn.toInlet : -1;
+
+        for (int e : vertices[static_cast<size_t>(from)].outEdges)
         {
-            if (nodeMap.count(conn.toNodeId) && nodeMap.count(conn.fromNodeId))
+            auto &edge = edges[static_cast<size_t>(e)];
+            if (edge.to == to && edge.fromOutlet == conn.fromOutlet && edge.toInlet == toInlet && edge.toParam == conn.toParam)
             {
-                inDegree[conn.toNodeId]++;
-                adjacency[conn.fromNodeId].push_back(conn.toNodeId);
+                // Already connected: only the gain and shaping can change
+                if (edge.gain != conn.gain || edge.offset != conn.offset || edge.curve != conn.curve)
+                {
+                    edge.gain = conn.gain;
+                    edge.offset = conn.offset;
+                    edge.curve = conn.curve;
+                    markDirty(from);
+                    markDirty(to);
+                }
+                return;
             }
         }
 
-        // Kahn's algorithm
-        std::queue<std::string> queue;
-        for (auto &[id, deg] : inDegree)
+        int e;
+        if (!freeEdges.empty())
         {
-            if (deg == 0)
-                queue.push(id);
+            e = freeEdges.back();
+            freeEdges.pop_back();
         }
-
-        while (!queue.empty())
+        else
         {
-            auto id = queue.front();
-            queue.pop();
+            e = static_cast<int>(edges.size());
+            edges.emplace_back();
+        }
 
-            auto it = nodeMap.find(id);
-            if (it != nodeMap.end() && it->second)
-            {
-                outOrder.push_back(it->second.get());
-            }
+        auto &edge = edges[static_cast<size_t>(e)];
+        edge = Edge{};
+        edge.from = from;
+        edge.fromOutlet = conn.fromOutlet;
+        edge.to = to;
+        edge.toInlet = toInlet;
+        edge.gain = conn.gain;
+        edge.toParam = conn.toParam;
+        edge.offset = conn.offset;
+        edge.curve = conn.curve;
+        edge.alive = true;
 
-            if (adjacency.count(id))
-            {
-                for (auto &neighbor : adjacency[id])
-                {
-                    inDegree[neighbor]--;
-                    if (inDegree[neighbor] == 0)
-                    {
-                        queue.push(neighbor);
-                    }
-                }
-            }
+        if (!order.addEdge(from, to))
+        {
+            // Closes a cycle: run it through a one-block delay instead,
+            // until the rebuild picks which of the cycle's edges to delay
+            edge.feedback = std::make_shared<FeedbackLine>();
+            edge.feedback->prepare(currentNumChannels, currentBlockSize);
+            ++numFeedbackEdges;
+            feedbackChanged = true;
         }
+        feedbackEdits.push_back({from, to});
+
+        auto &out = vertices[static_cast<size_t>(from)].outEdges;
+        out.insert(std::upper_bound(out.begin(), out.end(), e, [this](int a, int b)
+                                    { return edgeBefore(a, b); }),
+                   e);
+        vertices[static_cast<size_t>(to)].inEdges.push_back(e);
+        markDirty(from);
+        markDirty(to);
     }
 
-    // ---------------------------------------------------------------------------
-    // Apply pending param updates (audio thread)
-    // ---------------------------------------------------------------------------
+    bool AudioGraph::edgeBefore(int a, int b) const
+    {
+        const auto &ea = edges[static_cast<size_t>(a)];
+        const auto &eb = edges[static_cast<size_t>(b)];
+        return std::tie(vertices[static_cast<size_t>(ea.to)].id, ea.fromOutlet, ea.toInlet, ea.toParam) <
+               std::tie(vertices[static_cast<size_t>(eb.to)].id, eb.fromOutlet, eb.toInlet, eb.toParam);
+    }
 
-    void AudioGraph::applyPendingOps()
+    void AudioGraph::disconnect(const GraphSnapshot::Connection &conn)
     {
-        // Drain param-only ops from the SPSC queue.
-        // Use the snapshot's nodeMap for lookup instead of the authoritative
-        // `nodes` map, which is owned by the message thread.
-        auto *snapshot = activeSnapshot.load(std::memory_order_acquire);
+        pendingConnections.erase(
+            std::remove_if(pendingConnections.begin(), pendingConnections.end(),
+                           [&](const GraphSnapshot::Connection &c)
+                           { return sameConnection(c, conn); }),
+            pendingConnections.end());
+
+        auto fromIt = vertexIds.find(conn.fromNodeId);
+        auto toIt = vertexIds.find(conn.toNodeId);
+        if (fromIt == vertexIds.end() || toIt == vertexIds.end())
+            return;
 
-        GraphOp op;
-        while (paramOpQueue.pop(op))
+        const int toInlet = conn.toParam.empty() ? conn.toInlet : -1;
+        for (int e : vertices[static_cast<size_t>(fromIt->second)].outEdges)
         {
-            if (op.type == GraphOp::UpdateParams && snapshot)
+            auto &edge = edges[static_cast<size_t>(e)];
+            if (edge.to == toIt->second && edge.fromOutlet == conn.fromOutlet && edge.toInlet == toInlet && edge.toParam == conn.toParam)
             {
-                auto it = snapshot->nodeMap.find(op.nodeId);
-                if (it != snapshot->nodeMap.end() && it->second)
-                {
-                    for (auto &[k, v] : op.params)
-                    {
-                        it->second->setParam(k, v);
-                    }
-                }
+                removeEdge(e);
+                return;
             }
         }
     }
 
-    // ---------------------------------------------------------------------------
-    // Process (audio thread)
-    // ---------------------------------------------------------------------------
-
-    void AudioGraph::processBlock(juce::AudioBuffer<float> &buffer, juce::MidiBuffer &midi)
+    void AudioGraph::removeEdge(int e)
     {
-        hostInputBuffer = &buffer;
-        const int numSamples = buffer.getNumSamples();
+        auto &edge = edges[static_cast<size_t>(e)];
+        const int from = edge.from;
+        const int to = edge.to;
+        const bool wasFeedback = edge.feedback != nullptr;
 
-        // Apply any pending parameter updates (lock-free drain)
-        applyPendingOps();
+        auto erase = [e](std::vector<int> &list)
+        { list.erase(std::find(list.begin(), list.end(), e)); };
+        erase(vertices[static_cast<size_t>(from)].outEdges);
+        erase(vertices[static_cast<size_t>(to)].inEdges);
 
-        // Read the latest graph snapshot (atomic load)
-        auto *snapshot = activeSnapshot.load(std::memory_order_acquire);
-        if (!snapshot || snapshot->processingOrder.empty())
-            return;
+        if (wasFeedback)
+        {
+            --numFeedbackEdges;
+            feedbackChanged = true;
+        }
+        else
+        {
+            order.removeEdge(from, to);
+        }
 
-        // Reset buffer pool
-        std::fill(bufferInUse.begin(), bufferInUse.end(), false);
+        markDirty(from);
+        markDirty(to);
+        edge = Edge{};
+        freeEdges.push_back(e);
+        feedbackEdits.push_back({from, to}); // may have broken the loop behind a feedback edge
+    }
+
+    void AudioGraph::selectFeedbackEdges()
+    {
+        // Edits close cycles on whichever connection comes last, so the
+        // feedback edges are picked again here by user-028's rule, within
+        // each strongly connected component: the back edges of a
+        // depth-first search from the component's host input, else from
+        // where it is entered, else from its first vertex by ID. Out-edges
+        // are visited in ID order, so the edge pointing back toward the
+        // input is the one delayed whatever order the connections were
+        // made in.
+        //
+        // Only components an edit can have changed are searched. A cycle
+        // closed or broken by an edge runs from its target back to its
+        // source, and a component an edge enters holds its target, so the
+        // search covers what is reachable from a changed edge's target and
+        // leads back to one of its ends. Every other component keeps its
+        // feedback edges.
+        constexpr char upstream = 1, inRegion = 2;
+        searchMarks.resize(vertices.size(), 0);
+        searchSlots.resize(vertices.size(), -1);
 
-        // Build a map of nodeId -> output BufferRef
-        std::unordered_map<std::string, BufferRef> nodeOutputs;
+        std::vector<int> reachesEdit, region;
+        auto mark = [this](int v, char flag, std::vector<int> &list)
+        {
+            if ((searchMarks[static_cast<size_t>(v)] & flag) == 0)
+            {
+                searchMarks[static_cast<size_t>(v)] |= flag;
+                list.push_back(v);
+            }
+        };
 
-        // The main input node's output is the host buffer itself
-        if (!snapshot->inputNodeId.empty())
+        for (auto [from, to] : feedbackEdits)
         {
-            nodeOutputs[snapshot->inputNodeId] = {&buffer, -1};
+            mark(from, upstream, reachesEdit);
+            mark(to, upstream, reachesEdit);
         }
+        for (size_t i = 0; i < reachesEdit.size(); ++i)
+            for (int e : vertices[static_cast<size_t>(reachesEdit[i])].inEdges)
+                mark(edges[static_cast<size_t>(e)].from, upstream, reachesEdit);
 
-        // Wire up additional input buses (sidechain, etc.)
-        for (auto &[busIdx, nodeId] : snapshot->inputNodeIds)
+        for (auto [from, to] : feedbackEdits)
+            mark(to, inRegion, region);
+        for (size_t i = 0; i < region.size(); ++i)
         {
-            if (busIdx == 0)
-                continue; // already handled above
-            auto bufIt = hostInputBuffers.find(busIdx);
-            if (bufIt != hostInputBuffers.end() && bufIt->second)
+            searchSlots[static_cast<size_t>(region[i])] = static_cast<int>(i);
+            for (int e : vertices[static_cast<size_t>(region[i])].outEdges)
             {
-                nodeOutputs[nodeId] = {bufIt->second, -1};
+                const int w = edges[static_cast<size_t>(e)].to;
+                if (searchMarks[static_cast<size_t>(w)] & upstream)
+                    mark(w, inRegion, region);
             }
         }
+        feedbackEdits.clear();
+
+        // The region's components, by iterative Tarjan over its own edges.
+        // Any path between two of its vertices stays inside it, so these
+        // are the components of the whole graph.
+        const size_t numSlots = region.size();
+        auto slotOf = [this](int v)
+        { return searchSlots[static_cast<size_t>(v)]; };
 
-        for (auto *node : snapshot->processingOrder)
+        std::vector<int> index(numSlots, -1);
+        std::vector<int> lowLink(numSlots, 0);
+        std::vector<int> component(numSlots, -1);
+        std::vector<char> onStack(numSlots, 0);
+        std::vector<int> sccStack;
+        std::vector<std::pair<int, size_t>> callStack; // slot, next out-edge
+        int nextIndex = 0;
+        int numComponents = 0;
+
+        for (int root = 0; root < static_cast<int>(numSlots); ++root)
         {
-            // Skip all input nodes — their output is the host buffer
-            bool isInputNode = false;
-            for (auto &[busIdx, inId] : snapshot->inputNodeIds)
-            {
-                if (node->nodeId == inId)
-                {
-                    isInputNode = true;
-                    break;
-                }
-            }
-            if (isInputNode)
+            if (index[static_cast<size_t>(root)] >= 0)
                 continue;
 
-            // Acquire an output buffer for this node
-            int bufIdx = acquireBuffer();
-            node->outputBuffer = {&bufferPool[bufIdx], bufIdx};
-            nodeOutputs[node->nodeId] = node->outputBuffer;
-
-            // Wire up input buffers from connections
-            node->inputBuffers.clear();
+            callStack.push_back({root, 0});
+            index[static_cast<size_t>(root)] = lowLink[static_cast<size_t>(root)] = nextIndex++;
+            sccStack.push_back(root);
+            onStack[static_cast<size_t>(root)] = 1;
 
-            // Find connections to this node, sorted by inlet
-            std::vector<std::pair<int, BufferRef>> inputs;
-            for (auto &conn : snapshot->connections)
+            while (!callStack.empty())
             {
-                if (conn.toNodeId == node->nodeId)
+                auto &[i, next] = callStack.back();
+                const auto &out = vertices[static_cast<size_t>(region[static_cast<size_t>(i)])].outEdges;
+
+                if (next < out.size())
                 {
-                    auto outIt = nodeOutputs.find(conn.fromNodeId);
-                    if (outIt != nodeOutputs.end())
+                    const int j = slotOf(edges[static_cast<size_t>(out[next++])].to);
+                    if (j < 0)
+                        continue;
+
+                    const auto ji = static_cast<size_t>(j);
+                    if (index[ji] < 0)
                     {
-                        inputs.push_back({conn.toInlet, outIt->second});
+                        index[ji] = lowLink[ji] = nextIndex++;
+                        sccStack.push_back(j);
+                        onStack[ji] = 1;
+                        callStack.push_back({j, 0});
                     }
+                    else if (onStack[ji])
+                    {
+                        lowLink[static_cast<size_t>(i)] = std::min(lowLink[static_cast<size_t>(i)], index[ji]);
+                    }
+                    continue;
                 }
-            }
-            std::sort(inputs.begin(), inputs.end(),
-                      [](const auto &a, const auto &b)
-                      { return a.first < b.first; });
 
-            for (auto &[inlet, ref] : inputs)
-            {
-                while (static_cast<int>(node->inputBuffers.size()) <= inlet)
+                const int done = i;
+                callStack.pop_back();
+                if (!callStack.empty())
                 {
-                    node->inputBuffers.push_back({});
+                    const auto parent = static_cast<size_t>(callStack.back().first);
+                    lowLink[parent] = std::min(lowLink[parent], lowLink[static_cast<size_t>(done)]);
                 }
-                node->inputBuffers[inlet] = ref;
-            }
-
-            // Provide the MIDI buffer to MidiInputNode instances
-            if (auto *midiNode = dynamic_cast<MidiInputNode *>(node))
-            {
-                midiNode->midiBuffer = &midi;
-            }
 
-            // Process
-            if (node->isBypassed())
-            {
-                node->processBypass(numSamples);
-            }
-            else
-            {
-                node->process(numSamples);
+                if (lowLink[static_cast<size_t>(done)] == index[static_cast<size_t>(done)])
+                {
+                    int j;
+                    do
+                    {
+                        j = sccStack.back();
+                        sccStack.pop_back();
+                        onStack[static_cast<size_t>(j)] = 0;
+                        component[static_cast<size_t>(j)] = numComponents;
+                    } while (j != done);
+                    ++numComponents;
+                }
             }
         }
 
-        // Copy the output node's buffer back to the host buffer
-        if (!snapshot->outputNodeId.empty())
+        std::vector<std::vector<int>> members(static_cast<size_t>(numComponents));
+        for (size_t i = 0; i < numSlots; ++i)
+            members[static_cast<size_t>(component[i])].push_back(region[i]);
+
+        // Search each component from its root; its back edges are delayed
+        std::vector<int> wanted;
+        std::vector<char> state(numSlots, 0); // 1 = on the search path, 2 = finished
+        for (size_t c = 0; c < members.size(); ++c)
         {
-            auto outIt = nodeOutputs.find(snapshot->outputNodeId);
-            if (outIt != nodeOutputs.end() && outIt->second.isValid())
+            auto &inside = members[c];
+            std::sort(inside.begin(), inside.end(), [this](int a, int b)
+                      { return vertices[static_cast<size_t>(a)].id < vertices[static_cast<size_t>(b)].id; });
+
+            auto enteredFromOutside = [&](int v)
             {
-                auto &outBuf = *outIt->second.buffer;
-                for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                for (int e : vertices[static_cast<size_t>(v)].inEdges)
                 {
-                    if (ch < outBuf.getNumChannels())
-                    {
-                        buffer.copyFrom(ch, 0, outBuf, ch, 0, numSamples);
-                    }
+                    const int from = slotOf(edges[static_cast<size_t>(e)].from);
+                    if (from < 0 || component[static_cast<size_t>(from)] != static_cast<int>(c))
+                        return true;
                 }
-            }
-        }
+                return false;
+            };
+            auto root = std::find_if(inside.begin(), inside.end(), [this](int v)
+                                     { return vertices[static_cast<size_t>(v)].inputBus >= 0; });
+            if (root == inside.end())
+                root = std::find_if(inside.begin(), inside.end(), enteredFromOutside);
+            if (root == inside.end())
+                root = inside.begin();
 
-        hostInputBuffer = nullptr;
+            callStack.push_back({slotOf(*root), 0});
+            state[static_cast<size_t>(slotOf(*root))] = 1;
+            while (!callStack.empty())
+            {
+                auto &[i, next] = callStack.back();
+                const auto &out = vertices[static_cast<size_t>(region[static_cast<size_t>(i)])].outEdges;
+                if (next < out.size())
+                {
+                    const int e = out[next++];
+                    const int j = slotOf(edges[static_cast<size_t>(e)].to);
+                    if (j < 0 || component[static_cast<size_t>(j)] != static_cast<int>(c))
+                        continue;
+
+                    if (state[static_cast<size_t>(j)] == 1)
+                    {
+                        wanted.push_back(e);
+                    }
+                    else if (state[static_cast<size_t>(j)] == 0)
+                    {
+                        state[static_cast<size_t>(j)] = 1;
+                        callStack.push_back({j, 0});
+                    }
+                    continue;
+                }
+
+                state[static_cast<size_t>(i)] = 2;
+                callStack.pop_back();
+            }
+        }
+        std::sort(wanted.begin(), wanted.end());
+
+        // Newly delayed edges leave the order first, so every edge that
+        // stops being feedback can then be added without closing a cycle.
+        // An edge out of the region joins no component of it, and an edge
+        // into it from outside is in no changed component.
+        auto isWanted = [&wanted](int e)
+        { return std::binary_search(wanted.begin(), wanted.end(), e); };
+
+        for (int e : wanted)
+        {
+            auto &edge = edges[static_cast<size_t>(e)];
+            if (edge.feedback)
+                continue;
+
+            order.removeEdge(edge.from, edge.to);
+            edge.feedback = std::make_shared<FeedbackLine>();
+            edge.feedback->prepare(currentNumChannels, currentBlockSize);
+            ++numFeedbackEdges;
+            feedbackChanged = true;
+            markDirty(edge.from);
+            markDirty(edge.to);
+        }
+
+        for (int v : region)
+        {
+            for (int e : vertices[static_cast<size_t>(v)].outEdges)
+            {
+                auto &edge = edges[static_cast<size_t>(e)];
+                if (!edge.feedback || isWanted(e))
+                    continue;
+
+                [[maybe_unused]] const bool added = order.addEdge(edge.from, edge.to);
+                jassert(added);
+                edge.feedback.reset();
+                --numFeedbackEdges;
+                feedbackChanged = true;
+                markDirty(edge.from);
+                markDirty(edge.to);
+            }
+        }
+
+        for (int v : reachesEdit)
+        {
+            searchMarks[static_cast<size_t>(v)] = 0;
+            searchSlots[static_cast<size_t>(v)] = -1;
+        }
+    }
+
+    GraphSnapshot::Connection AudioGraph::describe(const Edge &edge) const
+    {
+        return {vertices[static_cast<size_t>(edge.from)].id, edge.fromOutlet,
+                vertices[static_cast<size_t>(edge.to)].id, std::max(0, edge.toInlet), edge.gain,
+                edge.toParam, edge.offset, edge.curve};
+    }
+
+    void AudioGraph::queueOp(GraphOp op)
+    {
+        // UpdateParams go through the mailbox — the audio thread applies
+        // the latest value of each changed param at the top of its block.
+        if (op.type == GraphOp::UpdateParams)
+        {
+            postParams(op);
+            return;
+        }
+
+        // Topology changes are applied immediately on the message thread
+        // to the authoritative state, then a new snapshot is built and
+        // published atomically for the audio thread.
+        applyTopologyOp(op);
+        rebuildAndPublishSnapshot();
+    }
+
+    void AudioGraph::queueOps(std::vector<GraphOp> ops)
+    {
+        bool topologyChanged = false;
+
+        for (auto &op : ops)
+        {
+            if (op.type == GraphOp::UpdateParams)
+            {
+                postParams(op);
+            }
+            else
+            {
+                applyTopologyOp(op);
+                topologyChanged = true;
+            }
+        }
+
+        // Rebuild the snapshot only once after all ops are applied,
+        // so the audio thread never sees an intermediate state.
+        if (topologyChanged)
+        {
+            rebuildAndPublishSnapshot();
+        }
+    }
+
+    std::vector<GraphOp> AudioGraph::describeGraph() const
+    {
+        std::vector<GraphOp> ops;
+
+        for (auto &vertex : vertices)
+        {
+            if (vertex.id.empty())
+                continue;
+
+            GraphOp op;
+            op.type = GraphOp::AddNode;
+            op.nodeId = vertex.id;
+            if (vertex.node != nullptr)
+            {
+                // The vertex may be running a placeholder; the node is here
+                auto &node = nodes.at(vertex.id);
+                op.nodeType = node->nodeType;
+                op.params = node->getParamValues();
+            }
+            else
+            {
+                op.nodeType = "input";
+                op.params["channel"] = static_cast<float>(vertex.inputBus);
+            }
+            ops.push_back(std::move(op));
+        }
+
+        auto addConnect = [&ops](const GraphSnapshot::Connection &conn)
+        {
+            GraphOp op;
+            op.type = GraphOp::Connect;
+            op.fromNodeId = conn.fromNodeId;
+            op.fromOutlet = conn.fromOutlet;
+            op.toNodeId = conn.toNodeId;
+            op.toInlet = conn.toInlet;
+            op.gain = conn.gain;
+            op.toParam = conn.toParam;
+            op.offset = conn.offset;
+            op.curve = conn.curve;
+            ops.push_back(std::move(op));
+        };
+
+        // Per node in connection order, so summed inlets add up their
+        // sources in the same order after a rebuild. Feedback edges come
+        // last: each then closes its cycle as it's restored, so the edges
+        // delayed are the ones delayed here from the first block.
+        for (auto &vertex : vertices)
+            for (int e : vertex.inEdges)
+                if (!edges[static_cast<size_t>(e)].feedback)
+                    addConnect(describe(edges[static_cast<size_t>(e)]));
+        for (auto &vertex : vertices)
+            for (int e : vertex.inEdges)
+                if (edges[static_cast<size_t>(e)].feedback)
+                    addConnect(describe(edges[static_cast<size_t>(e)]));
+        for (auto &conn : pendingConnections)
+            addConnect(conn);
+
+        if (!outputNodeId.empty())
+        {
+            GraphOp op;
+            op.type = GraphOp::SetOutput;
+            op.nodeId = outputNodeId;
+            ops.push_back(std::move(op));
+        }
+
+        return ops;
+    }
+
+    void AudioGraph::setGraph(const std::vector<GraphOp> &desired)
+    {
+        // Identity of a connection, ignoring its gain and shaping
+        auto keyOf = [](const std::string &from, int outlet, const std::string &to, int inlet, const std::string &param)
+        {
+            return from + '\n' + std::to_string(outlet) + '\n' + to + '\n' +
+                   (param.empty() ? std::to_string(inlet) : "." + param);
+        };
+
+        std::unordered_map<std::string, const GraphOp *> wantedNodes;
+        std::unordered_map<std::string, const GraphOp *> wantedConnections;
+        std::string wantedOutput;
+        for (auto &op : desired)
+        {
+            if (op.type == GraphOp::AddNode)
+                wantedNodes[op.nodeId] = &op;
+            else if (op.type == GraphOp::Connect)
+                wantedConnections[keyOf(op.fromNodeId, op.fromOutlet, op.toNodeId, op.toInlet, op.toParam)] = &op;
+            else if (op.type == GraphOp::SetOutput)
+                wantedOutput = op.nodeId;
+        }
+
+        std::vector<GraphOp> topology;
+
+        // Connections that go away (or whose ends do)
+        std::unordered_map<std::string, GraphSnapshot::Connection> current;
+        for (auto &vertex : vertices)
+            for (int e : vertex.inEdges)
+            {
+                auto conn = describe(edges[static_cast<size_t>(e)]);
+                current.emplace(keyOf(conn.fromNodeId, conn.fromOutlet, conn.toNodeId, conn.toInlet, conn.toParam), conn);
+            }
+        for (auto &conn : pendingConnections)
+            current.emplace(keyOf(conn.fromNodeId, conn.fromOutlet, conn.toNodeId, conn.toInlet, conn.toParam), conn);
+
+        for (auto &[key, conn] : current)
+        {
+            if (wantedConnections.count(key))
+                continue;
+            GraphOp op;
+            op.type = GraphOp::Disconnect;
+            op.fromNodeId = conn.fromNodeId;
+            op.fromOutlet = conn.fromOutlet;
+            op.toNodeId = conn.toNodeId;
+            op.toInlet = conn.toInlet;
+            op.toParam = conn.toParam;
+            topology.push_back(std::move(op));
+        }
+
+        for (auto &[id, v] : vertexIds)
+        {
+            if (wantedNodes.count(id))
+                continue;
+            GraphOp op;
+            op.type = GraphOp::RemoveNode;
+            op.nodeId = id;
+            topology.push_back(std::move(op));
+        }
+
+        // Nodes: same ID and type are kept, anything else is (re)created
+        for (auto &op : desired)
+        {
+            if (op.type != GraphOp::AddNode)
+                continue;
+
+            auto it = vertexIds.find(op.nodeId);
+            if (it != vertexIds.end())
+            {
+                auto &vertex = vertices[static_cast<size_t>(it->second)];
+                auto *node = getNode(op.nodeId); // the vertex may run a placeholder
+                if (node != nullptr && node->nodeType == op.nodeType)
+                {
+                    postParams(op);
+                    continue;
+                }
+                if (vertex.node == nullptr && op.nodeType == "input")
+                {
+                    auto channel = op.params.find("channel");
+                    if (vertex.inputBus == (channel != op.params.end() ? static_cast<int>(channel->second) : 0))
+                        continue;
+                }
+            }
+            topology.push_back(op);
+        }
+
+        // Connections that are new, or whose gain or shaping changed
+        for (auto &op : desired)
+        {
+            if (op.type != GraphOp::Connect)
+                continue;
+            auto it = current.find(keyOf(op.fromNodeId, op.fromOutlet, op.toNodeId, op.toInlet, op.toParam));
+            if (it != current.end() && it->second.gain == op.gain &&
+                it->second.offset == op.offset && it->second.curve == op.curve)
+                continue;
+            topology.push_back(op);
+        }
+
+        if (wantedOutput != outputNodeId)
+        {
+            GraphOp op;
+            op.type = GraphOp::SetOutput;
+            op.nodeId = wantedOutput;
+            topology.push_back(std::move(op));
+        }
+
+        if (topology.empty())
+            return;
+
+        for (auto &op : topology)
+            applyTopologyOp(op);
+        rebuildAndPublishSnapshot();
+    }
+
+    void AudioGraph::setHostInputBuffer(int busIndex, juce::AudioBuffer<float> *buffer)
+    {
+        hostInputBuffers[busIndex].buffer = buffer;
+    }
+
+    void AudioGraph::setNodeParam(const std::string &nodeId, const std::string &param, float value)
+    {
+        // Message-thread only — safe to access the authoritative `nodes` map.
+        // The mailbox is lock-free, so the audio thread picks up the
+        // newest value on its next block.
+        if (auto *handle = getParamHandle(nodeId, param))
+            paramMailbox.post(*handle, value);
+    }
+
+    void AudioGraph::postParams(const GraphOp &op)
+    {
+        auto it = nodes.find(op.nodeId);
+        if (it == nodes.end() || !it->second)
+            return;
+
+        for (auto &[k, v] : op.params)
+        {
+            if (auto *handle = it->second->getMailboxSlot(k))
+                paramMailbox.post(*handle, v);
+        }
+    }
+
+    ParamMailbox::Slot *AudioGraph::getParamHandle(const std::string &nodeId, const std::string &param)
+    {
+        auto it = nodes.find(nodeId);
+        if (it == nodes.end() || !it->second)
+            return nullptr;
+        return it->second->getMailboxSlot(param);
+    }
+
+    // ---------------------------------------------------------------------------
+    // Host parameter bindings (message thread)
+    // ---------------------------------------------------------------------------
+
+    void AudioGraph::bindHostParam(const std::string &nodeId, const std::string &param,
+                                   const std::atomic<float> *source, ParamRange range)
+    {
+        if (source == nullptr)
+            return;
+
+        auto it = std::find_if(hostBindings.begin(), hostBindings.end(), [&](const HostBindingSpec &b)
+                               { return b.nodeId == nodeId && b.param == param; });
+        if (it != hostBindings.end())
+        {
+            it->source = source;
+            it->range = range;
+        }
+        else
+        {
+            hostBindings.push_back({nodeId, param, source, range});
+        }
+        rebuildAndPublishSnapshot();
+    }
+
+    void AudioGraph::unbindHostParam(const std::string &nodeId, const std::string &param)
+    {
+        auto end = std::remove_if(hostBindings.begin(), hostBindings.end(), [&](const HostBindingSpec &b)
+                                  { return b.nodeId == nodeId && b.param == param; });
+        if (end == hostBindings.end())
+            return;
+        hostBindings.erase(end, hostBindings.end());
+        rebuildAndPublishSnapshot();
+    }
+
+    void AudioGraph::unbindHostSource(const std::atomic<float> *source)
+    {
+        auto end = std::remove_if(hostBindings.begin(), hostBindings.end(), [&](const HostBindingSpec &b)
+                                  { return b.source == source; });
+        if (end == hostBindings.end())
+            return;
+        hostBindings.erase(end, hostBindings.end());
+        rebuildAndPublishSnapshot();
+    }
+
+    std::vector<GraphSnapshot::HostBinding> AudioGraph::resolveHostBindings() const
+    {
+        // Bindings whose node doesn't exist (yet) are skipped; they resolve
+        // on the rebuild that adds it
+        std::vector<GraphSnapshot::HostBinding> resolved;
+        resolved.reserve(hostBindings.size());
+        for (auto &binding : hostBindings)
+        {
+            auto it = nodes.find(binding.nodeId);
+            if (it == nodes.end() || !it->second)
+                continue;
+            if (auto *storage = it->second->getParamStorage(binding.param))
+                resolved.push_back({binding.source, binding.range, storage});
+        }
+        return resolved;
+    }
+
+    AudioNodeBase *AudioGraph::getNode(const std::string &nodeId) const
+    {
+        auto it = nodes.find(nodeId);
+        if (it != nodes.end())
+            return it->second.get();
+        return nullptr;
+    }
+
+    std::vector<AudioNodeBase *> AudioGraph::getNodesByType(const std::string &type) const
+    {
+        std::vector<AudioNodeBase *> result;
+        for (auto &[id, node] : nodes)
+        {
+            if (node && node->nodeType == type)
+                result.push_back(node.get());
+        }
+        return result;
+    }
+
+    // ---------------------------------------------------------------------------
+    // Snapshot building (message thread)
+    // ---------------------------------------------------------------------------
+
+    GraphSnapshot::Source AudioGraph::resolveSource(int v) const
+    {
+        GraphSnapshot::Source source;
+        auto &vertex = vertices[static_cast<size_t>(v)];
+        if (vertex.node != nullptr)
+        {
+            source.kind = GraphSnapshot::Source::Node;
+            source.node = vertex.node;
+        }
+        else if (vertex.inputBus >= 0)
+        {
+            source.kind = GraphSnapshot::Source::HostInput;
+            source.bus = vertex.inputBus;
+        }
+        return source;
+    }
+
+    std::vector<std::vector<GraphSnapshot::Source>> AudioGraph::collectSources(const Vertex &vertex) const
+    {
+        // Group sources by inlet, in connection order
+        std::vector<std::vector<GraphSnapshot::Source>> byInlet;
+        for (int e : vertex.inEdges)
+        {
+            auto &edge = edges[static_cast<size_t>(e)];
+            if (edge.toInlet < 0)
+                continue; // drives a parameter
+            auto source = resolveSource(edge.from);
+            source.fromOutlet = edge.fromOutlet;
+            source.gain = edge.gain;
+            if (edge.feedback)
+            {
+                source.kind = GraphSnapshot::Source::Feedback;
+                source.line = edge.feedback.get();
+            }
+
+            if (static_cast<int>(byInlet.size()) <= edge.toInlet)
+                byInlet.resize(static_cast<size_t>(edge.toInlet) + 1);
+            byInlet[static_cast<size_t>(edge.toInlet)].push_back(source);
+        }
+        return byInlet;
+    }
+
+    std::vector<GraphSnapshot::Modulation> AudioGraph::collectModulations(const Vertex &vertex) const
+    {
+        // Group parameter connections by parameter, in connection order.
+        // A parameter the node doesn't have is ignored.
+        std::vector<GraphSnapshot::Modulation> modulations;
+        for (int e : vertex.inEdges)
+        {
+            auto &edge = edges[static_cast<size_t>(e)];
+            if (edge.toInlet >= 0)
+                continue;
+            auto **slot = vertex.node->getModulationSlot(edge.toParam);
+            if (slot == nullptr)
+                continue;
+
+            GraphSnapshot::ModulationSource mod;
+            mod.source = resolveSource(edge.from);
+            mod.source.fromOutlet = edge.fromOutlet;
+            mod.source.gain = edge.gain;
+            if (edge.feedback)
+            {
+                mod.source.kind = GraphSnapshot::Source::Feedback;
+                mod.source.line = edge.feedback.get();
+            }
+            mod.offset = edge.offset;
+            mod.curve = edge.curve;
+
+            auto it = std::find_if(modulations.begin(), modulations.end(), [slot](const GraphSnapshot::Modulation &m)
+                                   { return m.slot == slot; });
+            if (it == modulations.end())
+                it = modulations.insert(modulations.end(), GraphSnapshot::Modulation{slot, {}});
+            it->sources.push_back(mod);
+        }
+        return modulations;
+    }
+
+    bool AudioGraph::isModulated(int v) const
+    {
+        for (int e : vertices[static_cast<size_t>(v)].inEdges)
+            if (edges[static_cast<size_t>(e)].toInlet < 0)
+                return true;
+        return false;
+    }
+
+    std::shared_ptr<const GraphSnapshot::NodeEntry> AudioGraph::buildEntry(const Vertex &vertex) const
+    {
+        auto entry = std::make_shared<GraphSnapshot::NodeEntry>();
+        entry->node = vertex.node;
+        entry->numChannels = vertex.numChannels;
+        entry->midiInput = dynamic_cast<MidiInputNode *>(vertex.node);
+
+        auto byInlet = collectSources(vertex);
+
+        // A lone unity-gain source is read in place; anything else is summed
+        entry->inputs.resize(byInlet.size());
+        for (size_t inlet = 0; inlet < byInlet.size(); ++inlet)
+        {
+            auto &sources = byInlet[inlet];
+            if (sources.size() == 1 && sources[0].gain == 1.0f)
+                entry->inputs[inlet] = sources[0];
+            else if (!sources.empty())
+                entry->junctions.push_back({static_cast<int>(inlet), std::move(sources)});
+        }
+
+        for (int e : vertex.outEdges)
+        {
+            auto &edge = edges[static_cast<size_t>(e)];
+            if (edge.feedback)
+                entry->feedbackWrites.push_back({edge.feedback.get(), edge.fromOutlet});
+        }
+
+        entry->modulations = collectModulations(vertex);
+
+        if (!vertex.fusedChain.empty())
+        {
+            for (size_t i = 0; i + 1 < vertex.fusedChain.size(); ++i)
+                entry->fusedStages.push_back(vertices[static_cast<size_t>(vertex.fusedChain[i])].node);
+
+            auto headSources = collectSources(vertices[static_cast<size_t>(vertex.fusedChain.front())]);
+            if (!headSources.empty())
+                entry->fusedInput.sources = std::move(headSources[0]);
+        }
+
+        entry->batched = vertex.batchLeader >= 0 && vertex.batch.empty();
+        for (size_t i = 1; i < vertex.batch.size(); ++i)
+            entry->batch.push_back(vertices[static_cast<size_t>(vertex.batch[i])].entry);
+
+        // What processSubBlock() acquires for it: wire() takes one buffer
+        // per outlet, junction and modulation, and may broadcast each
+        // inlet; a fused chain takes its input sum and broadcast, its
+        // output, and one per member when it runs unfused
+        auto wired = [](const GraphSnapshot::NodeEntry &e)
+        {
+            return e.node->getNumOutlets() + static_cast<int>(e.junctions.size() + e.modulations.size()) +
+                   (e.numChannels > 1 ? static_cast<int>(e.inputs.size()) : 0);
+        };
+        if (entry->batched)
+            entry->numBuffers = 0;
+        else if (!entry->fusedStages.empty())
+            entry->numBuffers = 3 + static_cast<int>(entry->fusedStages.size());
+        else
+        {
+            entry->numBuffers = wired(*entry);
+            for (auto &member : entry->batch)
+                entry->numBuffers += wired(*member);
+        }
+
+        return entry;
+    }
+
+    void AudioGraph::updateChannelCounts()
+    {
+        // Widths flow downstream: visit dirty vertices in order, and pull
+        // in the consumers of any whose width changed. Feedback lines and
+        // host inputs run at the full layout.
+        std::vector<char> queued(vertices.size(), 0);
+        std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>> pending;
+        auto enqueue = [&](int v)
+        {
+            if (!queued[static_cast<size_t>(v)] && !vertices[static_cast<size_t>(v)].id.empty())
+            {
+                queued[static_cast<size_t>(v)] = 1;
+                pending.push({order.getPosition(v), v});
+            }
+        };
+        for (int v : dirtyVertices)
+            enqueue(v);
+
+        while (!pending.empty())
+        {
+            const int v = pending.top().second;
+            pending.pop();
+            auto &vertex = vertices[static_cast<size_t>(v)];
+
+            int numChannels = currentNumChannels;
+            if (vertex.node != nullptr)
+            {
+                int inputChannels = 0;
+                for (int e : vertex.inEdges)
+                {
+                    auto &edge = edges[static_cast<size_t>(e)];
+                    if (edge.toInlet == 0)
+                        inputChannels = std::max(inputChannels, edge.feedback ? currentNumChannels : vertices[static_cast<size_t>(edge.from)].numChannels);
+                }
+                if (inputChannels == 0)
+                    inputChannels = currentNumChannels;
+                numChannels = juce::jlimit(1, currentNumChannels, vertex.node->getNumOutputChannels(inputChannels));
+            }
+
+            if (numChannels == vertex.numChannels)
+                continue;
+
+            vertex.numChannels = numChannels;
+            markDirty(v);
+            for (int e : vertex.outEdges)
+            {
+                auto &edge = edges[static_cast<size_t>(e)];
+                if (!edge.feedback)
+                {
+                    markDirty(edge.to);
+                    enqueue(edge.to);
+                }
+            }
+        }
+    }
+
+    bool AudioGraph::canFuse(int v) const
+    {
+        auto &vertex = vertices[static_cast<size_t>(v)];
+        if (vertex.node == nullptr || !vertex.node->isFusible() || vertex.node->getNumOutlets() != 1)
+            return false;
+
+        for (int e : vertex.inEdges)
+            if (edges[static_cast<size_t>(e)].toInlet != 0)
+                return false;
+        return true;
+    }
+
+    int AudioGraph::fusedSuccessor(int v) const
+    {
+        // v's output may only be read by the next member, through a plain
+        // unity-gain connection the next member reads alone
+        auto &vertex = vertices[static_cast<size_t>(v)];
+        if (!canFuse(v) || vertex.outEdges.size() != 1 || vertex.id == outputNodeId)
+            return -1;
+
+        auto &edge = edges[static_cast<size_t>(vertex.outEdges[0])];
+        if (edge.feedback || edge.fromOutlet != 0 || edge.toInlet != 0 || edge.gain != 1.0f)
+            return -1;
+
+        const int next = edge.to;
+        auto &nextVertex = vertices[static_cast<size_t>(next)];
+        if (!canFuse(next) || nextVertex.inEdges.size() != 1 || nextVertex.numChannels != vertex.numChannels)
+            return -1;
+        return next;
+    }
+
+    int AudioGraph::fusedPredecessor(int v) const
+    {
+        auto &vertex = vertices[static_cast<size_t>(v)];
+        if (vertex.inEdges.size() != 1)
+            return -1;
+
+        const int prev = edges[static_cast<size_t>(vertex.inEdges[0])].from;
+        return fusedSuccessor(prev) == v ? prev : -1;
+    }
+
+    void AudioGraph::updateFusedChains()
+    {
+        // An edit can split, extend or merge the chains around it, so every
+        // member of a dirty vertex's old and new chain is rebuilt too. The
+        // list grows while it is walked until it is closed.
+        for (size_t i = 0; i < dirtyVertices.size(); ++i)
+        {
+            const int v = dirtyVertices[i];
+            markChainDirty(v);
+            if (vertices[static_cast<size_t>(v)].id.empty())
+                continue;
+
+            for (int u = fusedPredecessor(v); u >= 0; u = fusedPredecessor(u))
+                markDirty(u);
+            for (int u = fusedSuccessor(v); u >= 0; u = fusedSuccessor(u))
+                markDirty(u);
+        }
+
+        for (int v : dirtyVertices)
+        {
+            auto &vertex = vertices[static_cast<size_t>(v)];
+            vertex.fusedTail = -1;
+            vertex.fusedChain.clear();
+        }
+
+        for (int v : dirtyVertices)
+        {
+            if (vertices[static_cast<size_t>(v)].id.empty() || fusedPredecessor(v) >= 0 || fusedSuccessor(v) < 0)
+                continue; // not the first of two or more
+
+            std::vector<int> chain{v};
+            for (int u = fusedSuccessor(v); u >= 0; u = fusedSuccessor(u))
+                chain.push_back(u);
+
+            for (int u : chain)
+                vertices[static_cast<size_t>(u)].fusedTail = chain.back();
+            vertices[static_cast<size_t>(chain.back())].fusedChain = std::move(chain);
+        }
+    }
+
+    void AudioGraph::updateBatchable(int v)
+    {
+        auto *node = vertices[static_cast<size_t>(v)].node;
+        const bool batchable = node != nullptr && node->isBatchable();
+        auto it = std::find(batchableVertices.begin(), batchableVertices.end(), v);
+
+        if (batchable && it == batchableVertices.end())
+        {
+            batchableVertices.push_back(v);
+        }
+        else if (!batchable && it != batchableVertices.end())
+        {
+            *it = batchableVertices.back();
+            batchableVertices.pop_back();
+        }
+    }
+
+    int AudioGraph::readyPosition(int v) const
+    {
+        // The latest place in the order at which one of v's inputs is
+        // produced. Fused members produce theirs where the chain runs;
+        // feedback lines are read before anything runs.
+        int ready = -1;
+        for (int e : vertices[static_cast<size_t>(v)].inEdges)
+        {
+            auto &edge = edges[static_cast<size_t>(e)];
+            if (edge.feedback)
+                continue;
+            const int tail = vertices[static_cast<size_t>(edge.from)].fusedTail;
+            ready = std::max(ready, order.getPosition(tail >= 0 ? tail : edge.from));
+        }
+        return ready;
+    }
+
+    void AudioGraph::updateBatches(const std::vector<int> &movedPositions, bool allMoved)
+    {
+        // Walk batchable vertices in order and grow one open group per node
+        // type. A vertex joins when all its inputs are ready at the group's
+        // first vertex, where the whole group runs; nothing in the group
+        // can then depend on another member. Modulated vertices run alone,
+        // so they can follow their modulation within the block.
+        //
+        // Only groups an edit can affect are regrouped: those of vertices
+        // that are dirty or moved in the order, or that read from one (its
+        // fused chain, and so when it's ready, may have changed). Other
+        // groups stay valid as they are.
+        std::vector<int> window;
+        if (allMoved)
+        {
+            window = batchableVertices;
+        }
+        else
+        {
+            std::vector<int> touched = dirtyVertices;
+            for (int pos : movedPositions)
+                if (order.vertexAt(pos) >= 0)
+                    touched.push_back(order.vertexAt(pos));
+            const size_t numTouched = touched.size();
+            auto addReaders = [&](int u)
+            {
+                for (int e : vertices[static_cast<size_t>(u)].outEdges)
+                    touched.push_back(edges[static_cast<size_t>(e)].to);
+            };
+            for (size_t i = 0; i < numTouched; ++i)
+            {
+                // A fused chain's outputs are ready where its tail runs
+                const int tail = vertices[static_cast<size_t>(touched[i])].fusedTail;
+                if (tail >= 0)
+                    for (int u : vertices[static_cast<size_t>(tail)].fusedChain)
+                        addReaders(u);
+                else
+                    addReaders(touched[i]);
+            }
+
+            // Whole groups, so their members are regrouped together
+            for (int v : touched)
+            {
+                const int leader = vertices[static_cast<size_t>(v)].batchLeader;
+                if (leader >= 0)
+                    window.insert(window.end(), vertices[static_cast<size_t>(leader)].batch.begin(),
+                                  vertices[static_cast<size_t>(leader)].batch.end());
+                window.push_back(v);
+            }
+            std::sort(window.begin(), window.end());
+            window.erase(std::unique(window.begin(), window.end()), window.end());
+        }
+
+        std::vector<int> candidates;
+        for (int v : window)
+        {
+            auto &vertex = vertices[static_cast<size_t>(v)];
+            if (!vertex.id.empty() && vertex.node != nullptr && vertex.node->isBatchable() && vertex.fusedTail < 0 &&
+                !isModulated(v))
+                candidates.push_back(v);
+            else if (vertex.batchLeader >= 0)
+                markDirty(v); // leaves its group
+        }
+        std::sort(candidates.begin(), candidates.end(), [this](int a, int b)
+                  { return order.getPosition(a) < order.getPosition(b); });
+
+        std::vector<std::vector<int>> groups;
+        std::unordered_map<std::string, size_t> openGroups;
+        for (int v : candidates)
+        {
+            const auto &type = vertices[static_cast<size_t>(v)].node->nodeType;
+            auto open = openGroups.find(type);
+            if (open != openGroups.end())
+            {
+                auto &group = groups[open->second];
+                if (static_cast<int>(group.size()) < GraphSnapshot::MAX_BATCH_SIZE &&
+                    readyPosition(v) < order.getPosition(group.front()))
+                {
+                    group.push_back(v);
+                    continue;
+                }
+            }
+            openGroups[type] = groups.size();
+            groups.push_back({v});
+        }
+
+        // Rebuild every member of a group that changed or has a dirty
+        // member (the first member's entry holds the others'), and every
+        // vertex that left a group. A group with a member that left has
+        // all its members here, so none keeps a stale leader.
+        for (auto &group : groups)
+        {
+            if (group.size() < 2)
+            {
+                if (vertices[static_cast<size_t>(group.front())].batchLeader >= 0)
+                    markDirty(group.front());
+                continue;
+            }
+
+            bool changed = vertices[static_cast<size_t>(group.front())].batch != group;
+            for (int v : group)
+                changed = changed || isDirty[static_cast<size_t>(v)] || vertices[static_cast<size_t>(v)].batchLeader != group.front();
+            if (changed)
+                for (int v : group)
+                    markDirty(v);
+        }
+
+        for (int v : dirtyVertices)
+        {
+            auto &vertex = vertices[static_cast<size_t>(v)];
+            vertex.batchLeader = -1;
+            vertex.batch.clear();
+        }
+
+        for (auto &group : groups)
+        {
+            if (group.size() < 2 || !isDirty[static_cast<size_t>(group.front())])
+                continue;
+            for (int v : group)
+                vertices[static_cast<size_t>(v)].batchLeader = group.front();
+            vertices[static_cast<size_t>(group.front())].batch = std::move(group);
+        }
+    }
+
+    void AudioGraph::rebuildAndPublishSnapshot()
+    {
+        auto next = std::make_shared<GraphSnapshot>(*published);
+
+        // Without feedback edges the graph has no cycles to re-select
+        if (numFeedbackEdges > 0)
+            selectFeedbackEdges();
+        feedbackEdits.clear();
+
+        prepareNewNodes();
+        updateChannelCounts();
+        updateFusedChains();
+
+        // Positions the order rewrote: batching regroups around them, and
+        // their segments are replaced below
+        std::vector<int> positions;
+        bool all = false;
+        order.takeChangedPositions(positions, all);
+        updateBatches(positions, all);
+
+        // Rebuild entries for the vertices an edit touched. Fused members
+        // other than the last run inside the last one's entry. Batches are
+        // built after their members, whose entries they hold.
+        std::stable_partition(dirtyVertices.begin(), dirtyVertices.end(), [this](int v)
+                              { return vertices[static_cast<size_t>(v)].batch.empty(); });
+        for (int v : dirtyVertices)
+        {
+            isDirty[static_cast<size_t>(v)] = 0;
+            auto &vertex = vertices[static_cast<size_t>(v)];
+            const bool runsAlone = vertex.fusedTail < 0 || vertex.fusedTail == v;
+            vertex.entry = vertex.node != nullptr && runsAlone ? buildEntry(vertex) : nullptr;
+
+            const int pos = vertex.id.empty() ? -1 : order.getPosition(v);
+            if (pos >= 0)
+                changedPositions.push_back(pos);
+        }
+        dirtyVertices.clear();
+
+        // Replace only the segments whose positions changed
+        positions.insert(positions.end(), changedPositions.begin(), changedPositions.end());
+        changedPositions.clear();
+
+        const int numSegments = (order.getNumPositions() + GraphSnapshot::SEGMENT_SIZE - 1) / GraphSnapshot::SEGMENT_SIZE;
+        std::vector<char> segmentDirty(static_cast<size_t>(numSegments), all ? 1 : 0);
+        for (int pos : positions)
+            if (pos / GraphSnapshot::SEGMENT_SIZE < numSegments)
+                segmentDirty[static_cast<size_t>(pos / GraphSnapshot::SEGMENT_SIZE)] = 1;
+
+        next->segments.resize(static_cast<size_t>(numSegments));
+        segmentBuffers.resize(static_cast<size_t>(numSegments));
+        for (int k = 0; k < numSegments; ++k)
+        {
+            if (!segmentDirty[static_cast<size_t>(k)])
+                continue;
+
+            auto segment = std::make_shared<GraphSnapshot::Segment>();
+            int numBuffers = 0;
+            const int end = std::min(order.getNumPositions(), (k + 1) * GraphSnapshot::SEGMENT_SIZE);
+            for (int pos = k * GraphSnapshot::SEGMENT_SIZE; pos < end; ++pos)
+            {
+                const int v = order.vertexAt(pos);
+                if (v >= 0 && vertices[static_cast<size_t>(v)].entry)
+                {
+                    segment->push_back(vertices[static_cast<size_t>(v)].entry);
+                    numBuffers += segment->back()->numBuffers;
+                }
+            }
+            next->segments[static_cast<size_t>(k)] = std::move(segment);
+            segmentBuffers[static_cast<size_t>(k)] = numBuffers;
+        }
+
+        // Buffers aren't reused within a block, so the pool needs the sum
+        // of every entry's worst case. A larger one is allocated here, with
+        // headroom, rather than grown by the audio thread; the old one is
+        // freed with the snapshots that use it.
+        int numBuffers = 0;
+        for (int n : segmentBuffers)
+            numBuffers += n;
+        if (!bufferPool || static_cast<int>(bufferPool->buffers.size()) < numBuffers)
+            allocateBufferPool(std::max(BUFFER_POOL_SIZE, numBuffers + numBuffers / 2));
+        next->buffers = bufferPool;
+
+        next->numNodes = static_cast<int>(nodes.size());
+        next->hostBindings = resolveHostBindings();
+
+        if (feedbackChanged)
+        {
+            next->feedbackLines.clear();
+            for (auto &edge : edges)
+                if (edge.alive && edge.feedback)
+                    next->feedbackLines.push_back(edge.feedback);
+        }
+
+        next->output = {};
+        auto outIt = vertexIds.find(outputNodeId);
+        if (outIt != vertexIds.end())
+            next->output = resolveSource(outIt->second);
+
+        // Atomically publish — the audio thread will pick this up at the
+        // start of the next processBlock call.
+        retired.push_back({blocksCompleted.load(std::memory_order_acquire), std::move(published), nullptr, nullptr});
+        published = std::move(next);
+        activeSnapshot.store(published.get(), std::memory_order_release);
+
+        collectGarbage();
+
+        if (feedbackChanged || numFeedbackEdges > 0)
+        {
+            auto newCycles = findCycles();
+            if (!(newCycles == cycles))
+            {
+                cycles = std::move(newCycles);
+                if (cycleCallback)
+                    cycleCallback(cycles);
+            }
+        }
+        feedbackChanged = false;
+    }
+
+    std::vector<GraphCycle> AudioGraph::findCycles() const
+    {
+        // The order itself is acyclic, so every strongly connected component
+        // of the full graph (feedback edges included) with more than one
+        // vertex, or with a feedback self-loop, is a set of joined loops.
+        // Each contains a feedback edge, so the search starts from feedback
+        // targets only, and skips anything after the last feedback source
+        // in the order — from there nothing leads back. Iterative Tarjan.
+        std::vector<int> roots;
+        int lastSource = -1;
+        for (auto &edge : edges)
+        {
+            if (edge.alive && edge.feedback)
+            {
+                roots.push_back(edge.to);
+                lastSource = std::max(lastSource, order.getPosition(edge.from));
+            }
+        }
+
+        const int numVertices = static_cast<int>(vertices.size());
+        std::vector<int> index(static_cast<size_t>(numVertices), -1);
+        std::vector<int> lowLink(static_cast<size_t>(numVertices), 0);
+        std::vector<int> component(static_cast<size_t>(numVertices), -1);
+        std::vector<char> onStack(static_cast<size_t>(numVertices), 0);
+        std::vector<int> sccStack;
+        std::vector<int> visitedVertices;
+        std::vector<std::pair<int, size_t>> callStack; // vertex, next out-edge
+        int nextIndex = 0;
+        int numComponents = 0;
+
+        for (int root : roots)
+        {
+            if (index[static_cast<size_t>(root)] >= 0)
+                continue;
+
+            callStack.push_back({root, 0});
+            index[static_cast<size_t>(root)] = lowLink[static_cast<size_t>(root)] = nextIndex++;
+            visitedVertices.push_back(root);
+            sccStack.push_back(root);
+            onStack[static_cast<size_t>(root)] = 1;
+
+            while (!callStack.empty())
+            {
+                auto &[v, next] = callStack.back();
+                const auto &out = vertices[static_cast<size_t>(v)].outEdges;
+
+                if (next < out.size())
+                {
+                    const int w = edges[static_cast<size_t>(out[next++])].to;
+                    const auto wi = static_cast<size_t>(w);
+                    if (order.getPosition(w) > lastSource)
+                        continue;
+
+                    if (index[wi] < 0)
+                    {
+                        index[wi] = lowLink[wi] = nextIndex++;
+                        visitedVertices.push_back(w);
+                        sccStack.push_back(w);
+                        onStack[wi] = 1;
+                        callStack.push_back({w, 0});
+                    }
+                    else if (onStack[wi])
+                    {
+                        lowLink[static_cast<size_t>(v)] = std::min(lowLink[static_cast<size_t>(v)], index[wi]);
+                    }
+                    continue;
+                }
+
+                const int done = v;
+                callStack.pop_back();
+                if (!callStack.empty())
+                {
+                    const auto parent = static_cast<size_t>(callStack.back().first);
+                    lowLink[parent] = std::min(lowLink[parent], lowLink[static_cast<size_t>(done)]);
+                }
+
+                if (lowLink[static_cast<size_t>(done)] == index[static_cast<size_t>(done)])
+                {
+                    int w;
+                    do
+                    {
+                        w = sccStack.back();
+                        sccStack.pop_back();
+                        onStack[static_cast<size_t>(w)] = 0;
+                        component[static_cast<size_t>(w)] = numComponents;
+                    } while (w != done);
+                    ++numComponents;
+                }
+            }
+        }
+
+        // Group the feedback edges by the component they close
+        std::unordered_map<int, size_t> cycleOf;
+        std::vector<GraphCycle> result;
+        for (auto &edge : edges)
+        {
+            if (!edge.alive || !edge.feedback)
+                continue;
+
+            auto [it, inserted] = cycleOf.try_emplace(component[static_cast<size_t>(edge.from)], result.size());
+            if (inserted)
+                result.emplace_back();
+            result[it->second].feedbackConnections.push_back(describe(edge));
+        }
+
+        std::sort(visitedVertices.begin(), visitedVertices.end());
+        for (int v : visitedVertices)
+        {
+            auto it = cycleOf.find(component[static_cast<size_t>(v)]);
+            if (it != cycleOf.end())
+                result[it->second].nodeIds.push_back(vertices[static_cast<size_t>(v)].id);
+        }
+
+        for (auto &cycle : result)
+            std::sort(cycle.nodeIds.begin(), cycle.nodeIds.end());
+        std::sort(result.begin(), result.end(), [](const GraphCycle &a, const GraphCycle &b)
+                  { return a.nodeIds < b.nodeIds; });
+        return result;
+    }
+
+    void AudioGraph::collectGarbage()
+    {
+        // A block that started after an item was retired can't be using it;
+        // +2 waits out the block that was already running at the time.
+        const auto completed = blocksCompleted.load(std::memory_order_acquire);
+        auto collectable = std::partition(retired.begin(), retired.end(),
+                                          [completed](const Retired &r)
+                                          {
+                                              return completed < r.epoch + 2 ||
+                                                     (r.prepared && !r.prepared->load(std::memory_order_acquire));
+                                          });
+
+        // Removed nodes go back to the pool if their type has room
+        for (auto it = collectable; it != retired.end(); ++it)
+            nodePool.recycle(std::move(it->node));
+        retired.erase(collectable, retired.end());
+    }
+
+    // ---------------------------------------------------------------------------
+    // Apply pending param updates (audio thread)
+    // ---------------------------------------------------------------------------
+
+    void AudioGraph::applyPendingOps()
+    {
+        // Apply the newest value of each param posted since the last block.
+        // Nodes posted to before their removal stay alive until this block
+        // completes.
+        paramMailbox.deliver();
+    }
+
+    // ---------------------------------------------------------------------------
+    // Process (audio thread)
+    // ---------------------------------------------------------------------------
+
+    template <typename Resolve>
+    const float *AudioGraph::sumModulation(const GraphSnapshot::Modulation &modulation, int numSamples, Resolve &&resolve)
+    {
+        auto ref = acquireBuffer(1, numSamples);
+        if (!ref.isValid())
+            return nullptr; // out of pool buffers: unmodulated
+        float *dest = ref.buffer->getWritePointer(0);
+
+        // Every connection adds offset + depth·curve(x), reading channel 0
+        float offset = 0.0f;
+        for (auto &mod : modulation.sources)
+        {
+            offset += mod.offset;
+            auto ref = resolve(mod.source);
+            if (!ref.isValid())
+                continue;
+
+            const float *src = ref.buffer->getReadPointer(0);
+            const float depth = mod.source.gain;
+            switch (mod.curve)
+            {
+            case ModulationCurve::Linear:
+                juce::FloatVectorOperations::addWithMultiply(dest, src, depth, numSamples);
+                break;
+            case ModulationCurve::Exponential:
+                for (int s = 0; s < numSamples; ++s)
+                    dest[s] += depth * src[s] * std::abs(src[s]);
+                break;
+            case ModulationCurve::Logarithmic:
+                for (int s = 0; s < numSamples; ++s)
+                    dest[s] += depth * std::copysign(std::sqrt(std::abs(src[s])), src[s]);
+                break;
+            }
+        }
+
+        if (offset != 0.0f)
+            juce::FloatVectorOperations::add(dest, offset, numSamples);
+        return dest;
+    }
+
+    template <typename Resolve>
+    BufferRef AudioGraph::sumJunction(const GraphSnapshot::Junction &junction, int numSamples, Resolve &&resolve)
+    {
+        // As wide as the widest source
+        int numChannels = 1;
+        for (auto &source : junction.sources)
+        {
+            auto ref = resolve(source);
+            if (ref.isValid())
+                numChannels = std::max(numChannels, ref.buffer->getNumChannels());
+        }
+
+        auto ref = acquireBuffer(numChannels, numSamples);
+        if (!ref.isValid())
+            return {};
+        auto &sum = *ref.buffer;
+
+        // The first source on each channel is copied, the rest accumulated,
+        // so the buffer is written in one pass per source. Mono sources are
+        // broadcast; other sources with fewer channels leave the remaining
+        // channels to the others.
+        for (int ch = 0; ch < sum.getNumChannels(); ++ch)
+        {
+            float *dest = sum.getWritePointer(ch);
+            bool written = false;
+
+            for (auto &source : junction.sources)
+            {
+                auto ref = resolve(source);
+                if (!ref.isValid())
+                    continue;
+                const int sourceChannels = ref.buffer->getNumChannels();
+                if (ch >= sourceChannels && sourceChannels != 1)
+                    continue;
+
+                const float *src = ref.buffer->getReadPointer(sourceChannels == 1 ? 0 : ch);
+                if (!written)
+                {
+                    if (source.gain == 1.0f)
+                        juce::FloatVectorOperations::copy(dest, src, numSamples);
+                    else
+                        juce::FloatVectorOperations::copyWithMultiply(dest, src, source.gain, numSamples);
+                    written = true;
+                }
+                else if (source.gain == 1.0f)
+                {
+                    juce::FloatVectorOperations::add(dest, src, numSamples);
+                }
+                else
+                {
+                    juce::FloatVectorOperations::addWithMultiply(dest, src, source.gain, numSamples);
+                }
+            }
+
+            if (!written)
+                juce::FloatVectorOperations::clear(dest, numSamples);
+        }
+
+        return ref;
+    }
+
+    template <typename Resolve>
+    void AudioGraph::processFusedChain(const GraphSnapshot::NodeEntry &entry, int numSamples, Resolve &&resolve)
+    {
+        auto &sources = entry.fusedInput.sources;
+        BufferRef input;
+        if (sources.size() == 1 && sources[0].gain == 1.0f)
+            input = resolve(sources[0]);
+        else if (!sources.empty())
+            input = sumJunction(entry.fusedInput, numSamples, resolve);
+
+        auto *first = entry.fusedStages.front();
+        if (input.isValid() && input.buffer->getNumChannels() == 1 && entry.numChannels > 1 && !first->acceptsMonoInput(0))
+            input = broadcast(*input.buffer, entry.numChannels, numSamples);
+
+        auto *last = entry.node;
+        last->outputBuffer = acquireBuffer(entry.numChannels, numSamples);
+        if (!last->outputBuffer.isValid())
+        {
+            for (auto *stage : entry.fusedStages)
+                stage->outputBuffer = {};
+            return;
+        }
+        auto &out = *last->outputBuffer.buffer;
+
+        bool fused = input.isValid() && input.buffer->getNumChannels() == out.getNumChannels() && !last->isBypassed();
+        for (auto *stage : entry.fusedStages)
+            fused = fused && !stage->isBypassed();
+
+        if (fused)
+        {
+            // Every member runs on one tile before the next tile starts; the
+            // first reads the input, the rest work in place on the output.
+            for (auto *stage : entry.fusedStages)
+            {
+                stage->outputBuffer = {};
+                stage->beginBlock(numSamples);
+            }
+            last->beginBlock(numSamples);
+
+            const int numChannels = out.getNumChannels();
+            const float *const *src = input.buffer->getArrayOfReadPointers();
+            float *const *dest = out.getArrayOfWritePointers();
+
+            for (int start = 0; start < numSamples; start += FUSION_TILE_SIZE)
+            {
+                const int n = juce::jmin(FUSION_TILE_SIZE, numSamples - start);
+                const float *const *tile = src;
+                for (auto *stage : entry.fusedStages)
+                {
+                    stage->processRange(tile, dest, numChannels, start, n);
+                    tile = dest;
+                }
+                last->processRange(tile, dest, numChannels, start, n);
+            }
+            return;
+        }
+
+        // A bypassed member, or an input the members would reshape: run
+        // them one after another, as unfused nodes
+        auto run = [&](AudioNodeBase *node)
+        {
+            node->inputBuffers.resize(1);
+            node->inputBuffers[0] = input;
+            if (!node->outputBuffer.isValid())
+            {
+                input = {}; // out of pool buffers: silent
+                return;
+            }
+            if (node->isBypassed())
+                node->processBypass(numSamples);
+            else
+                node->process(numSamples);
+            input = node->outputBuffer;
+        };
+
+        for (auto *stage : entry.fusedStages)
+        {
+            stage->outputBuffer = acquireBuffer(entry.numChannels, numSamples);
+            run(stage);
+        }
+        run(last);
+    }
+
+    template <typename Wire>
+    void AudioGraph::processBatch(const GraphSnapshot::NodeEntry &entry, int numSamples, Wire &&wire)
+    {
+        // Every member is wired before any runs; bypassed members pass
+        // through on their own and the rest run as one batch.
+        std::array<AudioNodeBase *, GraphSnapshot::MAX_BATCH_SIZE> members;
+        int numMembers = 0;
+
+        auto add = [&](const GraphSnapshot::NodeEntry &member)
+        {
+            if (!wire(member))
+                return;
+            if (member.node->isBypassed())
+                member.node->processBypass(numSamples);
+            else
+                members[static_cast<size_t>(numMembers++)] = member.node;
+        };
+
+        add(entry);
+        for (auto &member : entry.batch)
+            add(*member);
+
+        if (numMembers > 0)
+            members[0]->processBatch(members.data(), numMembers, numSamples);
+    }
+
+    void AudioGraph::setSubBlockSize(int numSamples)
+    {
+        numSamples = juce::jmax(0, numSamples);
+        subBlockSize.store(numSamples, std::memory_order_relaxed);
+
+        // Nodes preparing on the worker are told when they're swapped in
+        for (auto &[id, node] : nodes)
+            if (node && preparing.count(id) == 0)
+                node->setSubBlockSize(numSamples);
+    }
+
+    void AudioGraph::processBlock(juce::AudioBuffer<float> &buffer, juce::MidiBuffer &midi, int numInputChannels)
+    {
+        const int numSamples = buffer.getNumSamples();
+        mainInputChannels = numInputChannels < 0 ? buffer.getNumChannels()
+                                                 : juce::jmin(numInputChannels, buffer.getNumChannels());
+
+        // Apply any pending parameter updates (lock-free drain)
+        applyPendingOps();
+
+        // Read the latest graph snapshot (atomic load). It's kept for the
+        // whole host block, so removed nodes outlive every sub-block.
+        auto *snapshot = activeSnapshot.load(std::memory_order_acquire);
+        if (!snapshot || snapshot->numNodes == 0)
+        {
+            blocksCompleted.fetch_add(1, std::memory_order_release);
+            return;
+        }
+        activeBuffers = snapshot->buffers.get();
+
+        // Pool buffers hold the prepared block size, so no sub-block may
+        // be longer
+        const int requested = subBlockSize.load(std::memory_order_relaxed);
+        const int step = requested > 0 ? juce::jmin(requested, currentBlockSize) : currentBlockSize;
+
+        if (numSamples <= step)
+        {
+            processSubBlock(*snapshot, buffer, midi, numSamples);
+            blocksCompleted.fetch_add(1, std::memory_order_release);
+            return;
+        }
+
+        for (int start = 0; start < numSamples; start += step)
+        {
+            const int length = juce::jmin(step, numSamples - start);
+
+            // Updates posted while the previous sub-block ran land here
+            if (start > 0)
+                applyPendingOps();
+
+            hostView.setDataToReferTo(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, length);
+            for (auto &[bus, input] : hostInputBuffers)
+            {
+                if (input.buffer != nullptr)
+                    input.view.setDataToReferTo(input.buffer->getArrayOfWritePointers(), input.buffer->getNumChannels(),
+                                                start, length);
+            }
+
+            // MIDI timestamps become relative to the sub-block
+            subBlockMidi.clear();
+            subBlockMidi.addEvents(midi, start, length, -start);
+
+            processSubBlock(*snapshot, hostView, subBlockMidi, length);
+        }
+
+        blocksCompleted.fetch_add(1, std::memory_order_release);
+    }
+
+    void AudioGraph::processSubBlock(const GraphSnapshot &snapshot, juce::AudioBuffer<float> &buffer,
+                                     juce::MidiBuffer &midi, int numSamples)
+    {
+        // Host automation lands in this sub-block, after any JS updates
+        for (auto &binding : snapshot.hostBindings)
+            binding.target->store(binding.range.toActual(binding.source->load(std::memory_order_relaxed)));
+
+        // A main input narrower than the output reads only its own channels
+        const bool narrowInput = mainInputChannels > 0 && mainInputChannels < buffer.getNumChannels();
+        if (narrowInput)
+            mainInputView.setDataToReferTo(buffer.getArrayOfWritePointers(), mainInputChannels, 0, numSamples);
+
+        // Reset buffer pool
+        activeBuffers->numUsed = 0;
+
+        auto resolve = [&](const GraphSnapshot::Source &source) -> BufferRef
+        {
+            switch (source.kind)
+            {
+            case GraphSnapshot::Source::Node:
+                return source.node->getOutputBuffer(source.fromOutlet);
+            case GraphSnapshot::Source::HostInput:
+            {
+                if (source.bus == 0)
+                {
+                    if (mainInputChannels == 0)
+                        return {};
+                    return {narrowInput ? &mainInputView : &buffer, -1};
+                }
+                auto it = hostInputBuffers.find(source.bus);
+                if (it == hostInputBuffers.end() || it->second.buffer == nullptr)
+                    return {};
+                // Split blocks read the sub-block's view
+                if (&buffer != &hostView)
+                    return {it->second.buffer, -1};
+                return {&it->second.view, -1};
+            }
+            case GraphSnapshot::Source::Feedback:
+                return {&source.line->output, -1};
+            default:
+                return {};
+            }
+        };
+
+        const juce::AudioBuffer<float> noOutlet; // no channels, so writes silence
+
+        // Feedback edges deliver what their source produced last block
+        for (auto &line : snapshot.feedbackLines)
+            line->read(numSamples);
+
+        // Acquire an output buffer for each of the node's outlets and wire
+        // up its inputs (sources earlier in the order have already
+        // produced this block's output). False if the pool ran out, in
+        // which case the node doesn't run and its outlets read as silence.
+        auto wire = [&](const GraphSnapshot::NodeEntry &entry) -> bool
+        {
+            auto *node = entry.node;
+
+            node->outputBuffer = acquireBuffer(entry.numChannels, numSamples);
+            bool wired = node->outputBuffer.isValid();
+            for (auto &extra : node->extraOutputBuffers)
+            {
+                extra = acquireBuffer(entry.numChannels, numSamples);
+                wired = wired && extra.isValid();
+            }
+            if (!wired)
+            {
+                node->outputBuffer = {};
+                for (auto &extra : node->extraOutputBuffers)
+                    extra = {};
+                return false;
+            }
+
+            node->inputBuffers.resize(entry.inputs.size());
+            for (size_t inlet = 0; inlet < entry.inputs.size(); ++inlet)
+                node->inputBuffers[inlet] = resolve(entry.inputs[inlet]);
+            for (auto &junction : entry.junctions)
+                node->inputBuffers[static_cast<size_t>(junction.inlet)] = sumJunction(junction, numSamples, resolve);
+
+            // Mono signals stay one channel until read by a node that
+            // wants a channel per output channel
+            if (entry.numChannels > 1)
+            {
+                for (size_t inlet = 0; inlet < node->inputBuffers.size(); ++inlet)
+                {
+                    auto &ref = node->inputBuffers[inlet];
+                    if (ref.isValid() && ref.buffer->getNumChannels() == 1 && !node->acceptsMonoInput(static_cast<int>(inlet)))
+                        ref = broadcast(*ref.buffer, entry.numChannels, numSamples);
+                }
+            }
+
+            // Point driven parameters at this block's modulation
+            for (auto &modulation : entry.modulations)
+                *modulation.slot = sumModulation(modulation, numSamples, resolve);
+
+            // Provide the MIDI buffer to MidiInputNode instances
+            if (entry.midiInput != nullptr)
+            {
+                entry.midiInput->midiBuffer = &midi;
+            }
+            return true;
+        };
+
+        for (auto &segment : snapshot.segments)
+        {
+            for (auto &entry : *segment)
+            {
+                auto *node = entry->node;
+
+                if (!entry->fusedStages.empty())
+                {
+                    processFusedChain(*entry, numSamples, resolve);
+                }
+                else if (!entry->batch.empty())
+                {
+                    processBatch(*entry, numSamples, wire);
+                }
+                else if (!entry->batched && wire(*entry)) // batched nodes ran with their batch
+                {
+                    // Process
+                    if (node->isBypassed())
+                    {
+                        node->processBypass(numSamples);
+                    }
+                    else
+                    {
+                        node->process(numSamples);
+                    }
+                }
+
+                // The modulation buffers go back to the pool with the block
+                for (auto &modulation : entry->modulations)
+                    *modulation.slot = nullptr;
+
+                for (auto &write : entry->feedbackWrites)
+                {
+                    // An outlet the node doesn't have feeds back silence
+                    auto source = node->getOutputBuffer(write.fromOutlet);
+                    write.line->write(source.isValid() ? *source.buffer : noOutlet, numSamples);
+                }
+            }
+        }
+
+        // Copy the output node's buffer back to the host buffer
+        auto out = resolve(snapshot.output);
+        if (out.isValid() && out.buffer != &buffer)
+        {
+            auto &outBuf = *out.buffer;
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            {
+                // A mono output plays on every channel; channels a wider
+                // output doesn't have are silenced, not left holding the
+                // input
+                const int source = outBuf.getNumChannels() == 1 ? 0 : ch;
+                if (source >= outBuf.getNumChannels())
+                    buffer.clear(ch, 0, numSamples);
+                else if (outBuf.getReadPointer(source) != buffer.getReadPointer(ch)) // the input's own channels are in place
+                    buffer.copyFrom(ch, 0, outBuf, source, 0, numSamples);
+            }
+        }
     }
 
 } // namespace rau
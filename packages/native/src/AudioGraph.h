@@ -1,11 +1,17 @@
 #pragma once
 
+#include "BackgroundWorker.h"
 #include "nodes/NodeBase.h"
 #include "nodes/NodeFactory.h"
-#include "SPSCQueue.h"
+#include "nodes/NodePool.h"
+#include "ParamRange.h"
+#include "PrepareThreads.h"
+#include "TopologicalOrder.h"
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -13,6 +19,14 @@
 namespace rau
 {
 
+    /** Shaping applied to a parameter connection's source */
+    enum class ModulationCurve
+    {
+        Linear,      // x
+        Exponential, // x·|x|
+        Logarithmic  // sign(x)·√|x|
+    };
+
     /**
      * GraphOp — mirrors the JS-side GraphOp type.
      * These are queued from the message thread and applied on the audio thread.
@@ -39,14 +53,61 @@ namespace rau
         int fromOutlet = 0;
         std::string toNodeId;
         int toInlet = 0;
+        float gain = 1.0f; // Connect: scale applied where the edge is summed
+
+        // Connect/Disconnect into a parameter instead of an inlet. `gain`
+        // is then the modulation depth.
+        std::string toParam;
+        float offset = 0.0f;
+        ModulationCurve curve = ModulationCurve::Linear;
+    };
+
+    /**
+     * FeedbackLine — the delay behind a connection that closes a cycle.
+     *
+     * The consumer runs before the producer, so it reads what the producer
+     * wrote one block earlier. The delay is fixed at the prepared max block
+     * size (one block at the host's nominal size), so it doesn't change if
+     * the host sends shorter blocks. Storage is a ring of two max blocks,
+     * allocated on the message thread.
+     */
+    struct FeedbackLine
+    {
+        void prepare(int numChannels, int maxBlockSize);
+
+        // Audio thread: `output` receives the delayed signal for this block
+        void read(int numSamples);
+        void write(const juce::AudioBuffer<float> &source, int numSamples);
+
+        juce::AudioBuffer<float> ring;
+        juce::AudioBuffer<float> output;
+        int delay = 0;
+        int writePos = 0;
+    };
+
+    class MidiInputNode;
+
+    /**
+     * BufferPool — the scratch buffers a block's node outputs, junction
+     * sums and modulation are written into. Allocated on the message
+     * thread, at the full layout, with room for the worst case of every
+     * snapshot that uses it; the audio thread hands the buffers out in
+     * order and starts over every sub-block.
+     */
+    struct BufferPool
+    {
+        std::vector<juce::AudioBuffer<float>> buffers;
+        int numUsed = 0; // audio thread
     };
 
     /**
-     * GraphSnapshot — an immutable snapshot of the graph topology.
+     * GraphSnapshot — an immutable, compiled view of the graph topology.
      *
-     * Built on the message thread, then atomically swapped into the
-     * audio thread's active slot. Nodes are shared (owned by the
-     * AudioGraph's master map), so only the topology is duplicated.
+     * Built on the message thread, then published to the audio thread via
+     * an atomic pointer swap. Snapshots share structure: the processing
+     * order is split into fixed-size segments of per-node entries, and a
+     * rebuild only replaces the segments and entries an edit touched.
+     * Nodes are owned by the AudioGraph, so only topology is referenced.
      */
     struct GraphSnapshot
     {
@@ -56,34 +117,163 @@ namespace rau
             int fromOutlet;
             std::string toNodeId;
             int toInlet;
+            float gain = 1.0f;
+            std::string toParam; // set for a connection into a parameter
+            float offset = 0.0f;
+            ModulationCurve curve = ModulationCurve::Linear;
         };
 
-        std::vector<AudioNodeBase *> processingOrder;
-        std::vector<Connection> connections;
-        std::string outputNodeId;
-        std::string inputNodeId;
-        std::unordered_map<int, std::string> inputNodeIds; // bus index → node ID
+        // Where an inlet reads from, resolved to pointers up front so the
+        // audio thread does no lookups.
+        struct Source
+        {
+            enum Kind
+            {
+                None,
+                Node,
+                HostInput,
+                Feedback
+            };
+            Kind kind = None;
+            AudioNodeBase *node = nullptr;
+            int fromOutlet = 0;
+            int bus = 0;
+            FeedbackLine *line = nullptr;
+            float gain = 1.0f;
+        };
+
+        // An inlet fed by several connections (or by one with a gain). Its
+        // sources are summed into a pool buffer before the node runs.
+        struct Junction
+        {
+            int inlet = 0;
+            std::vector<Source> sources; // in connection order
+        };
+
+        // A parameter driven by connections. Each block their sources are
+        // shaped, scaled (by `gain`), offset and summed into a one-channel
+        // buffer that the node reads through `slot`.
+        struct ModulationSource
+        {
+            Source source;
+            float offset = 0.0f;
+            ModulationCurve curve = ModulationCurve::Linear;
+        };
+
+        struct Modulation
+        {
+            const float **slot = nullptr;
+            std::vector<ModulationSource> sources; // in connection order
+        };
+
+        struct FeedbackWrite
+        {
+            FeedbackLine *line = nullptr;
+            int fromOutlet = 0;
+        };
+
+        struct NodeEntry
+        {
+            AudioNodeBase *node = nullptr;
+            int numChannels = 0;                        // width of every outlet
+            MidiInputNode *midiInput = nullptr;
+            std::vector<Source> inputs;                 // index = inlet; None for junctions
+            std::vector<Junction> junctions;            // summed inlets
+            std::vector<FeedbackWrite> feedbackWrites; // lines fed by this node
+            std::vector<Modulation> modulations;       // driven parameters
+
+            // Set on the last node of a chain of fusible nodes. The chain
+            // runs as one tiled pass from `fusedInput`; the other members
+            // have no entry of their own.
+            std::vector<AudioNodeBase *> fusedStages; // members before this node, first to last
+            Junction fusedInput;                       // sources of the first member's inlet 0
+
+            // Set on the first node of a batch, which runs the other
+            // members with itself; those are marked `batched` and only
+            // write their feedback lines at their own place.
+            std::vector<std::shared_ptr<const NodeEntry>> batch;
+            bool batched = false;
+
+            // Pool buffers running this entry takes at most (a batch's
+            // first node counts its members; they count none)
+            int numBuffers = 0;
+        };
+
+        // A host parameter driving a node parameter. Applied at the top of
+        // every block, before any node runs.
+        struct HostBinding
+        {
+            const std::atomic<float> *source = nullptr; // normalised 0–1
+            ParamRange range;
+            AtomicFloat *target = nullptr;
+        };
+
+        static constexpr int SEGMENT_SIZE = 64;
+        static constexpr int MAX_BATCH_SIZE = 16;
+        using Segment = std::vector<std::shared_ptr<const NodeEntry>>;
+
+        std::vector<std::shared_ptr<const Segment>> segments; // processing order
+        std::vector<std::shared_ptr<FeedbackLine>> feedbackLines;
+        std::shared_ptr<BufferPool> buffers; // room for every entry's numBuffers
+        Source output;
+        std::vector<HostBinding> hostBindings;
+        int numNodes = 0;
+    };
+
+    /**
+     * GraphCycle — a set of nodes joined by feedback loops, and the
+     * connections that were turned into feedback edges to break them.
+     */
+    struct GraphCycle
+    {
+        std::vector<std::string> nodeIds; // sorted
+        std::vector<GraphSnapshot::Connection> feedbackConnections;
+
+        bool operator==(const GraphCycle &other) const;
+    };
+
+    /**
+     * GraphMemoryReport — what the graph's nodes hold in its NodeArena.
+     * Spare (pooled) and not-yet-freed removed nodes count towards the
+     * totals but aren't listed.
+     */
+    struct GraphMemoryReport
+    {
+        struct NodeMemory
+        {
+            std::string nodeId;
+            std::string nodeType;
+            size_t bytes = 0;
+        };
+        std::vector<NodeMemory> nodes; // live nodes, by ID
 
-        // Fast node lookup for the audio thread (raw pointers, no ownership).
-        // Populated during rebuildAndPublishSnapshot so the audio thread never
-        // touches the authoritative `nodes` map.
-        std::unordered_map<std::string, AudioNodeBase *> nodeMap;
+        size_t inUse = 0;      // every node's state, listed or not
+        size_t reserved = 0;   // held by the arena
+        size_t budget = 0;     // 0 for none
+        size_t overBudget = 0; // allocated past the budget
     };
 
     /**
      * AudioGraph — the real-time DSP node graph.
      *
-     * Owns all DSP nodes, manages a topologically-sorted processing order,
-     * and provides a lock-free operation queue for graph mutations from
-     * the message thread.
+     * Owns all DSP nodes, maintains a topological processing order, and
+     * provides a lock-free operation queue for graph mutations from the
+     * message thread.
      *
      * Thread safety model:
      *  - processBlock() is called on the audio thread
-     *  - queueOp() queues topology changes; the message thread builds a
-     *    new GraphSnapshot and publishes it via atomic pointer swap
-     *  - setNodeParam() writes directly to atomic params (lock-free fast path)
-     *  - UpdateParams ops also go through the SPSC queue for batched updates
+     *  - queueOp() applies topology changes to the message-thread model
+     *    (incremental order + per-node entries), then publishes a new
+     *    GraphSnapshot via atomic pointer swap
+     *  - setNodeParam() and UpdateParams ops post to a latest-wins mailbox
+     *    that the audio thread applies at the top of each sub-block
      *  - The audio thread reads the latest snapshot at the top of processBlock()
+     *  - Replaced snapshots and removed nodes are freed on the message
+     *    thread once the audio thread has finished a full block without them
+     *  - New nodes are prepared together at the end of an edit, in
+     *    parallel on the shared PrepareThreads; with background
+     *    preparation on, nodes with a heavy prepare() are prepared on the
+     *    BackgroundWorker instead and swapped in by publishPreparedNodes()
      */
     class AudioGraph
     {
@@ -91,9 +281,27 @@ namespace rau
         AudioGraph();
         ~AudioGraph();
 
-        // Called from audio thread
+        // Called while the audio thread is stopped. Nodes are prepared in
+        // parallel.
         void prepare(double sampleRate, int maxBlockSize, int numChannels);
-        void processBlock(juce::AudioBuffer<float> &buffer, juce::MidiBuffer &midi);
+
+        // Called from audio thread. Blocks longer than the prepared size
+        // are processed in pieces. The main input (bus 0) is the first
+        // `numInputChannels` channels of `buffer` (-1 for all of them, 0 for
+        // none, as in an instrument); the output fills every channel.
+        void processBlock(juce::AudioBuffer<float> &buffer, juce::MidiBuffer &midi, int numInputChannels = -1);
+
+        /**
+         * Process each host block in sub-blocks of at most `numSamples`
+         * (message thread), applying parameter updates between them; 0
+         * uses the prepared block size. Sizes above the prepared block
+         * size are clamped to it. The topology, and so feedback latency,
+         * stays that of the prepared block size; nodes whose cost depends
+         * on the block size (the convolver's head) re-plan for it.
+         */
+        void setSubBlockSize(int numSamples);
+
+        int getSubBlockSize() const { return subBlockSize.load(std::memory_order_relaxed); }
 
         // Called from message thread — queues an operation for the audio thread
         void queueOp(GraphOp op);
@@ -101,9 +309,61 @@ namespace rau
         // Batch multiple topology ops, rebuilding the snapshot only once at the end
         void queueOps(std::vector<GraphOp> ops);
 
-        // Called from message thread — direct parameter update (fast path)
+        /**
+         * Ops that rebuild the current graph from empty: every node with its
+         * parameter values, every connection (including ones still waiting
+         * for their node, and feedback connections last), and the output.
+         * Message thread.
+         */
+        std::vector<GraphOp> describeGraph() const;
+
+        /**
+         * Make the graph match the one `desired` builds from empty (AddNode,
+         * Connect and SetOutput ops, as returned by describeGraph()).
+         * Message thread.
+         *
+         * The current graph is diffed against it by node ID: a node whose
+         * ID and type are unchanged is kept with its state and only has its
+         * parameters posted, nodes and connections that aren't wanted are
+         * removed, and missing ones are added. The snapshot is rebuilt once,
+         * and only if the topology actually changed.
+         */
+        void setGraph(const std::vector<GraphOp> &desired);
+
+        // Called from message thread — parameter update for the next block (fast path)
         void setNodeParam(const std::string &nodeId, const std::string &param, float value);
 
+        /**
+         * A node parameter's mailbox slot (message thread), so other
+         * threads can post to it without looking the node up. Valid until
+         * the node is removed. Null if there's no such node or parameter.
+         */
+        ParamMailbox::Slot *getParamHandle(const std::string &nodeId, const std::string &param);
+
+        // Any thread: latest value wins; applied at the top of the next block
+        void postParam(ParamMailbox::Slot &handle, float value) { paramMailbox.post(handle, value); }
+
+        /**
+         * Drive a node parameter from a host parameter (message thread).
+         * The audio thread maps `source` through `range` and writes the
+         * result at the top of each block, so automation lands in the same
+         * block without a round trip through JS, and keeps working while
+         * the editor is closed. The binding survives the node being
+         * removed and re-added; it replaces any earlier binding of the
+         * same node parameter.
+         *
+         * @param nodeId  Node to drive
+         * @param param   Parameter name on that node
+         * @param source  Normalised host value; must outlive the binding
+         * @param range   Maps the host value onto the node parameter
+         */
+        void bindHostParam(const std::string &nodeId, const std::string &param,
+                           const std::atomic<float> *source, ParamRange range);
+
+        // Message thread: drop one binding, or every binding fed by `source`
+        void unbindHostParam(const std::string &nodeId, const std::string &param);
+        void unbindHostSource(const std::atomic<float> *source);
+
         // Set additional host input buffers (for sidechain, etc.)
         void setHostInputBuffer(int busIndex, juce::AudioBuffer<float> *buffer);
 
@@ -113,53 +373,268 @@ namespace rau
         // Get all nodes of a given type (e.g. "meter", "spectrum")
         std::vector<AudioNodeBase *> getNodesByType(const std::string &type) const;
 
+        // Cycles in the current topology (message thread)
+        const std::vector<GraphCycle> &getCycles() const { return cycles; }
+
+        // Called on the message thread whenever the set of cycles changes
+        using CycleCallback = std::function<void(const std::vector<GraphCycle> &)>;
+        void onCyclesChanged(CycleCallback cb) { cycleCallback = std::move(cb); }
+
+        // --- Background preparation -----------------------------------------
+
+        /**
+         * Prepare added nodes that have a heavy prepare() (see
+         * AudioNodeBase::hasHeavyPrepare) on the background worker, so an
+         * edit never stalls the message thread on them. Until one is ready
+         * a pass-through runs in its place; publishPreparedNodes() swaps
+         * the real node in. Parameters, bindings and getNode() reach the
+         * real node throughout. Off by default, so edits from tools and
+         * benchmarks take effect completely before they return.
+         */
+        void setBackgroundPreparation(bool enabled) { backgroundPreparation = enabled; }
+
+        /**
+         * Called on the worker thread each time a background preparation
+         * finishes. Respond by calling publishPreparedNodes() on the
+         * message thread.
+         */
+        void onNodePrepared(std::function<void()> cb);
+
+        // Message thread: swap in every node whose preparation has finished
+        void publishPreparedNodes();
+
+        // Message thread: block until no background preparation is running
+        void waitForPreparedNodes();
+
+        // --- Node pool ---------------------------------------------------------
+
+        /**
+         * Keep `count` prepared spares of a node type on hand (message
+         * thread). AddNode takes a spare when there is one, and removed
+         * nodes are returned to the pool once the audio thread is done
+         * with them, so toggling sections or voices doesn't allocate. The
+         * spares are prepared here, in parallel. Without prewarming a type
+         * still keeps up to NodePool::DEFAULT_CAPACITY removed nodes.
+         */
+        void prewarmNodes(const std::string &type, int count);
+
+        const NodePool &getNodePool() const { return nodePool; }
+
+        // --- Memory ------------------------------------------------------------
+
+        /**
+         * Cap on the memory the graph's arena reserves for node state
+         * (message thread); 0 for none. It's soft: nodes prepared past it
+         * still get their memory, from the heap, and the report shows the
+         * overrun.
+         */
+        void setMemoryBudget(size_t bytes);
+
+        GraphMemoryReport getMemoryReport() const;
+
     private:
+        // --- Message-thread model -------------------------------------------
+
+        struct Vertex
+        {
+            std::string id;
+            AudioNodeBase *node = nullptr; // null for host input vertices
+            int inputBus = -1;
+            std::vector<int> inEdges;  // in connection order
+            std::vector<int> outEdges; // by edgeBefore()
+            std::shared_ptr<const GraphSnapshot::NodeEntry> entry;
+            int numChannels = 0; // output width, inferred from the inputs
+
+            // Fusion: the last vertex of this vertex's chain (-1 if unfused);
+            // the last vertex also holds the whole chain, first to last.
+            int fusedTail = -1;
+            std::vector<int> fusedChain;
+
+            // Batching: the first vertex of this vertex's batch (-1 if not
+            // batched); the first vertex also holds the batch, in order.
+            int batchLeader = -1;
+            std::vector<int> batch;
+        };
+
+        struct Edge
+        {
+            int from = -1;
+            int fromOutlet = 0;
+            int to = -1;
+            int toInlet = 0; // -1 for a connection into a parameter
+            float gain = 1.0f;
+            std::string toParam;
+            float offset = 0.0f;
+            ModulationCurve curve = ModulationCurve::Linear;
+            bool alive = false;
+            std::shared_ptr<FeedbackLine> feedback; // set if this edge closes a cycle
+        };
+
         void applyTopologyOp(const GraphOp &op);
+        void retireNode(const std::string &id);
+        AudioNodeBase *prepareInBackground(AudioNodeBase &node, bool recycled);
+        void prepareNewNodes();
+        int addVertex(const std::string &id, AudioNodeBase *node, int inputBus);
+        void removeVertex(int v);
+        void connect(const GraphSnapshot::Connection &conn);
+        void disconnect(const GraphSnapshot::Connection &conn);
+        void removeEdge(int e);
+        bool edgeBefore(int a, int b) const; // by target ID, then outlet, inlet, param
+        void selectFeedbackEdges();
+        void markDirty(int v);
+        void markChainDirty(int v);
+        bool canFuse(int v) const;
+        int fusedSuccessor(int v) const;
+        int fusedPredecessor(int v) const;
+        void updateChannelCounts();
+        void updateFusedChains();
+        void updateBatchable(int v);
+        int readyPosition(int v) const;
+        void updateBatches(const std::vector<int> &movedPositions, bool allMoved);
+        GraphSnapshot::Connection describe(const Edge &edge) const;
+
         void applyPendingOps();
+        void processSubBlock(const GraphSnapshot &snapshot, juce::AudioBuffer<float> &io,
+                             juce::MidiBuffer &midi, int numSamples);
         void rebuildAndPublishSnapshot();
-        static void buildProcessingOrder(
-            const std::unordered_map<std::string, std::unique_ptr<AudioNodeBase>> &nodeMap,
-            const std::vector<GraphSnapshot::Connection> &conns,
-            std::vector<AudioNodeBase *> &outOrder);
+        std::shared_ptr<const GraphSnapshot::NodeEntry> buildEntry(const Vertex &vertex) const;
+        std::vector<std::vector<GraphSnapshot::Source>> collectSources(const Vertex &vertex) const;
+        std::vector<GraphSnapshot::Modulation> collectModulations(const Vertex &vertex) const;
+        bool isModulated(int v) const;
+        GraphSnapshot::Source resolveSource(int v) const;
+        std::vector<GraphCycle> findCycles() const;
+        void collectGarbage();
+
+        // Node DSP state; declared first so it outlives every node (live,
+        // pooled, retired or preparing)
+        NodeArena arena;
 
         // Node storage (shared across snapshots — nodes outlive topology changes)
         std::unordered_map<std::string, std::unique_ptr<AudioNodeBase>> nodes;
 
-        // Authoritative topology (message-thread side)
-        std::vector<GraphSnapshot::Connection> connections;
+        std::unordered_map<std::string, int> vertexIds;
+        std::vector<int> verticesById; // live vertices, sorted by ID
+        std::vector<Vertex> vertices; // indexed by TopologicalOrder vertex id
+        std::vector<Edge> edges;
+        std::vector<int> freeEdges;
+        TopologicalOrder order;
+        int numFeedbackEdges = 0;
+
+        // Connections naming a node that doesn't exist yet
+        std::vector<GraphSnapshot::Connection> pendingConnections;
+
+        std::vector<int> batchableVertices;
+
+        std::vector<int> dirtyVertices;
+        std::vector<char> isDirty;
+        std::vector<int> changedPositions;
+        bool feedbackChanged = false;
+        std::vector<std::pair<int, int>> feedbackEdits; // (from, to) of edges changed since selectFeedbackEdges()
+        std::vector<char> searchMarks;                  // selectFeedbackEdges() scratch, all 0 between calls
+        std::vector<int> searchSlots;                   // selectFeedbackEdges() scratch, all -1 between calls
+
         std::string outputNodeId;
-        std::string inputNodeId;
-
-        // Double-buffered snapshots: the audio thread reads from activeSnapshot,
-        // the message thread writes to the staging slot and swaps.
-        // Using two heap-allocated snapshots and an atomic pointer.
-        std::unique_ptr<GraphSnapshot> snapshotA;
-        std::unique_ptr<GraphSnapshot> snapshotB;
-        std::atomic<GraphSnapshot *> activeSnapshot{nullptr};
-
-        // Buffer pool (pre-allocated)
-        std::vector<juce::AudioBuffer<float>> bufferPool;
-        std::vector<bool> bufferInUse;
-        int acquireBuffer();
-        void releaseBuffer(int index);
-
-        // Operation queue (message thread -> audio thread)
-        // Only used for UpdateParams ops now; topology changes are handled
-        // by snapshot swap.
-        SPSCQueue<GraphOp, 1024> paramOpQueue;
-        std::vector<GraphOp> processingOps; // drained from SPSC on audio thread
+
+        struct HostBindingSpec
+        {
+            std::string nodeId;
+            std::string param;
+            const std::atomic<float> *source = nullptr;
+            ParamRange range;
+        };
+        std::vector<HostBindingSpec> hostBindings;
+        std::vector<GraphSnapshot::HostBinding> resolveHostBindings() const;
+
+        std::vector<GraphCycle> cycles;
+        CycleCallback cycleCallback;
+
+        // Published snapshot (owned here) and the audio thread's view of it
+        std::shared_ptr<const GraphSnapshot> published;
+        std::atomic<const GraphSnapshot *> activeSnapshot{nullptr};
+
+        // Deferred frees: kept until the audio thread completes a block that
+        // started after they were replaced.
+        struct Retired
+        {
+            uint64_t epoch;
+            std::shared_ptr<const GraphSnapshot> snapshot;
+            std::unique_ptr<AudioNodeBase> node;
+            std::shared_ptr<std::atomic<bool>> prepared; // set while `node` may still be preparing
+        };
+        std::vector<Retired> retired;
+        std::atomic<uint64_t> blocksCompleted{0};
+
+        // Buffer pool. New snapshots take `bufferPool`, which an edit
+        // replaces with a larger one (on the message thread) when the
+        // graph needs more buffers than it holds; `segmentBuffers` is the
+        // need of each segment. The audio thread takes buffers from its
+        // snapshot's pool, at the width their node writes, without
+        // reallocating.
+        std::shared_ptr<BufferPool> bufferPool;
+        std::vector<int> segmentBuffers;
+        BufferPool *activeBuffers = nullptr; // audio thread
+        void allocateBufferPool(int numBuffers);
+        BufferRef acquireBuffer(int numChannels, int numSamples);
+        BufferRef broadcast(const juce::AudioBuffer<float> &mono, int numChannels, int numSamples);
+        template <typename Resolve>
+        const float *sumModulation(const GraphSnapshot::Modulation &modulation, int numSamples, Resolve &&resolve);
+        template <typename Resolve>
+        BufferRef sumJunction(const GraphSnapshot::Junction &junction, int numSamples, Resolve &&resolve);
+        template <typename Resolve>
+        void processFusedChain(const GraphSnapshot::NodeEntry &entry, int numSamples, Resolve &&resolve);
+        template <typename Wire>
+        void processBatch(const GraphSnapshot::NodeEntry &entry, int numSamples, Wire &&wire);
+
+        // Parameter updates (any thread -> audio thread); topology changes
+        // are handled by snapshot swap
+        ParamMailbox paramMailbox;
+        void postParams(const GraphOp &op);
+
+        // Nodes added since the last rebuild, prepared together before it
+        std::vector<AudioNodeBase *> unprepared;
+
+        // Nodes being prepared on the worker, by ID. The real node is
+        // already in `nodes`; its vertex runs the placeholder.
+        struct Preparation
+        {
+            std::unique_ptr<AudioNodeBase> placeholder;
+            std::shared_ptr<std::atomic<bool>> done;
+        };
+        std::unordered_map<std::string, Preparation> preparing;
+        bool backgroundPreparation = false;
+        NodePool nodePool;
+        juce::SharedResourcePointer<BackgroundWorker> worker;
+        juce::SharedResourcePointer<PrepareThreads> prepareThreads;
+
+        // Guards the callback, and lets the destructor wait out a job
+        // that is still calling it
+        std::mutex preparedLock;
+        std::function<void()> preparedCallback;
 
         // Audio config
         double currentSampleRate = 44100.0;
         int currentBlockSize = 512;
         int currentNumChannels = 2;
 
-        juce::AudioBuffer<float> *hostInputBuffer = nullptr;
+        // Multi-bus: host buffers for additional input buses (1 = sidechain, ...),
+        // each with a view of the sub-block being processed
+        struct HostInput
+        {
+            juce::AudioBuffer<float> *buffer = nullptr;
+            juce::AudioBuffer<float> view;
+        };
+        std::unordered_map<int, HostInput> hostInputBuffers;
+
+        // Sub-block scheduling (0 = the prepared block size), and the views
+        // of the host block each sub-block is processed through
+        std::atomic<int> subBlockSize{0};
+        juce::AudioBuffer<float> hostView;
+        juce::MidiBuffer subBlockMidi;
 
-        // Multi-bus: additional input bus IDs and their host buffers
-        // Map from bus index (0 = main, 1 = sidechain, ...) to input node ID
-        std::unordered_map<int, std::string> inputNodeIds;
-        std::unordered_map<int, juce::AudioBuffer<float> *> hostInputBuffers;
+        // The main input's channels of the block being processed, when it
+        // is narrower than the output
+        int mainInputChannels = -1;
+        juce::AudioBuffer<float> mainInputView;
     };
 
 } // namespace rau
@@ -0,0 +1,69 @@
+#include "BackgroundWorker.h"
+
+namespace rau
+{
+
+    BackgroundWorker::BackgroundWorker()
+        : thread([this]
+                 { run(); })
+    {
+    }
+
+    BackgroundWorker::~BackgroundWorker()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeUp.notify_all();
+        if (thread.joinable())
+            thread.join();
+    }
+
+    void BackgroundWorker::post(std::function<void()> job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.push_back(std::move(job));
+        }
+        wakeUp.notify_one();
+    }
+
+    void BackgroundWorker::waitUntilIdle()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this]
+                  { return jobs.empty() && !busy; });
+    }
+
+    void BackgroundWorker::run()
+    {
+        for (;;)
+        {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wakeUp.wait(lock, [this]
+                            { return stopping || !jobs.empty(); });
+
+                // Drain remaining jobs before exiting so callers holding
+                // shared state from a job are always completed.
+                if (jobs.empty())
+                    return;
+
+                job = std::move(jobs.front());
+                jobs.pop_front();
+                busy = true;
+            }
+
+            job();
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                busy = false;
+            }
+            idle.notify_all();
+        }
+    }
+
+} // namespace rau
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace rau
+{
+
+    /**
+     * BackgroundWorker — a single low-priority thread for heavy,
+     * non-real-time work (IR decoding/partitioning, node preparation).
+     *
+     * Jobs are posted from the message thread and run in FIFO order.
+     * The audio thread never posts or waits on jobs; results are handed
+     * back through lock-free slots owned by the caller.
+     *
+     * Shared process-wide via juce::SharedResourcePointer so every plugin
+     * instance in a host reuses the same thread, and the thread is joined
+     * when the last holder goes away.
+     */
+    class BackgroundWorker
+    {
+    public:
+        BackgroundWorker();
+        ~BackgroundWorker();
+
+        /** Queue a job. Thread-safe; never call from the audio thread. */
+        void post(std::function<void()> job);
+
+        /** Block until every queued job has finished (tests, shutdown). */
+        void waitUntilIdle();
+
+    private:
+        void run();
+
+        std::mutex mutex;
+        std::condition_variable wakeUp;
+        std::condition_variable idle;
+        std::deque<std::function<void()>> jobs;
+        bool busy = false;
+        bool stopping = false;
+        std::thread thread;
+    };
+
+} // namespace rau
@@ -0,0 +1,255 @@
+#include "GraphState.h"
+#include <unordered_map>
+
+namespace rau
+{
+
+    namespace
+    {
+        // "RAUG", written at both ends so a truncated chunk is rejected
+        constexpr int CHUNK_MAGIC = 0x47554152;
+        constexpr int CHUNK_VERSION = 1;
+
+        void writeRange(juce::MemoryOutputStream &out, const ParamRange &range)
+        {
+            out.writeFloat(range.min);
+            out.writeFloat(range.max);
+            out.writeFloat(range.skew);
+        }
+
+        ParamRange readRange(juce::MemoryInputStream &in)
+        {
+            ParamRange range;
+            range.min = in.readFloat();
+            range.max = in.readFloat();
+            range.skew = in.readFloat();
+            return range;
+        }
+
+        std::string readStdString(juce::MemoryInputStream &in)
+        {
+            return in.readString().toStdString();
+        }
+
+        // Every item takes at least a byte, so a count larger than what's
+        // left can only come from a damaged chunk
+        bool readCount(juce::MemoryInputStream &in, int &count)
+        {
+            count = in.readCompressedInt();
+            return count >= 0 && count <= in.getNumBytesRemaining();
+        }
+    } // namespace
+
+    void GraphState::write(juce::MemoryBlock &dest) const
+    {
+        juce::MemoryOutputStream out(dest, false);
+        out.writeInt(CHUNK_MAGIC);
+        out.writeInt(CHUNK_VERSION);
+
+        out.writeCompressedInt(static_cast<int>(parameters.size()));
+        for (auto &param : parameters)
+        {
+            out.writeString(juce::String(param.id));
+            out.writeCompressedInt(param.slot);
+            writeRange(out, param.range);
+        }
+
+        out.writeCompressedInt(static_cast<int>(bindings.size()));
+        for (auto &binding : bindings)
+        {
+            out.writeString(juce::String(binding.id));
+            out.writeString(juce::String(binding.nodeId));
+            out.writeString(juce::String(binding.paramName));
+            out.writeBool(binding.hasRange);
+            writeRange(out, binding.range);
+        }
+
+        out.writeCompressedInt(static_cast<int>(ops.size()));
+        for (auto &op : ops)
+        {
+            out.writeByte(static_cast<char>(op.type));
+            switch (op.type)
+            {
+            case GraphOp::AddNode:
+                out.writeString(juce::String(op.nodeId));
+                out.writeString(juce::String(op.nodeType));
+                out.writeCompressedInt(static_cast<int>(op.params.size()));
+                for (auto &[name, value] : op.params)
+                {
+                    out.writeString(juce::String(name));
+                    out.writeFloat(value);
+                }
+                break;
+            case GraphOp::Connect:
+                out.writeString(juce::String(op.fromNodeId));
+                out.writeCompressedInt(op.fromOutlet);
+                out.writeString(juce::String(op.toNodeId));
+                out.writeCompressedInt(op.toInlet);
+                out.writeFloat(op.gain);
+                out.writeString(juce::String(op.toParam));
+                out.writeFloat(op.offset);
+                out.writeByte(static_cast<char>(op.curve));
+                break;
+            case GraphOp::SetOutput:
+                out.writeString(juce::String(op.nodeId));
+                break;
+            default:
+                // describeGraph() only builds, so nothing else is saved
+                break;
+            }
+        }
+
+        // IRs shared between convolvers (interned) are written once
+        std::vector<const IRData *> distinct;
+        std::unordered_map<const IRData *, int> indexOf;
+        int numLoaded = 0;
+        for (auto &[nodeId, ir] : impulseResponses)
+        {
+            if (!ir)
+                continue;
+            ++numLoaded;
+            if (indexOf.emplace(ir.get(), static_cast<int>(distinct.size())).second)
+                distinct.push_back(ir.get());
+        }
+
+        out.writeCompressedInt(static_cast<int>(distinct.size()));
+        for (auto *ir : distinct)
+        {
+            out.writeDouble(ir->sampleRate);
+            out.writeCompressedInt(ir->getNumChannels());
+            out.writeCompressedInt(ir->getNumSamples());
+            // Raw little-endian floats, as on every platform we build for
+            for (auto &channel : ir->channels)
+                out.write(channel.data(), channel.size() * sizeof(float));
+        }
+
+        out.writeCompressedInt(numLoaded);
+        for (auto &[nodeId, ir] : impulseResponses)
+        {
+            if (!ir)
+                continue;
+            out.writeString(juce::String(nodeId));
+            out.writeCompressedInt(indexOf[ir.get()]);
+        }
+
+        out.writeInt(CHUNK_MAGIC);
+    }
+
+    bool GraphState::read(const void *data, size_t size)
+    {
+        juce::MemoryInputStream in(data, size, false);
+        if (in.readInt() != CHUNK_MAGIC || in.readInt() != CHUNK_VERSION)
+            return false;
+
+        int count = 0;
+        if (!readCount(in, count))
+            return false;
+        parameters.clear();
+        for (int i = 0; i < count; ++i)
+        {
+            ParameterStore::Registration param;
+            param.id = readStdString(in);
+            param.slot = in.readCompressedInt();
+            param.range = readRange(in);
+            parameters.push_back(std::move(param));
+        }
+
+        if (!readCount(in, count))
+            return false;
+        bindings.clear();
+        for (int i = 0; i < count; ++i)
+        {
+            ParamBinding binding;
+            binding.id = readStdString(in);
+            binding.nodeId = readStdString(in);
+            binding.paramName = readStdString(in);
+            binding.hasRange = in.readBool();
+            binding.range = readRange(in);
+            bindings.push_back(std::move(binding));
+        }
+
+        if (!readCount(in, count))
+            return false;
+        ops.clear();
+        for (int i = 0; i < count; ++i)
+        {
+            GraphOp op;
+            op.type = static_cast<GraphOp::Type>(in.readByte());
+            switch (op.type)
+            {
+            case GraphOp::AddNode:
+            {
+                op.nodeId = readStdString(in);
+                op.nodeType = readStdString(in);
+                int numParams = 0;
+                if (!readCount(in, numParams))
+                    return false;
+                for (int p = 0; p < numParams; ++p)
+                {
+                    auto name = readStdString(in);
+                    op.params[name] = in.readFloat();
+                }
+                break;
+            }
+            case GraphOp::Connect:
+            {
+                op.fromNodeId = readStdString(in);
+                op.fromOutlet = in.readCompressedInt();
+                op.toNodeId = readStdString(in);
+                op.toInlet = in.readCompressedInt();
+                op.gain = in.readFloat();
+                op.toParam = readStdString(in);
+                op.offset = in.readFloat();
+                const int curve = in.readByte();
+                if (curve < 0 || curve > static_cast<int>(ModulationCurve::Logarithmic))
+                    return false;
+                op.curve = static_cast<ModulationCurve>(curve);
+                break;
+            }
+            case GraphOp::SetOutput:
+                op.nodeId = readStdString(in);
+                break;
+            default:
+                return false;
+            }
+            ops.push_back(std::move(op));
+        }
+
+        if (!readCount(in, count))
+            return false;
+        std::vector<std::shared_ptr<const IRData>> distinct;
+        for (int i = 0; i < count; ++i)
+        {
+            auto ir = std::make_shared<IRData>();
+            ir->sampleRate = in.readDouble();
+            const int numChannels = in.readCompressedInt();
+            const int numSamples = in.readCompressedInt();
+            const auto bytes = static_cast<juce::int64>(numChannels) * numSamples * static_cast<juce::int64>(sizeof(float));
+            if (numChannels <= 0 || numSamples <= 0 || bytes > in.getNumBytesRemaining())
+                return false;
+
+            ir->channels.resize(static_cast<size_t>(numChannels));
+            for (auto &channel : ir->channels)
+            {
+                channel.resize(static_cast<size_t>(numSamples));
+                in.read(channel.data(), numSamples * static_cast<int>(sizeof(float)));
+            }
+            distinct.push_back(std::move(ir));
+        }
+
+        if (!readCount(in, count))
+            return false;
+        impulseResponses.clear();
+        for (int i = 0; i < count; ++i)
+        {
+            auto nodeId = readStdString(in);
+            const int index = in.readCompressedInt();
+            if (index < 0 || index >= static_cast<int>(distinct.size()))
+                return false;
+            impulseResponses.emplace_back(std::move(nodeId), distinct[static_cast<size_t>(index)]);
+        }
+
+        return in.readInt() == CHUNK_MAGIC;
+    }
+
+} // namespace rau
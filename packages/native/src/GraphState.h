@@ -0,0 +1,57 @@
+#pragma once
+
+#include "AudioGraph.h"
+#include "ParameterStore.h"
+#include "ParamRange.h"
+#include "dsp/IRCache.h"
+#include <juce_core/juce_core.h>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace rau
+{
+
+    /**
+     * ParamBinding — a host parameter driving a node parameter, as JS
+     * requested it (see AudioGraph::bindHostParam).
+     */
+    struct ParamBinding
+    {
+        std::string id;
+        std::string nodeId;
+        std::string paramName;
+        bool hasRange = false; // else the parameter's own range
+        ParamRange range;
+    };
+
+    /**
+     * GraphState — everything the plugin needs to make sound without the
+     * UI, saved as a binary chunk alongside the host parameters.
+     *
+     * setStateInformation() rebuilds the graph from it straight away, so
+     * a session plays (and renders offline) before any editor has loaded
+     * React. When the UI does start it sends its whole graph, which is
+     * diffed against the restored one (AudioGraph::setGraph), so nodes
+     * with the same ID and type keep their state.
+     *
+     * Each distinct impulse response is stored once, however many
+     * convolvers use it.
+     */
+    struct GraphState
+    {
+        std::vector<ParameterStore::Registration> parameters;
+        std::vector<ParamBinding> bindings;
+        std::vector<GraphOp> ops; // from AudioGraph::describeGraph()
+
+        // Convolver node ID → its loaded IR
+        std::vector<std::pair<std::string, std::shared_ptr<const IRData>>> impulseResponses;
+
+        void write(juce::MemoryBlock &dest) const;
+
+        /** False (leaving this state unspecified) if `data` isn't a valid chunk. */
+        bool read(const void *data, size_t size);
+    };
+
+} // namespace rau
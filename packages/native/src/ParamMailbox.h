@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+
+namespace rau
+{
+
+    /**
+     * ParamMailbox — latest-wins parameter updates for the audio thread.
+     *
+     * Every parameter owns a Slot. Posting overwrites the slot's pending
+     * value and, if the slot wasn't already waiting, pushes it onto a
+     * lock-free change list. deliver() takes the whole list at once and
+     * applies each slot's newest value, so a burst of updates to one
+     * parameter costs the audio thread a single store, and nothing is
+     * ever dropped for lack of room.
+     *
+     * Producers: any number of threads (post() is lock-free)
+     * Consumer:  the audio thread (deliver())
+     *
+     * A slot is on the list at most once, so pushes never race with a
+     * reuse of the same slot and the list needs no ABA protection.
+     */
+    class ParamMailbox
+    {
+    public:
+        struct Slot
+        {
+            std::atomic<float> pending{0.0f};
+            std::atomic<bool> queued{false};
+            Slot *next = nullptr;
+
+            // Where deliver() writes the value
+            std::atomic<float> *target = nullptr;
+        };
+
+        /** Any thread: make `value` the slot's next delivered value. */
+        void post(Slot &slot, float value)
+        {
+            // Sequentially consistent with deliver(): if the slot is still
+            // queued here, deliver() hasn't read `pending` yet
+            slot.pending.store(value, std::memory_order_seq_cst);
+            if (slot.queued.exchange(true, std::memory_order_seq_cst))
+                return; // already waiting; deliver() will read the new value
+
+            Slot *top = changes.load(std::memory_order_relaxed);
+            do
+                slot.next = top;
+            while (!changes.compare_exchange_weak(top, &slot, std::memory_order_release, std::memory_order_relaxed));
+        }
+
+        /**
+         * The value the slot's target will hold once pending posts are
+         * delivered: for readers that shouldn't wait for a block (saved
+         * state while audio is stopped). Only the audio thread writes the
+         * target, so while blocks run this may be a block ahead of it.
+         */
+        static float latest(const Slot &slot)
+        {
+            if (slot.queued.load(std::memory_order_seq_cst))
+                return slot.pending.load(std::memory_order_seq_cst);
+            return slot.target->load(std::memory_order_relaxed);
+        }
+
+        /** Audio thread: apply every slot posted since the last call. */
+        void deliver()
+        {
+            Slot *slot = changes.exchange(nullptr, std::memory_order_acquire);
+            while (slot != nullptr)
+            {
+                // Read the link before releasing the slot: once `queued` is
+                // clear a producer may push it again and rewrite `next`.
+                // Clearing before reading the value means a post that
+                // lands after the read queues the slot for next time.
+                Slot *next = slot->next;
+                slot->queued.store(false, std::memory_order_seq_cst);
+                slot->target->store(slot->pending.load(std::memory_order_seq_cst), std::memory_order_relaxed);
+                slot = next;
+            }
+        }
+
+    private:
+        std::atomic<Slot *> changes{nullptr};
+    };
+
+} // namespace rau
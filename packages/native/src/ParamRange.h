@@ -0,0 +1,59 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <cmath>
+#include <string>
+
+namespace rau
+{
+
+    /**
+     * ParamRange — maps a host parameter's normalised 0–1 value onto
+     * [min, max] with a power skew (1 = linear, <1 = more resolution at
+     * the bottom, >1 = more at the top).
+     *
+     * Shared by ParameterStore (host ↔ JS values) and the graph's host
+     * bindings (host → node parameters on the audio thread).
+     */
+    struct ParamRange
+    {
+        float min = 0.0f;
+        float max = 1.0f;
+        float skew = 1.0f;
+
+        /**
+         * Skew for a curve name:
+         *   "logarithmic" — 0.3 (frequency-style)
+         *   "exponential" — 3.0
+         *   anything else — 1.0 (linear)
+         */
+        static float skewForCurve(const std::string &curve)
+        {
+            if (curve == "logarithmic")
+                return 0.3f;
+            if (curve == "exponential")
+                return 3.0f;
+            return 1.0f;
+        }
+
+        float toNormalised(float actual) const
+        {
+            if (max <= min)
+                return 0.0f;
+            float proportion = (actual - min) / (max - min);
+            if (skew != 1.0f && proportion > 0.0f)
+                proportion = std::pow(proportion, 1.0f / skew);
+            return juce::jlimit(0.0f, 1.0f, proportion);
+        }
+
+        // Real-time safe
+        float toActual(float normalised) const
+        {
+            float proportion = juce::jlimit(0.0f, 1.0f, normalised);
+            if (skew != 1.0f && proportion > 0.0f)
+                proportion = std::pow(proportion, skew);
+            return min + proportion * (max - min);
+        }
+    };
+
+} // namespace rau
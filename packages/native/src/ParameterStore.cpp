@@ -6,24 +6,6 @@ namespace rau
 
     ParameterStore::ParameterStore(juce::AudioProcessor & /*proc*/) {}
 
-    float ParameterStore::actualToNormalized(const RangeInfo &r, float actual) const
-    {
-        if (r.max <= r.min)
-            return 0.0f;
-        float proportion = (actual - r.min) / (r.max - r.min);
-        if (r.skew != 1.0f && proportion > 0.0f)
-            proportion = std::pow(proportion, 1.0f / r.skew);
-        return juce::jlimit(0.0f, 1.0f, proportion);
-    }
-
-    float ParameterStore::normalizedToActual(const RangeInfo &r, float normalized) const
-    {
-        float proportion = juce::jlimit(0.0f, 1.0f, normalized);
-        if (r.skew != 1.0f && proportion > 0.0f)
-            proportion = std::pow(proportion, r.skew);
-        return r.min + proportion * (r.max - r.min);
-    }
-
     ParameterStore::~ParameterStore()
     {
         if (apvts)
@@ -64,7 +46,7 @@ namespace rau
                                            float defaultValue, const std::string &label,
                                            const std::string &curve)
     {
-        if (!apvts || idToSlot.count(id))
+        if (!apvts || idToSlot.count(id) || nextSlot >= MAX_PARAMS)
             return;
 
         // Assign the next available slot
@@ -78,21 +60,15 @@ namespace rau
         // We flip convention to match user expectations:
         //   "logarithmic" → skew 0.3 (frequency-style, more at bottom)
         //   "exponential" → skew 3.0 (more at top)
-        float skew = 1.0f;
-        if (curve == "logarithmic")
-            skew = 0.3f;
-        else if (curve == "exponential")
-            skew = 3.0f;
-
         // Store the range mapping with skew for this parameter
-        rangeMap[slotId] = {min, max, skew};
+        rangeMap[slotId] = {min, max, ParamRange::skewForCurve(curve)};
 
         nextSlot++;
 
         // Set the normalized default value (applying skew)
         if (auto *param = apvts->getParameter(slotId))
         {
-            float normalizedDefault = actualToNormalized(rangeMap[slotId], defaultValue);
+            float normalizedDefault = rangeMap[slotId].toNormalised(defaultValue);
             param->setValueNotifyingHost(normalizedDefault);
         }
 
@@ -144,7 +120,7 @@ namespace rau
             auto rangeIt = rangeMap.find(it->second);
             if (rangeIt != rangeMap.end())
             {
-                param->setValueNotifyingHost(actualToNormalized(rangeIt->second, value));
+                param->setValueNotifyingHost(rangeIt->second.toNormalised(value));
             }
             else
             {
@@ -165,36 +141,106 @@ namespace rau
             auto rangeIt = rangeMap.find(it->second);
             if (rangeIt != rangeMap.end())
             {
-                return normalizedToActual(rangeIt->second, normalized);
+                return rangeIt->second.toActual(normalized);
             }
             return normalized;
         }
         return 0.0f;
     }
 
-    void ParameterStore::onParameterChanged(std::function<void(const std::string &, float)> callback)
+    ParameterStore::HostSource ParameterStore::getHostSource(const std::string &id) const
     {
-        changeCallback = std::move(callback);
+        auto it = idToSlot.find(id);
+        if (it == idToSlot.end() || !apvts)
+            return {};
+
+        // Slots are 0–1 AudioParameterFloats, so the raw value is the
+        // normalised one
+        HostSource source;
+        source.value = apvts->getRawParameterValue(it->second);
+        auto rangeIt = rangeMap.find(it->second);
+        if (rangeIt != rangeMap.end())
+            source.range = rangeIt->second;
+        return source;
     }
 
-    void ParameterStore::parameterChanged(const juce::String &parameterID, float newValue)
+    void ParameterStore::takeChanges(const std::function<void(const std::string &, float)> &visit)
     {
-        if (changeCallback)
+        for (int word = 0; word < MAX_PARAMS / 64; ++word)
         {
-            auto it = slotToId.find(parameterID.toStdString());
-            if (it != slotToId.end())
+            auto bits = changedSlots[static_cast<size_t>(word)].exchange(0, std::memory_order_acquire);
+            while (bits != 0)
             {
-                auto rangeIt = rangeMap.find(parameterID.toStdString());
-                float actualValue = newValue;
+                int bit = 0;
+                while ((bits & (uint64_t{1} << bit)) == 0)
+                    ++bit;
+                bits &= ~(uint64_t{1} << bit);
+
+                // A slot freed since it changed has no ID any more
+                const int slot = word * 64 + bit;
+                auto slotId = "param_" + juce::String(slot).paddedLeft('0', 3).toStdString();
+                auto it = slotToId.find(slotId);
+                if (it == slotToId.end())
+                    continue;
+
+                float value = changedValues[static_cast<size_t>(slot)].load(std::memory_order_relaxed);
+                auto rangeIt = rangeMap.find(slotId);
                 if (rangeIt != rangeMap.end())
-                {
-                    actualValue = normalizedToActual(rangeIt->second, newValue);
-                }
-                changeCallback(it->second, actualValue);
+                    value = rangeIt->second.toActual(value);
+                visit(it->second, value);
             }
         }
     }
 
+    void ParameterStore::parameterChanged(const juce::String &parameterID, float newValue)
+    {
+        // Often the audio thread: no allocation, no locks, no map lookups.
+        // Later changes to a slot overwrite earlier ones until the next
+        // takeChanges().
+        const int slot = parameterID.getTrailingIntValue();
+        if (slot < 0 || slot >= MAX_PARAMS)
+            return;
+
+        changedValues[static_cast<size_t>(slot)].store(newValue, std::memory_order_relaxed);
+        changedSlots[static_cast<size_t>(slot / 64)].fetch_or(uint64_t{1} << (slot % 64), std::memory_order_release);
+    }
+
+    std::vector<ParameterStore::Registration> ParameterStore::getRegistrations() const
+    {
+        std::vector<Registration> registrations;
+        registrations.reserve(idToSlot.size());
+        for (auto &[jsId, slotId] : idToSlot)
+        {
+            Registration registration;
+            registration.id = jsId;
+            registration.slot = juce::String(slotId).getTrailingIntValue();
+            auto rangeIt = rangeMap.find(slotId);
+            if (rangeIt != rangeMap.end())
+                registration.range = rangeIt->second;
+            registrations.push_back(std::move(registration));
+        }
+        return registrations;
+    }
+
+    void ParameterStore::restoreRegistration(const Registration &registration)
+    {
+        if (!apvts || registration.slot < 0 || registration.slot >= MAX_PARAMS || idToSlot.count(registration.id))
+            return;
+
+        auto slotId = "param_" + juce::String(registration.slot).paddedLeft('0', 3).toStdString();
+        if (slotToId.count(slotId))
+            return;
+
+        idToSlot[registration.id] = slotId;
+        slotToId[slotId] = registration.id;
+        rangeMap[slotId] = registration.range;
+
+        // Slots are never recycled, so new registrations go after it
+        nextSlot = juce::jmax(nextSlot, registration.slot + 1);
+
+        apvts->addParameterListener(slotId, this);
+    }
+
     std::string ParameterStore::getStateAsJson() const
     {
         // Simple JSON serialization of all registered parameters
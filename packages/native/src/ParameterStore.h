@@ -1,9 +1,14 @@
 #pragma once
 
 #include <juce_audio_processors/juce_audio_processors.h>
+#include "ParamRange.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <unordered_map>
 #include <string>
 #include <functional>
+#include <vector>
 
 namespace rau
 {
@@ -15,10 +20,16 @@ namespace rau
      * juce::AudioParameterFloat added to the processor. Changes
      * from the DAW (automation) are forwarded to JS; changes from
      * JS (UI) are forwarded to the DAW.
+     *
+     * Hosts report automation on the audio thread, so a change only
+     * stores the slot's value and sets its dirty bit. The message thread
+     * collects them with takeChanges(), once per UI frame.
      */
     class ParameterStore : public juce::AudioProcessorValueTreeState::Listener
     {
     public:
+        static constexpr int MAX_PARAMS = 128;
+
         explicit ParameterStore(juce::AudioProcessor &processor);
         ~ParameterStore() override;
 
@@ -50,22 +61,55 @@ namespace rau
         float getParameterValue(const std::string &id) const;
 
         /**
-         * Set a callback invoked when the DAW changes a parameter
-         * (automation, MIDI learn, etc.).
+         * The normalised value the host automates for a parameter, and the
+         * range it maps onto. The audio thread may read `value` at any
+         * time; it's null if the parameter isn't registered.
          */
-        void onParameterChanged(std::function<void(const std::string &id, float value)> callback);
+        struct HostSource
+        {
+            const std::atomic<float> *value = nullptr;
+            ParamRange range;
+        };
+        HostSource getHostSource(const std::string &id) const;
+
+        /**
+         * Report each parameter changed since the last call (automation,
+         * MIDI learn, UI writes echoed by the host) once, with its latest
+         * value. Message thread.
+         */
+        void takeChanges(const std::function<void(const std::string &id, float value)> &visit);
 
         /**
          * Create the APVTS parameter layout. Call this during processor construction.
          * Pre-allocates generic parameter slots.
          */
-        static juce::AudioProcessorValueTreeState::ParameterLayout createLayout(int maxParams = 128);
+        static juce::AudioProcessorValueTreeState::ParameterLayout createLayout(int maxParams = MAX_PARAMS);
 
         /**
          * Bind the APVTS to this store after processor construction.
          */
         void bindAPVTS(juce::AudioProcessorValueTreeState &apvts);
 
+        /**
+         * A registered parameter and the host slot it was given. Saved with
+         * the plugin state so a session reloads with every parameter on the
+         * slot its automation targets, before (or without) the UI.
+         */
+        struct Registration
+        {
+            std::string id;
+            int slot = 0;
+            ParamRange range;
+        };
+        std::vector<Registration> getRegistrations() const;
+
+        /**
+         * Re-register a saved parameter on its original slot, keeping the
+         * slot's current value. Skipped if the ID or the slot is taken; a
+         * later registerParameter() for the ID is then a no-op.
+         */
+        void restoreRegistration(const Registration &registration);
+
         /** Get the current state as a JSON string. */
         std::string getStateAsJson() const;
 
@@ -83,19 +127,11 @@ namespace rau
         int nextSlot = 0;
 
         // Range mapping: slot ID → {min, max, skewFactor}
-        struct RangeInfo
-        {
-            float min = 0.0f;
-            float max = 1.0f;
-            float skew = 1.0f; // 1.0 = linear, <1 = log, >1 = exp
-        };
-        std::unordered_map<std::string, RangeInfo> rangeMap;
-
-        // Convert between actual and normalized, applying skew
-        float actualToNormalized(const RangeInfo &r, float actual) const;
-        float normalizedToActual(const RangeInfo &r, float normalized) const;
+        std::unordered_map<std::string, ParamRange> rangeMap;
 
-        std::function<void(const std::string &, float)> changeCallback;
+        // Written from any thread by parameterChanged(); indexed by slot
+        std::array<std::atomic<float>, MAX_PARAMS> changedValues{};
+        std::array<std::atomic<uint64_t>, MAX_PARAMS / 64> changedSlots{};
     };
 
 } // namespace rau
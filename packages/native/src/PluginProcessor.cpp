@@ -1,5 +1,6 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "nodes/ConvolverNode.h"
 #include "nodes/MeterNode.h"
 #include "nodes/SpectrumNode.h"
 #include <juce_core/juce_core.h>
@@ -91,6 +92,16 @@ namespace rau
             return 0.0f;
         }
 
+        // Reverb engine
+        if (paramName == "engine")
+        {
+            if (value == "freeverb")
+                return 0.0f;
+            if (value == "fdn")
+                return 1.0f;
+            return 0.0f;
+        }
+
         // Meter type
         if (paramName == "meterType")
         {
@@ -103,6 +114,18 @@ namespace rau
             return 0.0f;
         }
 
+        // Delay line / IR storage
+        if (paramName == "storage")
+        {
+            if (value == "float32")
+                return 0.0f;
+            if (value == "float16")
+                return 1.0f;
+            if (value == "bfloat16")
+                return 2.0f;
+            return 0.0f;
+        }
+
         // Unknown string param — try to parse as number, fallback to 0
         return value.getFloatValue();
     }
@@ -119,6 +142,104 @@ namespace rau
         return static_cast<float>(value);
     }
 
+    /** `text` as a JSON string literal, with quotes and backslashes escaped. */
+    static juce::String toJsonString(const juce::String &text)
+    {
+        return juce::JSON::toString(juce::var(text));
+    }
+
+    /** Parse an array of JS graph ops, skipping any it doesn't recognise. */
+    static std::vector<GraphOp> parseGraphOps(const juce::var &ops)
+    {
+        std::vector<GraphOp> batch;
+        auto *opsArray = ops.getArray();
+        if (opsArray == nullptr)
+            return batch;
+        batch.reserve(static_cast<size_t>(opsArray->size()));
+
+        for (auto &opVar : *opsArray)
+        {
+            GraphOp graphOp;
+            auto opType = opVar.getProperty("op", "").toString();
+
+            if (opType == "addNode")
+            {
+                graphOp.type = GraphOp::AddNode;
+                graphOp.nodeId = opVar.getProperty("nodeId", "").toString().toStdString();
+                graphOp.nodeType = opVar.getProperty("nodeType", "").toString().toStdString();
+
+                if (auto *params = opVar.getProperty("params", juce::var()).getDynamicObject())
+                {
+                    for (auto &prop : params->getProperties())
+                    {
+                        graphOp.params[prop.name.toString().toStdString()] =
+                            varToFloat(prop.name, prop.value);
+                    }
+                }
+            }
+            else if (opType == "removeNode")
+            {
+                graphOp.type = GraphOp::RemoveNode;
+                graphOp.nodeId = opVar.getProperty("nodeId", "").toString().toStdString();
+            }
+            else if (opType == "updateParams")
+            {
+                graphOp.type = GraphOp::UpdateParams;
+                graphOp.nodeId = opVar.getProperty("nodeId", "").toString().toStdString();
+
+                if (auto *params = opVar.getProperty("params", juce::var()).getDynamicObject())
+                {
+                    for (auto &prop : params->getProperties())
+                    {
+                        graphOp.params[prop.name.toString().toStdString()] =
+                            varToFloat(prop.name, prop.value);
+                    }
+                }
+            }
+            else if (opType == "connect")
+            {
+                graphOp.type = GraphOp::Connect;
+                auto from = opVar.getProperty("from", juce::var());
+                auto to = opVar.getProperty("to", juce::var());
+                graphOp.fromNodeId = from.getProperty("nodeId", "").toString().toStdString();
+                graphOp.fromOutlet = from.getProperty("outlet", 0);
+                graphOp.toNodeId = to.getProperty("nodeId", "").toString().toStdString();
+                graphOp.toInlet = to.getProperty("inlet", 0);
+                graphOp.toParam = to.getProperty("param", "").toString().toStdString();
+                graphOp.gain = static_cast<float>(opVar.getProperty("gain", 1.0));
+                graphOp.offset = static_cast<float>(opVar.getProperty("offset", 0.0));
+                auto curve = opVar.getProperty("curve", "linear").toString();
+                if (curve == "exponential")
+                    graphOp.curve = ModulationCurve::Exponential;
+                else if (curve == "logarithmic")
+                    graphOp.curve = ModulationCurve::Logarithmic;
+            }
+            else if (opType == "disconnect")
+            {
+                graphOp.type = GraphOp::Disconnect;
+                auto from = opVar.getProperty("from", juce::var());
+                auto to = opVar.getProperty("to", juce::var());
+                graphOp.fromNodeId = from.getProperty("nodeId", "").toString().toStdString();
+                graphOp.fromOutlet = from.getProperty("outlet", 0);
+                graphOp.toNodeId = to.getProperty("nodeId", "").toString().toStdString();
+                graphOp.toInlet = to.getProperty("inlet", 0);
+                graphOp.toParam = to.getProperty("param", "").toString().toStdString();
+            }
+            else if (opType == "setOutput")
+            {
+                graphOp.type = GraphOp::SetOutput;
+                graphOp.nodeId = opVar.getProperty("nodeId", "").toString().toStdString();
+            }
+            else
+            {
+                continue;
+            }
+
+            batch.push_back(std::move(graphOp));
+        }
+        return batch;
+    }
+
     // ---------------------------------------------------------------------------
     // Constructor / Destructor
     // ---------------------------------------------------------------------------
@@ -133,14 +254,51 @@ namespace rau
     {
         paramStore.bindAPVTS(apvts);
 
-        // When the DAW changes a parameter, notify JS
-        paramStore.onParameterChanged([this](const std::string &id, float value)
-                                      {
-        juce::String json = "{\"type\":\"parameterChanged\",\"id\":\"" +
-                            juce::String(id) + "\",\"value\":" +
-                            juce::String(value) + "}";
+        // Tell JS which parameters the DAW changed, once per UI frame. While
+        // the editor is closed changes keep coalescing until it opens.
+        webViewBridge.onBeforeFlush([this]
+                                    {
+        juce::String json;
+        paramStore.takeChanges([&](const std::string &id, float value)
+                               {
+            json += (json.isEmpty() ? "{\"type\":\"parametersChanged\",\"values\":{" : ",");
+            json += toJsonString(id) + ":" + juce::String(value); });
+        if (json.isNotEmpty())
+            webViewBridge.sendToJS(json + "}}"); });
+
+        // Tell JS when the graph gains or loses feedback loops
+        audioGraph.onCyclesChanged([this](const std::vector<GraphCycle> &cycles)
+                                   {
+        juce::String json = "{\"type\":\"graphCycles\",\"cycles\":[";
+        for (size_t i = 0; i < cycles.size(); ++i)
+        {
+            if (i > 0)
+                json += ",";
+            json += "{\"nodeIds\":[";
+            for (size_t n = 0; n < cycles[i].nodeIds.size(); ++n)
+                json += (n > 0 ? "," : "") + toJsonString(cycles[i].nodeIds[n]);
+            json += "],\"feedback\":[";
+            for (size_t c = 0; c < cycles[i].feedbackConnections.size(); ++c)
+            {
+                auto &conn = cycles[i].feedbackConnections[c];
+                json += juce::String(c > 0 ? "," : "") +
+                        "{\"from\":{\"nodeId\":" + toJsonString(conn.fromNodeId) +
+                        ",\"outlet\":" + juce::String(conn.fromOutlet) +
+                        "},\"to\":{\"nodeId\":" + toJsonString(conn.toNodeId) +
+                        ",\"inlet\":" + juce::String(conn.toInlet) +
+                        (conn.toParam.empty() ? juce::String() : ",\"param\":" + toJsonString(conn.toParam)) + "}}";
+            }
+            json += "]}";
+        }
+        json += "]}";
         webViewBridge.sendToJS(json); });
 
+        // Delays and reverbs added from the UI are prepared off the message
+        // thread; they start once the worker is done with them
+        audioGraph.setBackgroundPreparation(true);
+        audioGraph.onNodePrepared([this]
+                                  { preparedNodesUpdater.triggerAsyncUpdate(); });
+
         // Listen for messages from JS (via the event listener registered in createWebViewOptions)
         webViewBridge.onMessageFromJS([this](const juce::String &json)
                                       { handleJSMessage(json); });
@@ -149,6 +307,8 @@ namespace rau
     PluginProcessor::~PluginProcessor()
     {
         analysisTimer.stopTimer();
+        audioGraph.onNodePrepared(nullptr);
+        preparedNodesUpdater.cancelPendingUpdate();
     }
 
     // ---------------------------------------------------------------------------
@@ -157,7 +317,12 @@ namespace rau
 
     void PluginProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
     {
-        audioGraph.prepare(sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+        {
+            std::lock_guard<std::recursive_mutex> lock(graphLock);
+            audioGraph.prepare(sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+        }
+        sidechainBuffer.setSize(getChannelCountOfBus(true, 1), samplesPerBlock);
+        pieceMidi.ensureSize(4096);
 
         // Notify JS of audio config
         webViewBridge.sendToJS("{\"type\":\"sampleRate\",\"value\":" +
@@ -171,18 +336,18 @@ namespace rau
 
     bool PluginProcessor::isBusesLayoutSupported(const BusesLayout &layouts) const
     {
-        // Main input/output must be stereo (or mono)
+        // Main output can be anything from mono up to 7.1.4
         auto mainIn = layouts.getMainInputChannelSet();
         auto mainOut = layouts.getMainOutputChannelSet();
 
-        if (mainOut != juce::AudioChannelSet::stereo() &&
-            mainOut != juce::AudioChannelSet::mono())
+        if (mainOut.isDisabled() || mainOut.size() > MAX_LAYOUT_CHANNELS)
             return false;
 
-        // Input can be disabled (instrument) or mono/stereo
+        // Input can be disabled (instrument), mono/stereo, or match the output
         if (!mainIn.isDisabled() &&
             mainIn != juce::AudioChannelSet::stereo() &&
-            mainIn != juce::AudioChannelSet::mono())
+            mainIn != juce::AudioChannelSet::mono() &&
+            mainIn != mainOut)
             return false;
 
         // Sidechain (bus index 1) can be disabled, mono, or stereo
@@ -288,24 +453,52 @@ namespace rau
             webViewBridge.sendToJS(midiJson);
         }
 
-        // Pass sidechain bus buffer to the graph (bus index 1)
+        // The graph writes the whole main output bus. Its first channels
+        // hold the main input, which may be narrower (mono, or disabled for
+        // an instrument); the sidechain's channels follow the main input's,
+        // so a wider output overlaps them.
+        auto mainBuffer = getBusBuffer(buffer, false, 0);
+        const int mainInputChannels = juce::jmin(getMainBusNumInputChannels(), mainBuffer.getNumChannels());
+
+        // Pass sidechain bus buffer to the graph (bus index 1). The alias
+        // lives until the graph is done with it.
         auto sidechainBus = getBus(true, 1);
-        if (sidechainBus && sidechainBus->isEnabled())
+        const bool sidechainEnabled = sidechainBus && sidechainBus->isEnabled();
+        auto scBuffer = sidechainEnabled ? getBusBuffer(buffer, true, 1) : juce::AudioBuffer<float>();
+        const int numSamples = buffer.getNumSamples();
+
+        if (!sidechainEnabled || mainInputChannels == mainBuffer.getNumChannels())
         {
-            auto scBuffer = getBusBuffer(buffer, true, 1);
-            audioGraph.setHostInputBuffer(1, &scBuffer);
+            audioGraph.setHostInputBuffer(1, sidechainEnabled ? &scBuffer : nullptr);
+
+            // Output channels past the main input start silent
+            for (int ch = mainInputChannels; ch < mainBuffer.getNumChannels(); ++ch)
+                mainBuffer.clear(ch, 0, numSamples);
+
+            audioGraph.processBlock(mainBuffer, midi, mainInputChannels);
+            return;
         }
-        else
+
+        // Copy the sidechain out before the output channels are cleared,
+        // into the copy prepareToPlay() sized, so a prepared block at a time
+        const int scChannels = juce::jmin(scBuffer.getNumChannels(), sidechainBuffer.getNumChannels());
+        const int pieceSize = juce::jmax(1, sidechainBuffer.getNumSamples());
+        audioGraph.setHostInputBuffer(1, &sidechainView);
+        for (int start = 0; start < numSamples; start += pieceSize)
         {
-            audioGraph.setHostInputBuffer(1, nullptr);
+            const int length = juce::jmin(pieceSize, numSamples - start);
+            for (int ch = 0; ch < scChannels; ++ch)
+                sidechainBuffer.copyFrom(ch, 0, scBuffer, ch, start, length);
+            sidechainView.setDataToReferTo(sidechainBuffer.getArrayOfWritePointers(), scChannels, 0, length);
+
+            mainView.setDataToReferTo(mainBuffer.getArrayOfWritePointers(), mainBuffer.getNumChannels(), start, length);
+            for (int ch = mainInputChannels; ch < mainView.getNumChannels(); ++ch)
+                mainView.clear(ch, 0, length);
+
+            pieceMidi.clear();
+            pieceMidi.addEvents(midi, start, length, -start);
+            audioGraph.processBlock(mainView, pieceMidi, mainInputChannels);
         }
-
-        // Process the audio graph using only the main bus buffer.
-        // getBusBuffer returns a lightweight alias into `buffer` covering
-        // only the main stereo channels, so sidechain channels are not
-        // accidentally treated as main I/O.
-        auto mainBuffer = getBusBuffer(buffer, true, 0);
-        audioGraph.processBlock(mainBuffer, midi);
     }
 
     // ---------------------------------------------------------------------------
@@ -314,6 +507,8 @@ namespace rau
 
     void PluginProcessor::sendAnalysisData()
     {
+        std::lock_guard<std::recursive_mutex> lock(graphLock);
+
         // Forward meter data
         auto meterNodes = audioGraph.getNodesByType("meter");
         for (auto *node : meterNodes)
@@ -387,6 +582,24 @@ namespace rau
         auto jsState = paramStore.getStateAsJson();
         state.setProperty("rau_js_state", juce::String(jsState), nullptr);
 
+        // The graph itself, so a reloaded session plays before the UI exists
+        GraphState graph;
+        {
+            std::lock_guard<std::recursive_mutex> lock(graphLock);
+            graph.parameters = paramStore.getRegistrations();
+            graph.bindings = paramBindings;
+            graph.ops = audioGraph.describeGraph();
+            for (auto *node : audioGraph.getNodesByType("convolver"))
+            {
+                if (auto *convolver = dynamic_cast<ConvolverNode *>(node))
+                    graph.impulseResponses.emplace_back(node->nodeId, convolver->getIR());
+            }
+        }
+
+        juce::MemoryBlock graphChunk;
+        graph.write(graphChunk);
+        state.setProperty("rau_graph", graphChunk.toBase64Encoding(), nullptr);
+
         std::unique_ptr<juce::XmlElement> xml(state.createXml());
         if (xml)
         {
@@ -399,8 +612,21 @@ namespace rau
         auto xml = getXmlFromBinary(data, sizeInBytes);
         if (xml && xml->hasTagName(apvts.state.getType()))
         {
+            std::lock_guard<std::recursive_mutex> lock(graphLock);
             auto newState = juce::ValueTree::fromXml(*xml);
 
+            // Parameters go back on their saved slots first, so the values
+            // below land where automation expects them
+            GraphState graph;
+            juce::MemoryBlock graphChunk;
+            const bool hasGraph = graphChunk.fromBase64Encoding(newState.getProperty("rau_graph", "").toString()) &&
+                                  graph.read(graphChunk.getData(), graphChunk.getSize());
+            if (hasGraph)
+            {
+                for (auto &param : graph.parameters)
+                    paramStore.restoreRegistration(param);
+            }
+
             // Restore JS-side state if present
             auto jsStateStr = newState.getProperty("rau_js_state", "").toString();
             if (jsStateStr.isNotEmpty())
@@ -413,13 +639,63 @@ namespace rau
             }
 
             apvts.replaceState(newState);
+
+            if (hasGraph)
+                restoreGraphState(graph);
         }
     }
 
+    void PluginProcessor::restoreGraphState(const GraphState &state)
+    {
+        // Bindings first: nodes created below start at their host value
+        for (auto &binding : state.bindings)
+            setParamBinding(binding);
+
+        // A restored session must sound right from its first block (an
+        // offline render may start straight away), so its nodes are
+        // prepared before this returns
+        audioGraph.setBackgroundPreparation(false);
+        audioGraph.setGraph(state.ops);
+        audioGraph.setBackgroundPreparation(true);
+
+        // The same goes for IRs: their engines are built before this returns
+        for (auto &[nodeId, ir] : state.impulseResponses)
+        {
+            if (auto *convolver = dynamic_cast<ConvolverNode *>(audioGraph.getNode(nodeId)))
+                convolver->loadIRSync(*ir);
+        }
+
+        // A running UI diffs against the graph it last sent, which this
+        // replaced; it resends the whole graph
+        webViewBridge.sendToJS("{\"type\":\"graphRestored\"}");
+    }
+
     // ---------------------------------------------------------------------------
     // JS message handling
     // ---------------------------------------------------------------------------
 
+    void PluginProcessor::applyParamBinding(const ParamBinding &binding)
+    {
+        // Waits for the parameter to be registered
+        auto source = paramStore.getHostSource(binding.id);
+        if (source.value == nullptr)
+            return;
+
+        audioGraph.bindHostParam(binding.nodeId, binding.paramName, source.value,
+                                 binding.hasRange ? binding.range : source.range);
+    }
+
+    void PluginProcessor::setParamBinding(const ParamBinding &binding)
+    {
+        auto it = std::find_if(paramBindings.begin(), paramBindings.end(), [&](const ParamBinding &b)
+                               { return b.nodeId == binding.nodeId && b.paramName == binding.paramName; });
+        if (it != paramBindings.end())
+            *it = binding;
+        else
+            paramBindings.push_back(binding);
+        applyParamBinding(binding);
+    }
+
     void PluginProcessor::handleJSMessage(const juce::String &json)
     {
         // Parse JSON — using JUCE's JSON parser
@@ -427,92 +703,21 @@ namespace rau
         if (parsed.isVoid())
             return;
 
+        std::lock_guard<std::recursive_mutex> lock(graphLock);
+
         auto type = parsed.getProperty("type", "").toString();
 
         if (type == "graphOps")
         {
             // Array of graph operations — batched so the snapshot is rebuilt
             // only once after all ops are applied (avoids intermediate states).
-            auto ops = parsed.getProperty("ops", juce::var());
-            if (auto *opsArray = ops.getArray())
-            {
-                std::vector<GraphOp> batch;
-                batch.reserve(static_cast<size_t>(opsArray->size()));
-
-                for (auto &opVar : *opsArray)
-                {
-                    GraphOp graphOp;
-                    auto opType = opVar.getProperty("op", "").toString();
-
-                    if (opType == "addNode")
-                    {
-                        graphOp.type = GraphOp::AddNode;
-                        graphOp.nodeId = opVar.getProperty("nodeId", "").toString().toStdString();
-                        graphOp.nodeType = opVar.getProperty("nodeType", "").toString().toStdString();
-
-                        if (auto *params = opVar.getProperty("params", juce::var()).getDynamicObject())
-                        {
-                            for (auto &prop : params->getProperties())
-                            {
-                                graphOp.params[prop.name.toString().toStdString()] =
-                                    varToFloat(prop.name, prop.value);
-                            }
-                        }
-                    }
-                    else if (opType == "removeNode")
-                    {
-                        graphOp.type = GraphOp::RemoveNode;
-                        graphOp.nodeId = opVar.getProperty("nodeId", "").toString().toStdString();
-                    }
-                    else if (opType == "updateParams")
-                    {
-                        graphOp.type = GraphOp::UpdateParams;
-                        graphOp.nodeId = opVar.getProperty("nodeId", "").toString().toStdString();
-
-                        if (auto *params = opVar.getProperty("params", juce::var()).getDynamicObject())
-                        {
-                            for (auto &prop : params->getProperties())
-                            {
-                                graphOp.params[prop.name.toString().toStdString()] =
-                                    varToFloat(prop.name, prop.value);
-                            }
-                        }
-                    }
-                    else if (opType == "connect")
-                    {
-                        graphOp.type = GraphOp::Connect;
-                        auto from = opVar.getProperty("from", juce::var());
-                        auto to = opVar.getProperty("to", juce::var());
-                        graphOp.fromNodeId = from.getProperty("nodeId", "").toString().toStdString();
-                        graphOp.fromOutlet = from.getProperty("outlet", 0);
-                        graphOp.toNodeId = to.getProperty("nodeId", "").toString().toStdString();
-                        graphOp.toInlet = to.getProperty("inlet", 0);
-                    }
-                    else if (opType == "disconnect")
-                    {
-                        graphOp.type = GraphOp::Disconnect;
-                        auto from = opVar.getProperty("from", juce::var());
-                        auto to = opVar.getProperty("to", juce::var());
-                        graphOp.fromNodeId = from.getProperty("nodeId", "").toString().toStdString();
-                        graphOp.fromOutlet = from.getProperty("outlet", 0);
-                        graphOp.toNodeId = to.getProperty("nodeId", "").toString().toStdString();
-                        graphOp.toInlet = to.getProperty("inlet", 0);
-                    }
-                    else if (opType == "setOutput")
-                    {
-                        graphOp.type = GraphOp::SetOutput;
-                        graphOp.nodeId = opVar.getProperty("nodeId", "").toString().toStdString();
-                    }
-                    else
-                    {
-                        continue;
-                    }
-
-                    batch.push_back(std::move(graphOp));
-                }
-
-                audioGraph.queueOps(std::move(batch));
-            }
+            audioGraph.queueOps(parseGraphOps(parsed.getProperty("ops", juce::var())));
+        }
+        else if (type == "setGraph")
+        {
+            // The whole graph (addNode/connect/setOutput ops building it from
+            // empty), diffed natively so unchanged nodes keep their state
+            audioGraph.setGraph(parseGraphOps(parsed.getProperty("ops", juce::var())));
         }
         else if (type == "paramUpdate")
         {
@@ -532,12 +737,90 @@ namespace rau
             auto label = config.getProperty("label", "").toString().toStdString();
             auto curve = config.getProperty("curve", "linear").toString().toStdString();
             paramStore.registerParameter(id, min, max, def, label, curve);
+
+            // Bindings can arrive first (a child's effects run before its
+            // parent's)
+            for (auto &binding : paramBindings)
+                if (binding.id == id)
+                    applyParamBinding(binding);
         }
         else if (type == "unregisterParameter")
         {
             auto id = parsed.getProperty("id", "").toString().toStdString();
+            audioGraph.unbindHostSource(paramStore.getHostSource(id).value);
             paramStore.unregisterParameter(id);
         }
+        else if (type == "bindParameter")
+        {
+            // Host automation drives a node parameter natively; JS still
+            // hears about changes through parametersChanged
+            ParamBinding binding;
+            binding.id = parsed.getProperty("id", "").toString().toStdString();
+            binding.nodeId = parsed.getProperty("nodeId", "").toString().toStdString();
+            binding.paramName = parsed.getProperty("paramName", "").toString().toStdString();
+
+            // An explicit range maps the host value onto the node parameter
+            // with its own curve; otherwise the parameter's range applies
+            auto range = parsed.getProperty("range", juce::var());
+            if (range.isObject())
+            {
+                binding.hasRange = true;
+                binding.range.min = range.getProperty("min", 0.0f);
+                binding.range.max = range.getProperty("max", 1.0f);
+                binding.range.skew = ParamRange::skewForCurve(
+                    range.getProperty("curve", "linear").toString().toStdString());
+            }
+
+            setParamBinding(binding);
+        }
+        else if (type == "prewarmNodes")
+        {
+            // Spare nodes of a type, prepared now so later adds don't allocate
+            auto nodeType = parsed.getProperty("nodeType", "").toString().toStdString();
+            int count = parsed.getProperty("count", 0);
+            audioGraph.prewarmNodes(nodeType, juce::jlimit(0, 256, count));
+        }
+        else if (type == "setMemoryBudget")
+        {
+            // 0 lifts the cap
+            const double bytes = parsed.getProperty("bytes", 0.0);
+            audioGraph.setMemoryBudget(static_cast<size_t>(juce::jmax(0.0, bytes)));
+        }
+        else if (type == "getMemoryReport")
+        {
+            auto toJson = [](size_t bytes)
+            { return juce::String(static_cast<juce::uint64>(bytes)); };
+
+            const auto report = audioGraph.getMemoryReport();
+            juce::String json = "{\"type\":\"memoryReport\",\"total\":" + toJson(report.inUse) +
+                                ",\"reserved\":" + toJson(report.reserved) +
+                                ",\"budget\":" + toJson(report.budget) +
+                                ",\"overBudget\":" + toJson(report.overBudget) + ",\"nodes\":{";
+            for (size_t i = 0; i < report.nodes.size(); ++i)
+            {
+                auto &node = report.nodes[i];
+                json += juce::String(i > 0 ? "," : "") + toJsonString(node.nodeId) +
+                        ":{\"type\":" + toJsonString(node.nodeType) +
+                        ",\"bytes\":" + toJson(node.bytes) + "}";
+            }
+            json += "}}";
+            webViewBridge.sendToJS(json);
+        }
+        else if (type == "setSubBlockSize")
+        {
+            // 0 processes whole host blocks
+            int size = parsed.getProperty("size", 0);
+            audioGraph.setSubBlockSize(size);
+        }
+        else if (type == "unbindParameter")
+        {
+            auto nodeId = parsed.getProperty("nodeId", "").toString().toStdString();
+            auto paramName = parsed.getProperty("paramName", "").toString().toStdString();
+            paramBindings.erase(std::remove_if(paramBindings.begin(), paramBindings.end(), [&](const ParamBinding &b)
+                                               { return b.nodeId == nodeId && b.paramName == paramName; }),
+                                paramBindings.end());
+            audioGraph.unbindHostParam(nodeId, paramName);
+        }
         else if (type == "setParameterValue")
         {
             auto id = parsed.getProperty("id", "").toString().toStdString();
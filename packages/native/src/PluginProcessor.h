@@ -1,7 +1,9 @@
 #pragma once
 
 #include <juce_audio_processors/juce_audio_processors.h>
+#include <mutex>
 #include "AudioGraph.h"
+#include "GraphState.h"
 #include "ParameterStore.h"
 #include "WebViewBridge.h"
 
@@ -66,7 +68,32 @@ namespace rau
         /** Periodically read meter/spectrum analysis data and forward to JS. */
         void sendAnalysisData();
 
+        // Host parameter → node parameter bindings requested by JS. Kept
+        // here so a binding that arrives before its parameter is registered
+        // (or outlives a re-registration) is applied when it appears.
+        std::vector<ParamBinding> paramBindings;
+        void applyParamBinding(const ParamBinding &binding);
+        void setParamBinding(const ParamBinding &binding);
+
+        /** Rebuild the graph, parameters and bindings from saved state. */
+        void restoreGraphState(const GraphState &state);
+
         AudioGraph audioGraph;
+
+        // Serialises graph edits (message thread) with state saves and
+        // prepareToPlay(), which some hosts call from their own threads.
+        // Recursive, as a host may save state from inside an edit.
+        std::recursive_mutex graphLock;
+
+        // The sidechain, copied out of the host buffer when the main output
+        // is wider than the main input and would overwrite it. Sized in
+        // prepareToPlay(); longer host blocks are then processed a prepared
+        // block at a time, through views of the main bus and the copy.
+        juce::AudioBuffer<float> sidechainBuffer;
+        juce::AudioBuffer<float> sidechainView;
+        juce::AudioBuffer<float> mainView;
+        juce::MidiBuffer pieceMidi;
+
         ParameterStore paramStore;
         WebViewBridge webViewBridge;
 
@@ -87,6 +114,22 @@ namespace rau
         };
         AnalysisTimer analysisTimer{*this};
 
+        // Swaps in nodes the background worker has finished preparing
+        class PreparedNodesUpdater : public juce::AsyncUpdater
+        {
+        public:
+            PreparedNodesUpdater(PluginProcessor &p) : processor(p) {}
+            void handleAsyncUpdate() override
+            {
+                std::lock_guard<std::recursive_mutex> lock(processor.graphLock);
+                processor.audioGraph.publishPreparedNodes();
+            }
+
+        private:
+            PluginProcessor &processor;
+        };
+        PreparedNodesUpdater preparedNodesUpdater{*this};
+
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PluginProcessor)
     };
 
@@ -0,0 +1,86 @@
+#include "PrepareThreads.h"
+#include <algorithm>
+
+namespace rau
+{
+
+    PrepareThreads::PrepareThreads()
+    {
+        const int numHelpers = std::min(MAX_THREADS, static_cast<int>(std::thread::hardware_concurrency())) - 1;
+        for (int t = 0; t < numHelpers; ++t)
+            threads.emplace_back([this]
+                                 { helperLoop(); });
+    }
+
+    PrepareThreads::~PrepareThreads()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeUp.notify_all();
+        for (auto &thread : threads)
+            thread.join();
+    }
+
+    void PrepareThreads::run(int count, const std::function<void(int)> &fn)
+    {
+        if (count < MIN_PARALLEL_JOBS || threads.empty() || !runLock.try_lock())
+        {
+            for (int i = 0; i < count; ++i)
+                fn(i);
+            return;
+        }
+        std::lock_guard<std::mutex> release(runLock, std::adopt_lock);
+
+        Batch current;
+        current.fn = &fn;
+        current.count = count;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            batch = &current;
+            ++generation;
+        }
+        wakeUp.notify_all();
+
+        drain(current);
+
+        // Helpers that joined are still on their last job; once `batch` is
+        // cleared no other can join
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this]
+                      { return active == 0; });
+        batch = nullptr;
+    }
+
+    void PrepareThreads::drain(Batch &batch)
+    {
+        for (int i = batch.next++; i < batch.count; i = batch.next++)
+            (*batch.fn)(i);
+    }
+
+    void PrepareThreads::helperLoop()
+    {
+        int seen = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;)
+        {
+            wakeUp.wait(lock, [&]
+                        { return stopping || generation != seen; });
+            if (stopping)
+                return;
+            seen = generation;
+            if (batch == nullptr)
+                continue; // woke after the batch finished
+
+            auto *joined = batch;
+            ++active;
+            lock.unlock();
+            drain(*joined);
+            lock.lock();
+            if (--active == 0)
+                finished.notify_all();
+        }
+    }
+
+} // namespace rau
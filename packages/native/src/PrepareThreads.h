@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rau
+{
+
+    /**
+     * PrepareThreads — a few helper threads that run a batch of
+     * independent jobs (node prepare() calls) alongside the calling thread.
+     *
+     * The threads are started once and sleep between batches, so a graph
+     * edit that adds nodes doesn't pay for creating threads. Shared
+     * process-wide via juce::SharedResourcePointer, like BackgroundWorker.
+     *
+     * Small batches, and a batch started while another instance's is
+     * running, run on the calling thread alone.
+     */
+    class PrepareThreads
+    {
+    public:
+        // Most threads a batch runs on at once, the calling thread included
+        static constexpr int MAX_THREADS = 8;
+
+        // Fewer jobs than this aren't worth waking the helpers for
+        static constexpr int MIN_PARALLEL_JOBS = 4;
+
+        PrepareThreads();
+        ~PrepareThreads();
+
+        /**
+         * Run fn(i) for every i in [0, count) and return when all have
+         * finished. Never call from the audio thread.
+         */
+        void run(int count, const std::function<void(int)> &fn);
+
+    private:
+        struct Batch
+        {
+            const std::function<void(int)> *fn = nullptr;
+            int count = 0;
+            std::atomic<int> next{0};
+        };
+
+        static void drain(Batch &batch);
+        void helperLoop();
+
+        std::mutex runLock; // one batch at a time
+
+        std::mutex mutex;
+        std::condition_variable wakeUp;
+        std::condition_variable finished;
+        Batch *batch = nullptr; // the running batch, while helpers may join it
+        int generation = 0;     // bumped per batch
+        int active = 0;         // helpers working on `batch`
+        bool stopping = false;
+        std::vector<std::thread> threads;
+    };
+
+} // namespace rau
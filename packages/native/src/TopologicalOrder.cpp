@@ -0,0 +1,216 @@
+#include "TopologicalOrder.h"
+#include <algorithm>
+
+namespace rau
+{
+
+    namespace
+    {
+        void eraseOne(std::vector<int> &list, int value)
+        {
+            auto it = std::find(list.begin(), list.end(), value);
+            if (it != list.end())
+            {
+                *it = list.back();
+                list.pop_back();
+            }
+        }
+    } // namespace
+
+    int TopologicalOrder::addVertex()
+    {
+        int v;
+        if (!freeIds.empty())
+        {
+            v = freeIds.back();
+            freeIds.pop_back();
+        }
+        else
+        {
+            v = static_cast<int>(position.size());
+            position.push_back(-1);
+            successors.emplace_back();
+            predecessors.emplace_back();
+            visited.push_back(0);
+        }
+
+        position[static_cast<size_t>(v)] = static_cast<int>(order.size());
+        changed.push_back(static_cast<int>(order.size()));
+        order.push_back(v);
+        return v;
+    }
+
+    void TopologicalOrder::removeVertex(int v)
+    {
+        const auto vi = static_cast<size_t>(v);
+
+        for (int w : successors[vi])
+            eraseOne(predecessors[static_cast<size_t>(w)], v);
+        for (int w : predecessors[vi])
+            eraseOne(successors[static_cast<size_t>(w)], v);
+        successors[vi].clear();
+        predecessors[vi].clear();
+
+        const int pos = position[vi];
+        order[static_cast<size_t>(pos)] = -1;
+        changed.push_back(pos);
+        position[vi] = -1;
+        freeIds.push_back(v);
+        ++numHoles;
+
+        compactIfSparse();
+    }
+
+    bool TopologicalOrder::addEdge(int from, int to)
+    {
+        if (from == to)
+            return false;
+
+        const int lower = position[static_cast<size_t>(to)];
+        const int upper = position[static_cast<size_t>(from)];
+
+        if (lower < upper)
+        {
+            // Discover the affected region: what `to` reaches below `from`,
+            // and what reaches `from` above `to`.
+            forward.clear();
+            backward.clear();
+            const bool cycle = searchForward(to, upper, from);
+
+            if (!cycle)
+                searchBackward(from, lower);
+
+            for (int w : forward)
+                visited[static_cast<size_t>(w)] = 0;
+            for (int w : backward)
+                visited[static_cast<size_t>(w)] = 0;
+
+            if (cycle)
+                return false;
+
+            reorder();
+        }
+
+        successors[static_cast<size_t>(from)].push_back(to);
+        predecessors[static_cast<size_t>(to)].push_back(from);
+        return true;
+    }
+
+    void TopologicalOrder::removeEdge(int from, int to)
+    {
+        eraseOne(successors[static_cast<size_t>(from)], to);
+        eraseOne(predecessors[static_cast<size_t>(to)], from);
+    }
+
+    bool TopologicalOrder::searchForward(int start, int upperBound, int target)
+    {
+        stack.clear();
+        stack.push_back(start);
+        visited[static_cast<size_t>(start)] = 1;
+        forward.push_back(start);
+
+        while (!stack.empty())
+        {
+            const int v = stack.back();
+            stack.pop_back();
+
+            for (int w : successors[static_cast<size_t>(v)])
+            {
+                if (w == target)
+                    return true;
+
+                const auto wi = static_cast<size_t>(w);
+                if (!visited[wi] && position[wi] < upperBound)
+                {
+                    visited[wi] = 1;
+                    forward.push_back(w);
+                    stack.push_back(w);
+                }
+            }
+        }
+        return false;
+    }
+
+    void TopologicalOrder::searchBackward(int start, int lowerBound)
+    {
+        stack.clear();
+        stack.push_back(start);
+        visited[static_cast<size_t>(start)] = 1;
+        backward.push_back(start);
+
+        while (!stack.empty())
+        {
+            const int v = stack.back();
+            stack.pop_back();
+
+            for (int w : predecessors[static_cast<size_t>(v)])
+            {
+                const auto wi = static_cast<size_t>(w);
+                if (!visited[wi] && position[wi] > lowerBound)
+                {
+                    visited[wi] = 1;
+                    backward.push_back(w);
+                    stack.push_back(w);
+                }
+            }
+        }
+    }
+
+    void TopologicalOrder::reorder()
+    {
+        auto byPosition = [this](int a, int b)
+        { return position[static_cast<size_t>(a)] < position[static_cast<size_t>(b)]; };
+
+        std::sort(forward.begin(), forward.end(), byPosition);
+        std::sort(backward.begin(), backward.end(), byPosition);
+
+        // The freed positions, in order, are refilled with everything that
+        // must precede the new edge followed by everything that must follow.
+        std::vector<int> &slots = stack;
+        slots.clear();
+        for (int w : backward)
+            slots.push_back(position[static_cast<size_t>(w)]);
+        for (int w : forward)
+            slots.push_back(position[static_cast<size_t>(w)]);
+        std::sort(slots.begin(), slots.end());
+
+        size_t i = 0;
+        for (auto *group : {&backward, &forward})
+        {
+            for (int w : *group)
+            {
+                const int pos = slots[i++];
+                position[static_cast<size_t>(w)] = pos;
+                order[static_cast<size_t>(pos)] = w;
+                changed.push_back(pos);
+            }
+        }
+    }
+
+    void TopologicalOrder::compactIfSparse()
+    {
+        if (numHoles < 64 || numHoles * 2 < static_cast<int>(order.size()))
+            return;
+
+        size_t next = 0;
+        for (int v : order)
+        {
+            if (v < 0)
+                continue;
+            position[static_cast<size_t>(v)] = static_cast<int>(next);
+            order[next++] = v;
+        }
+        order.resize(next);
+        numHoles = 0;
+        allChanged = true;
+    }
+
+    void TopologicalOrder::takeChangedPositions(std::vector<int> &out, bool &all)
+    {
+        out.swap(changed);
+        changed.clear();
+        all = allChanged;
+        allChanged = false;
+    }
+
+} // namespace rau
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace rau
+{
+
+    /**
+     * TopologicalOrder — a topological order over integer vertices that is
+     * maintained incrementally as edges come and go (Pearce–Kelly).
+     *
+     * Adding an edge that already agrees with the order is O(1). Otherwise
+     * only the vertices whose positions lie between the two endpoints and
+     * that are reachable from them are visited and shuffled, so an edit
+     * costs in proportion to the affected region rather than the graph.
+     * Removing an edge never invalidates the order.
+     *
+     * Positions are stable integers with holes left by removed vertices;
+     * takeChangedPositions() reports which positions were rewritten so callers
+     * can update only the matching parts of derived data. Message thread
+     * only.
+     */
+    class TopologicalOrder
+    {
+    public:
+        /** Append a vertex at the end of the order. Reuses freed ids. */
+        int addVertex();
+
+        /** Remove a vertex and every edge touching it. */
+        void removeVertex(int v);
+
+        /**
+         * Add the edge from → to. Returns false (and adds nothing) if the
+         * edge would close a cycle. Parallel edges are counted.
+         */
+        bool addEdge(int from, int to);
+
+        /** Remove one from → to edge added by addEdge(). */
+        void removeEdge(int from, int to);
+
+        int getPosition(int v) const { return position[static_cast<size_t>(v)]; }
+        int vertexAt(int pos) const { return order[static_cast<size_t>(pos)]; }
+        int getNumPositions() const { return static_cast<int>(order.size()); }
+
+        /**
+         * Positions rewritten since the last call (by reorders, additions
+         * and removals). `all` is set when the order was renumbered and
+         * every position should be treated as changed.
+         */
+        void takeChangedPositions(std::vector<int> &out, bool &all);
+
+    private:
+        bool searchForward(int start, int upperBound, int target);
+        void searchBackward(int start, int lowerBound);
+        void reorder();
+        void compactIfSparse();
+
+        std::vector<std::vector<int>> successors;
+        std::vector<std::vector<int>> predecessors;
+        std::vector<int> position; // vertex → position (-1 = free id)
+        std::vector<int> order;    // position → vertex (-1 = hole)
+        std::vector<int> freeIds;
+        int numHoles = 0;
+
+        // Search scratch, kept to avoid reallocating per edit
+        std::vector<char> visited;
+        std::vector<int> forward, backward, stack;
+
+        std::vector<int> changed;
+        bool allChanged = false;
+    };
+
+} // namespace rau
@@ -14,6 +14,9 @@ namespace rau
 
         void timerCallback() override
         {
+            if (bridge.beforeFlushCallback)
+                bridge.beforeFlushCallback();
+
             std::vector<juce::String> messages;
             {
                 std::lock_guard<std::mutex> lock(bridge.sendQueueMutex);
@@ -110,4 +113,9 @@ namespace rau
         jsMessageCallback = std::move(callback);
     }
 
+    void WebViewBridge::onBeforeFlush(std::function<void()> callback)
+    {
+        beforeFlushCallback = std::move(callback);
+    }
+
 } // namespace rau
@@ -51,9 +51,18 @@ namespace rau
          */
         void onMessageFromJS(std::function<void(const juce::String &)> callback);
 
+        /**
+         * Register a callback run on the message thread just before each
+         * flush to the WebView (once per UI frame, only while a WebView is
+         * attached). Use it to send state that changes faster than the UI
+         * can show as one message per frame.
+         */
+        void onBeforeFlush(std::function<void()> callback);
+
     private:
         juce::WebBrowserComponent *webView = nullptr; // non-owning
         std::function<void(const juce::String &)> jsMessageCallback;
+        std::function<void()> beforeFlushCallback;
 
         // Queue for messages to send to JS (thread-safe)
         std::mutex sendQueueMutex;
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+namespace rau
+{
+
+    /**
+     * Helpers for control-rate modulators.
+     *
+     * A modulator computes one control point every `interval` samples and
+     * fills the samples between points with a straight line, so a slow
+     * sine costs one std::sin per interval instead of one per sample. The
+     * line in progress is node state, so the points fall every `interval`
+     * samples of the stream wherever block boundaries land.
+     */
+    namespace control
+    {
+        static constexpr int DEFAULT_INTERVAL = 16;
+        static constexpr int MAX_INTERVAL = 256;
+
+        /** Samples between control points, from a `controlInterval` param */
+        inline int toInterval(float value)
+        {
+            return juce::jlimit(1, MAX_INTERVAL, static_cast<int>(value));
+        }
+
+        /**
+         * The line from one control point to the next, drawn over one or
+         * more process() calls: sample i of the line is
+         * from + (to - from) * (i + 1) / length, so it ends exactly on
+         * `to` and a one-sample line is just `to`.
+         */
+        struct Segment
+        {
+            float from = 0.0f;
+            float to = 0.0f;
+            int length = 0;
+            int position = 0; // samples drawn so far
+
+            void start(float newFrom, float newTo, int numSamples)
+            {
+                from = newFrom;
+                to = newTo;
+                length = numSamples;
+                position = 0;
+            }
+
+            int remaining() const { return length - position; }
+
+            /** The last sample drawn (`from` before the first) */
+            float current() const
+            {
+                if (position == length || from == to)
+                    return to;
+                return from + (to - from) / static_cast<float>(length) * static_cast<float>(position);
+            }
+
+            /** Draw the next `numSamples` (at most remaining()) */
+            void draw(float *dest, int numSamples)
+            {
+                jassert(numSamples <= remaining());
+                if (from == to)
+                {
+                    juce::FloatVectorOperations::fill(dest, to, numSamples);
+                }
+                else
+                {
+                    const float step = (to - from) / static_cast<float>(length);
+                    for (int i = 0; i < numSamples; ++i)
+                        dest[i] = from + step * static_cast<float>(position + i + 1);
+                    if (position + numSamples == length)
+                        dest[numSamples - 1] = to;
+                }
+                position += numSamples;
+            }
+        };
+
+        /** Copy channel 0 to every other channel of `buffer` */
+        inline void fillChannels(juce::AudioBuffer<float> &buffer, int numSamples)
+        {
+            for (int ch = 1; ch < buffer.getNumChannels(); ++ch)
+                juce::FloatVectorOperations::copy(buffer.getWritePointer(ch), buffer.getReadPointer(0), numSamples);
+        }
+    } // namespace control
+
+} // namespace rau
@@ -0,0 +1,159 @@
+#include "ConvolutionWorkerPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace rau
+{
+
+    class ConvolutionWorkerPool::Worker : public juce::Thread
+    {
+    public:
+        explicit Worker(ConvolutionWorkerPool &p)
+            : juce::Thread("rau convolution worker"), pool(p) {}
+
+        void run() override { pool.workerLoop(*this); }
+
+    private:
+        ConvolutionWorkerPool &pool;
+    };
+
+    // ---------------------------------------------------------------------------
+
+    ConvolutionWorkerPool::ConvolutionWorkerPool(int numThreads)
+    {
+        // Leave one core for the audio thread and one for everything else
+        if (numThreads < 0)
+            numThreads = juce::jlimit(1, 4, juce::SystemStats::getNumCpus() - 2);
+
+        for (int i = 0; i < numThreads; ++i)
+        {
+            workers.push_back(std::make_unique<Worker>(*this));
+            workers.back()->startThread(juce::Thread::Priority::high);
+        }
+    }
+
+    ConvolutionWorkerPool::~ConvolutionWorkerPool()
+    {
+        for (auto &w : workers)
+            w->signalThreadShouldExit();
+        wakeUp.notify_all();
+        for (auto &w : workers)
+            w->stopThread(-1);
+    }
+
+    void ConvolutionWorkerPool::add(Task &task)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        tasks.push_back(&task);
+    }
+
+    void ConvolutionWorkerPool::remove(Task &task)
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            tasks.erase(std::remove(tasks.begin(), tasks.end(), &task), tasks.end());
+        }
+
+        // No worker can claim it any more; wait out one that already has
+        while (task.state.load(std::memory_order_acquire) == Task::running)
+            std::this_thread::yield();
+
+        if (task.state.exchange(Task::idle, std::memory_order_acq_rel) == Task::queued)
+            numQueued.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void ConvolutionWorkerPool::submit(Task &task, juce::int64 deadlineTicks)
+    {
+        jassert(task.state.load(std::memory_order_relaxed) == Task::idle);
+
+        task.deadline.store(deadlineTicks, std::memory_order_relaxed);
+        task.state.store(Task::queued, std::memory_order_release);
+        numQueued.fetch_add(1, std::memory_order_release);
+
+        // notify without holding wakeLock so the audio thread never blocks
+        wakeUp.notify_one();
+    }
+
+    bool ConvolutionWorkerPool::complete(Task &task)
+    {
+        int expected = Task::queued;
+        if (task.state.compare_exchange_strong(expected, Task::running, std::memory_order_acq_rel))
+        {
+            // Nobody picked it up in time — run it here
+            numQueued.fetch_sub(1, std::memory_order_relaxed);
+            task.run();
+            task.state.store(Task::idle, std::memory_order_release);
+            return true;
+        }
+
+        if (expected == Task::idle)
+            return false; // nothing was submitted
+
+        bool late = false;
+        while (task.state.load(std::memory_order_acquire) == Task::running)
+        {
+            late = true;
+            std::this_thread::yield();
+        }
+
+        task.state.store(Task::idle, std::memory_order_release);
+        return late;
+    }
+
+    ConvolutionWorkerPool::Task *ConvolutionWorkerPool::claimNextTask()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+
+        for (;;)
+        {
+            Task *best = nullptr;
+            juce::int64 bestDeadline = 0;
+
+            for (auto *task : tasks)
+            {
+                if (task->state.load(std::memory_order_acquire) != Task::queued)
+                    continue;
+
+                const auto d = task->deadline.load(std::memory_order_relaxed);
+                if (best == nullptr || d < bestDeadline)
+                {
+                    best = task;
+                    bestDeadline = d;
+                }
+            }
+
+            if (best == nullptr)
+                return nullptr;
+
+            // The audio thread may have claimed it for inline fallback
+            int expected = Task::queued;
+            if (best->state.compare_exchange_strong(expected, Task::running, std::memory_order_acq_rel))
+            {
+                numQueued.fetch_sub(1, std::memory_order_relaxed);
+                return best;
+            }
+        }
+    }
+
+    void ConvolutionWorkerPool::workerLoop(Worker &worker)
+    {
+        while (!worker.threadShouldExit())
+        {
+            if (auto *task = claimNextTask())
+            {
+                task->run();
+                task->state.store(Task::done, std::memory_order_release);
+                continue;
+            }
+
+            // The audio thread notifies without the lock, so a wakeup can
+            // slip in between the scan and the wait — the timeout covers it.
+            std::unique_lock<std::mutex> wait(wakeLock);
+            wakeUp.wait_for(wait, std::chrono::milliseconds(2), [this, &worker]
+                            { return worker.threadShouldExit() || numQueued.load(std::memory_order_acquire) > 0; });
+        }
+    }
+
+} // namespace rau
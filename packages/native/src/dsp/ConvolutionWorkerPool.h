@@ -0,0 +1,89 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace rau
+{
+
+    /**
+     * ConvolutionWorkerPool — high-priority threads that compute the tail
+     * stages of PartitionedConvolver engines off the audio thread.
+     *
+     * Each tail stage owns a Task. At a partition boundary the audio thread
+     * submit()s it with a deadline (the next boundary of that stage); the
+     * workers always run the queued task with the earliest deadline. When
+     * the deadline arrives the audio thread calls complete(): if no worker
+     * has started the task yet it runs it inline, and if one is mid-way it
+     * waits for it. Either way the result is identical, so output never
+     * depends on thread timing.
+     *
+     * Shared process-wide via juce::SharedResourcePointer.
+     */
+    class ConvolutionWorkerPool
+    {
+    public:
+        class Task
+        {
+        public:
+            virtual ~Task() = default;
+            virtual void run() = 0;
+
+        private:
+            friend class ConvolutionWorkerPool;
+
+            enum State
+            {
+                idle,
+                queued,
+                running,
+                done
+            };
+
+            std::atomic<int> state{idle};
+            std::atomic<juce::int64> deadline{0};
+        };
+
+        /** `numThreads` < 0 picks a count from the CPU; 0 starts none, so
+         *  every submitted task is run by complete() on the audio thread. */
+        explicit ConvolutionWorkerPool(int numThreads = -1);
+        ~ConvolutionWorkerPool();
+
+        /** Register / unregister a task (never from the audio thread).
+         *  remove() waits for the task if a worker is running it. */
+        void add(Task &task);
+        void remove(Task &task);
+
+        /** Queue a task (audio thread, lock-free). */
+        void submit(Task &task, juce::int64 deadlineTicks);
+
+        /**
+         * Make sure a submitted task has finished (audio thread). Returns
+         * true if the worker missed the deadline and the task had to be
+         * run or waited for here.
+         */
+        bool complete(Task &task);
+
+        int getNumThreads() const { return static_cast<int>(workers.size()); }
+
+    private:
+        class Worker;
+
+        Task *claimNextTask();
+        void workerLoop(Worker &worker);
+
+        std::mutex lock; // guards `tasks` — never taken by the audio thread
+        std::vector<Task *> tasks;
+
+        std::mutex wakeLock;
+        std::condition_variable wakeUp;
+        std::atomic<int> numQueued{0};
+
+        std::vector<std::unique_ptr<Worker>> workers;
+    };
+
+} // namespace rau
@@ -0,0 +1,162 @@
+#include "FDNReverb.h"
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <cmath>
+
+namespace rau
+{
+
+    namespace
+    {
+        // Mutually prime line lengths at 48 kHz (~30–75 ms)
+        constexpr std::array<int, FDNReverb::NUM_LINES> BASE_LENGTHS = {
+            1433, 1601, 1867, 2053, 2251, 2399, 2617, 3539};
+        constexpr double BASE_RATE = 48000.0;
+
+        // In-place normalised 8-point Walsh–Hadamard transform
+        void hadamard(std::array<float, FDNReverb::NUM_LINES> &x)
+        {
+            for (int h = 1; h < FDNReverb::NUM_LINES; h *= 2)
+            {
+                for (int i = 0; i < FDNReverb::NUM_LINES; i += 2 * h)
+                {
+                    for (int j = i; j < i + h; ++j)
+                    {
+                        const float a = x[static_cast<size_t>(j)];
+                        const float b = x[static_cast<size_t>(j + h)];
+                        x[static_cast<size_t>(j)] = a + b;
+                        x[static_cast<size_t>(j + h)] = a - b;
+                    }
+                }
+            }
+
+            const float norm = 0.35355339f; // 1 / sqrt(8)
+            for (auto &v : x)
+                v *= norm;
+        }
+
+        int lineLength(size_t line, double sampleRate)
+        {
+            return juce::jmax(1, static_cast<int>(std::lround(BASE_LENGTHS[line] * sampleRate / BASE_RATE)));
+        }
+
+        // Frames in the ring: a power of two past the longest line
+        int ringFrames(double sampleRate)
+        {
+            int longest = 0;
+            for (size_t i = 0; i < FDNReverb::NUM_LINES; ++i)
+                longest = juce::jmax(longest, lineLength(i, sampleRate));
+            return juce::nextPowerOfTwo(longest + 1);
+        }
+    } // namespace
+
+    int FDNReverb::tankSize(double sr)
+    {
+        return ringFrames(sr) * NUM_LINES;
+    }
+
+    void FDNReverb::prepare(double sr, float *tank)
+    {
+        sampleRate = sr;
+        for (size_t i = 0; i < NUM_LINES; ++i)
+            lengths[i] = lineLength(i, sr);
+
+        ring = tank;
+        ringMask = ringFrames(sr) - 1;
+
+        reset();
+        setParameters(0.5f, 0.5f);
+        gain = targetGain;
+        damp = targetDamp;
+    }
+
+    void FDNReverb::reset()
+    {
+        if (ring != nullptr)
+            std::fill(ring, ring + static_cast<size_t>(ringMask + 1) * NUM_LINES, 0.0f);
+        lowpass.fill(0.0f);
+        writePos = 0;
+    }
+
+    void FDNReverb::setParameters(float roomSize, float damping)
+    {
+        // Decay time from 0.3 s to about 12 s; each line loses 60 dB over
+        // that time regardless of its length
+        const double rt60 = 0.3 * std::pow(40.0, static_cast<double>(juce::jlimit(0.0f, 1.0f, roomSize)));
+        for (size_t i = 0; i < NUM_LINES; ++i)
+        {
+            targetGain[i] = static_cast<float>(std::pow(10.0, -3.0 * lengths[i] / (rt60 * sampleRate)));
+        }
+
+        targetDamp = juce::jlimit(0.0f, 1.0f, damping) * 0.7f;
+    }
+
+    void FDNReverb::process(float *left, float *right, int numSamples)
+    {
+        if (numSamples <= 0 || ring == nullptr)
+            return;
+
+        // Ramp gains and damping across this block
+        const float invN = 1.0f / static_cast<float>(numSamples);
+        Frame gainStep;
+        for (size_t i = 0; i < NUM_LINES; ++i)
+            gainStep[i] = (targetGain[i] - gain[i]) * invN;
+        const float dampStep = (targetDamp - damp) * invN;
+
+        // Mono input feeds every line at half level
+        const float inject = right != nullptr ? 1.0f : 0.5f;
+        const float outScale = 0.5f;
+
+        Frame taps, feed;
+
+        for (int s = 0; s < numSamples; ++s)
+        {
+            for (size_t i = 0; i < NUM_LINES; ++i)
+            {
+                const int pos = (writePos - lengths[i]) & ringMask;
+                taps[i] = ring[static_cast<size_t>(pos) * NUM_LINES + i];
+            }
+
+            damp += dampStep;
+            for (size_t i = 0; i < NUM_LINES; ++i)
+            {
+                gain[i] += gainStep[i];
+                lowpass[i] = taps[i] + (lowpass[i] - taps[i]) * damp;
+                feed[i] = lowpass[i] * gain[i];
+            }
+
+            hadamard(feed);
+
+            const float inL = left[s];
+            const float inR = right != nullptr ? right[s] : inL;
+            float *frame = ring + static_cast<size_t>(writePos) * NUM_LINES;
+            for (size_t i = 0; i < NUM_LINES; i += 2)
+            {
+                frame[i] = feed[i] + inL * inject;
+                frame[i + 1] = feed[i + 1] + inR * inject;
+            }
+            writePos = (writePos + 1) & ringMask;
+
+            float wetL = 0.0f, wetR = 0.0f;
+            for (size_t i = 0; i < NUM_LINES; i += 2)
+            {
+                wetL += taps[i];
+                wetR += taps[i + 1];
+            }
+
+            if (right != nullptr)
+            {
+                left[s] = wetL * outScale;
+                right[s] = wetR * outScale;
+            }
+            else
+            {
+                left[s] = (wetL + wetR) * (0.5f * outScale);
+            }
+        }
+
+        gain = targetGain;
+        damp = targetDamp;
+    }
+
+} // namespace rau
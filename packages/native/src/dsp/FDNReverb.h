@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+
+namespace rau
+{
+
+    /**
+     * FDNReverb — feedback delay network reverb.
+     *
+     * Eight delay lines run side by side as the lanes of one frame: each
+     * sample reads one tap per line, damps and attenuates it, mixes the
+     * eight values through a normalised Hadamard matrix (a fast
+     * Walsh–Hadamard transform, 24 adds) and writes the frame back. The
+     * lines share one interleaved ring, so a write is a single contiguous
+     * eight-float store, and every per-line step is a plain eight-wide
+     * loop the compiler can vectorise.
+     *
+     * The lines' storage is passed in, so a node can take it from its
+     * arena. Line lengths are fixed (mutually prime, 30–75 ms). `roomSize` sets
+     * the decay time and `damping` the high-frequency loss per pass; both
+     * are ramped over one block when they change, so they can be moved
+     * freely. Left input feeds the even lines and right the odd lines; the
+     * wet outputs are tapped the same way.
+     */
+    class FDNReverb
+    {
+    public:
+        static constexpr int NUM_LINES = 8;
+
+        /** Floats of delay-line storage prepare() needs at `sampleRate`. */
+        static int tankSize(double sampleRate);
+
+        /**
+         * `tank` is tankSize(sampleRate) floats the caller owns (a node's
+         * arena state), kept until the next prepare().
+         */
+        void prepare(double sampleRate, float *tank);
+        void reset();
+
+        /** roomSize and damping in 0–1. */
+        void setParameters(float roomSize, float damping);
+
+        /**
+         * Replace `left`/`right` with the wet signal. Pass `right` =
+         * nullptr for mono.
+         */
+        void process(float *left, float *right, int numSamples);
+
+    private:
+        using Frame = std::array<float, NUM_LINES>;
+
+        float *ring = nullptr; // [position * NUM_LINES + line]
+        int ringMask = 0;
+        int writePos = 0;
+
+        std::array<int, NUM_LINES> lengths{};
+        Frame gain{};          // per-pass attenuation
+        Frame targetGain{};
+        float damp = 0.0f;     // one-pole lowpass coefficient
+        float targetDamp = 0.0f;
+        Frame lowpass{};       // damping filter state
+
+        double sampleRate = 44100.0;
+    };
+
+} // namespace rau
@@ -0,0 +1,208 @@
+#include "IRCache.h"
+#include <cmath>
+#include <cstring>
+
+namespace rau
+{
+
+    namespace
+    {
+        // Samples below this magnitude at either end of the IR are trimmed (-80 dB)
+        constexpr float TRIM_THRESHOLD = 1.0e-4f;
+
+        std::vector<std::vector<float>> resample(const IRData &ir, double targetRate)
+        {
+            if (std::abs(ir.sampleRate - targetRate) < 1.0e-6 || ir.sampleRate <= 0.0)
+                return ir.channels;
+
+            const double ratio = ir.sampleRate / targetRate;
+            const int inLength = ir.getNumSamples();
+            const int outLength = static_cast<int>(std::ceil(inLength / ratio));
+
+            std::vector<std::vector<float>> out(ir.channels.size());
+            std::vector<float> padded(static_cast<size_t>(inLength) + 8, 0.0f);
+
+            for (size_t ch = 0; ch < ir.channels.size(); ++ch)
+            {
+                std::copy(ir.channels[ch].begin(), ir.channels[ch].end(), padded.begin());
+                out[ch].assign(static_cast<size_t>(outLength), 0.0f);
+
+                juce::LagrangeInterpolator interpolator;
+                interpolator.process(ratio, padded.data(), out[ch].data(), outLength);
+            }
+            return out;
+        }
+
+        void trim(std::vector<std::vector<float>> &channels)
+        {
+            const int length = channels.empty() ? 0 : static_cast<int>(channels[0].size());
+            int first = length, last = -1;
+
+            for (auto &ch : channels)
+            {
+                for (int i = 0; i < length; ++i)
+                {
+                    if (std::abs(ch[static_cast<size_t>(i)]) > TRIM_THRESHOLD)
+                    {
+                        first = juce::jmin(first, i);
+                        last = juce::jmax(last, i);
+                    }
+                }
+            }
+
+            if (last < first)
+            {
+                for (auto &ch : channels)
+                    ch.clear();
+                return;
+            }
+
+            for (auto &ch : channels)
+            {
+                ch.erase(ch.begin() + last + 1, ch.end());
+                ch.erase(ch.begin(), ch.begin() + first);
+            }
+        }
+
+        // Scale the loudest channel to a fixed energy (with -18 dB of
+        // headroom) so the wet level doesn't depend on IR length.
+        void normalise(std::vector<std::vector<float>> &channels)
+        {
+            float maxEnergy = 0.0f;
+            for (auto &ch : channels)
+            {
+                float energy = 0.0f;
+                for (float s : ch)
+                    energy += s * s;
+                maxEnergy = juce::jmax(maxEnergy, energy);
+            }
+
+            if (maxEnergy <= 0.0f)
+                return;
+
+            const float factor = 0.125f / std::sqrt(maxEnergy);
+            for (auto &ch : channels)
+                juce::FloatVectorOperations::multiply(ch.data(), factor, static_cast<int>(ch.size()));
+        }
+    } // namespace
+
+    uint64_t IRCache::hashContent(const std::vector<std::vector<float>> &channels, double sampleRate)
+    {
+        // FNV-1a over layout, sample rate and raw sample bytes
+        uint64_t h = 1469598103934665603ull;
+        auto mix = [&h](const void *data, size_t size)
+        {
+            auto *bytes = static_cast<const unsigned char *>(data);
+            for (size_t i = 0; i < size; ++i)
+            {
+                h ^= bytes[i];
+                h *= 1099511628211ull;
+            }
+        };
+
+        const uint64_t numChannels = channels.size();
+        mix(&numChannels, sizeof(numChannels));
+        mix(&sampleRate, sizeof(sampleRate));
+        for (auto &ch : channels)
+        {
+            const uint64_t length = ch.size();
+            mix(&length, sizeof(length));
+            mix(ch.data(), ch.size() * sizeof(float));
+        }
+        return h;
+    }
+
+    std::shared_ptr<const IRData> IRCache::intern(std::vector<std::vector<float>> channels, double sampleRate)
+    {
+        const uint64_t hash = hashContent(channels, sampleRate);
+
+        std::lock_guard<std::mutex> guard(lock);
+        purgeExpired();
+
+        auto it = sources.find(hash);
+        if (it != sources.end())
+        {
+            if (auto existing = it->second.lock())
+            {
+                // Guard against hash collisions before sharing
+                if (existing->sampleRate == sampleRate && existing->channels == channels)
+                    return existing;
+            }
+        }
+
+        auto ir = std::make_shared<IRData>();
+        ir->channels = std::move(channels);
+        ir->sampleRate = sampleRate;
+        ir->hash = hash;
+
+        if (it == sources.end() || it->second.expired())
+            sources[hash] = ir;
+
+        return ir;
+    }
+
+    std::shared_ptr<const PartitionedIR> IRCache::getPartitioned(const std::shared_ptr<const IRData> &ir,
+                                                                 double sampleRate, int headSize, SampleStorage storage)
+    {
+        if (!ir)
+            return nullptr;
+
+        const PartitionKey key{ir.get(), sampleRate, headSize, storage};
+        auto cached = [&]() -> std::shared_ptr<const PartitionedIR>
+        {
+            auto it = partitioned.find(key);
+            if (it == partitioned.end() || it->second.source.lock() != ir)
+                return nullptr;
+            return it->second.partitions.lock();
+        };
+
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (auto existing = cached())
+                return existing;
+        }
+
+        // Build outside the lock — this is the expensive part
+        auto channels = resample(*ir, sampleRate);
+        trim(channels);
+        normalise(channels);
+        auto result = PartitionedIR::create(channels, sampleRate, headSize, storage);
+
+        std::lock_guard<std::mutex> guard(lock);
+        if (auto existing = cached())
+            return existing; // another thread won the race
+        partitioned[key] = {ir, result};
+        return result;
+    }
+
+    size_t IRCache::getSizeInBytes() const
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        size_t bytes = 0;
+
+        for (auto &[hash, weak] : sources)
+        {
+            if (auto ir = weak.lock())
+                for (auto &ch : ir->channels)
+                    bytes += ch.size() * sizeof(float);
+        }
+
+        for (auto &[key, entry] : partitioned)
+        {
+            if (auto ir = entry.partitions.lock())
+                bytes += ir->getSizeInBytes();
+        }
+
+        return bytes;
+    }
+
+    void IRCache::purgeExpired()
+    {
+        for (auto it = sources.begin(); it != sources.end();)
+            it = it->second.expired() ? sources.erase(it) : std::next(it);
+
+        for (auto it = partitioned.begin(); it != partitioned.end();)
+            it = it->second.partitions.expired() ? partitioned.erase(it) : std::next(it);
+    }
+
+} // namespace rau
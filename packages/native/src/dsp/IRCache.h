@@ -0,0 +1,77 @@
+#pragma once
+
+#include "PartitionedConvolver.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace rau
+{
+
+    /**
+     * IRData — a de-interleaved impulse response as loaded (before
+     * resampling, trimming or normalisation). Immutable and shared.
+     */
+    struct IRData
+    {
+        std::vector<std::vector<float>> channels; // [channel][sample]
+        double sampleRate = 44100.0;
+        uint64_t hash = 0;
+
+        int getNumChannels() const { return static_cast<int>(channels.size()); }
+        int getNumSamples() const { return channels.empty() ? 0 : static_cast<int>(channels[0].size()); }
+    };
+
+    /**
+     * IRCache — process-wide, content-hashed cache of impulse responses.
+     *
+     * Ten convolvers loading the same hall IR share one IRData and, for each
+     * (sample rate, head size, storage) they run at, one PartitionedIR. Entries are
+     * held weakly: memory is released as soon as the last node drops its
+     * reference. Shared between plugin instances via
+     * juce::SharedResourcePointer<IRCache>.
+     *
+     * Thread-safe. getPartitioned() does the heavy lifting (resample, trim,
+     * normalise, FFT) and must only be called from a background thread.
+     */
+    class IRCache
+    {
+    public:
+        /** Intern raw IR samples, returning the shared copy if identical content is cached. */
+        std::shared_ptr<const IRData> intern(std::vector<std::vector<float>> channels, double sampleRate);
+
+        /** Partitioned, frequency-domain form of `ir` for the given engine config. */
+        std::shared_ptr<const PartitionedIR> getPartitioned(const std::shared_ptr<const IRData> &ir,
+                                                            double sampleRate, int headSize,
+                                                            SampleStorage storage = SampleStorage::Float32);
+
+        /** Total bytes currently held by live cache entries. */
+        size_t getSizeInBytes() const;
+
+        static uint64_t hashContent(const std::vector<std::vector<float>> &channels, double sampleRate);
+
+    private:
+        // Partitions are keyed on the IRData they were built from, not its
+        // hash: colliding IRs that intern() keeps apart stay apart here.
+        // The source is held weakly and checked on a hit, since a freed
+        // IRData's address can be reused.
+        using PartitionKey = std::tuple<const IRData *, double, int, SampleStorage>;
+
+        struct PartitionEntry
+        {
+            std::weak_ptr<const IRData> source;
+            std::weak_ptr<const PartitionedIR> partitions;
+        };
+
+        mutable std::mutex lock;
+        std::unordered_map<uint64_t, std::weak_ptr<const IRData>> sources;
+        std::map<PartitionKey, PartitionEntry> partitioned;
+
+        void purgeExpired();
+    };
+
+} // namespace rau
@@ -0,0 +1,230 @@
+#include "NodeArena.h"
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace rau
+{
+
+    namespace
+    {
+        size_t roundUp(size_t value, size_t multiple)
+        {
+            return (value + multiple - 1) / multiple * multiple;
+        }
+
+        void *heapAllocate(size_t bytes)
+        {
+            void *memory = ::operator new(bytes, std::align_val_t(NodeArena::ALIGNMENT), std::nothrow);
+            if (memory != nullptr)
+                std::memset(memory, 0, bytes);
+            return memory;
+        }
+
+        void heapFree(void *memory)
+        {
+            ::operator delete(memory, std::align_val_t(NodeArena::ALIGNMENT));
+        }
+    } // namespace
+
+    NodeArena::~NodeArena()
+    {
+        // Owners free their arrays first (the graph declares the arena
+        // before its nodes); anything left is freed with the chunks
+        for (auto &[ptr, allocation] : allocations)
+            if (allocation.chunk == nullptr)
+                heapFree(ptr);
+        for (auto &chunk : chunks)
+            freeChunk(chunk.get());
+    }
+
+    NodeArena::Chunk *NodeArena::reserveChunk(size_t size)
+    {
+        auto chunk = std::make_unique<Chunk>();
+        chunk->size = size;
+
+#if defined(__linux__)
+        // Over-map by a chunk and trim, so the chunk starts on a huge page
+        // boundary and the kernel can back it with huge pages
+        const size_t mapped = size + CHUNK_SIZE;
+        void *region = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (region != MAP_FAILED)
+        {
+            auto *start = static_cast<char *>(region);
+            auto *aligned = reinterpret_cast<char *>(roundUp(reinterpret_cast<uintptr_t>(start), CHUNK_SIZE));
+            if (aligned > start)
+                munmap(start, static_cast<size_t>(aligned - start));
+            const size_t tail = static_cast<size_t>(start + mapped - (aligned + size));
+            if (tail > 0)
+                munmap(aligned + size, tail);
+#ifdef MADV_HUGEPAGE
+            madvise(aligned, size, MADV_HUGEPAGE);
+#endif
+            chunk->base = aligned;
+            chunk->mapped = true;
+        }
+#endif
+
+        // Fresh pages are zero; heap memory isn't, but allocate() clears
+        // every range it hands out anyway
+        if (chunk->base == nullptr)
+            chunk->base = static_cast<char *>(::operator new(size, std::align_val_t(ALIGNMENT), std::nothrow));
+        if (chunk->base == nullptr)
+            return nullptr;
+
+        chunk->free.emplace(0, size);
+        usage.reserved += size;
+        chunks.push_back(std::move(chunk));
+        return chunks.back().get();
+    }
+
+    void NodeArena::freeChunk(Chunk *chunk)
+    {
+#if defined(__linux__)
+        if (chunk->mapped)
+        {
+            munmap(chunk->base, chunk->size);
+            return;
+        }
+#endif
+        ::operator delete(chunk->base, std::align_val_t(ALIGNMENT));
+    }
+
+    void *NodeArena::allocate(size_t bytes, const void *owner)
+    {
+        bytes = roundUp(std::max<size_t>(bytes, 1), ALIGNMENT);
+        std::lock_guard<std::mutex> guard(lock);
+
+        // First fit in an existing chunk
+        Chunk *chunk = nullptr;
+        size_t offset = 0;
+        for (auto &candidate : chunks)
+        {
+            auto range = std::find_if(candidate->free.begin(), candidate->free.end(),
+                                      [bytes](const std::pair<const size_t, size_t> &r)
+                                      { return r.second >= bytes; });
+            if (range != candidate->free.end())
+            {
+                chunk = candidate.get();
+                offset = range->first;
+                break;
+            }
+        }
+
+        if (chunk == nullptr)
+        {
+            const size_t size = roundUp(bytes, CHUNK_SIZE);
+            if (usage.budget == 0 || usage.reserved + size <= usage.budget)
+                chunk = reserveChunk(size);
+        }
+
+        void *memory = nullptr;
+        if (chunk != nullptr)
+        {
+            auto range = chunk->free.find(offset);
+            const size_t length = range->second;
+            chunk->free.erase(range);
+            if (length > bytes)
+                chunk->free.emplace(offset + bytes, length - bytes);
+            chunk->used += bytes;
+
+            memory = chunk->base + offset;
+            std::memset(memory, 0, bytes);
+        }
+        else
+        {
+            // Over budget (or no chunk to be had): the heap still serves
+            memory = heapAllocate(bytes);
+            if (memory == nullptr)
+                return nullptr;
+            usage.overBudget += bytes;
+        }
+
+        allocations[memory] = {bytes, owner, chunk};
+        ownerBytes[owner] += bytes;
+        usage.inUse += bytes;
+        return memory;
+    }
+
+    void NodeArena::release(void *ptr)
+    {
+        if (ptr == nullptr)
+            return;
+
+        std::lock_guard<std::mutex> guard(lock);
+        auto it = allocations.find(ptr);
+        if (it == allocations.end())
+            return;
+
+        const auto allocation = it->second;
+        allocations.erase(it);
+        usage.inUse -= allocation.size;
+        if ((ownerBytes[allocation.owner] -= allocation.size) == 0)
+            ownerBytes.erase(allocation.owner);
+
+        auto *chunk = allocation.chunk;
+        if (chunk == nullptr)
+        {
+            usage.overBudget -= allocation.size;
+            heapFree(ptr);
+            return;
+        }
+
+        chunk->used -= allocation.size;
+        if (chunk->used == 0)
+        {
+            // Empty: give it back rather than hold memory for nodes that
+            // may never come
+            usage.reserved -= chunk->size;
+            freeChunk(chunk);
+            chunks.erase(std::find_if(chunks.begin(), chunks.end(),
+                                      [chunk](const std::unique_ptr<Chunk> &c)
+                                      { return c.get() == chunk; }));
+            return;
+        }
+
+        // Return the range, merging it with free neighbours
+        size_t offset = static_cast<size_t>(static_cast<char *>(ptr) - chunk->base);
+        size_t length = allocation.size;
+        auto next = chunk->free.lower_bound(offset);
+        if (next != chunk->free.end() && offset + length == next->first)
+        {
+            length += next->second;
+            next = chunk->free.erase(next);
+        }
+        if (next != chunk->free.begin())
+        {
+            auto prev = std::prev(next);
+            if (prev->first + prev->second == offset)
+            {
+                offset = prev->first;
+                length += prev->second;
+                chunk->free.erase(prev);
+            }
+        }
+        chunk->free.emplace(offset, length);
+    }
+
+    void NodeArena::setBudget(size_t bytes)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        usage.budget = bytes;
+    }
+
+    NodeArena::Usage NodeArena::getUsage() const
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        return usage;
+    }
+
+    size_t NodeArena::getBytesOwnedBy(const void *owner) const
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        auto it = ownerBytes.find(owner);
+        return it != ownerBytes.end() ? it->second : 0;
+    }
+
+} // namespace rau
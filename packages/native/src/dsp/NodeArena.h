@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace rau
+{
+
+    /**
+     * NodeArena — one graph's memory for node DSP state (delay lines,
+     * reverb pre-delays).
+     *
+     * Memory is reserved in 2 MB chunks, backed by transparent huge pages
+     * where the platform offers them, so a graph's lines share a few
+     * pages instead of being scattered across the heap. A request larger
+     * than a chunk gets a chunk of its own. Freed ranges are coalesced and
+     * reused, and a chunk that empties goes back to the system.
+     *
+     * Each allocation is tagged with its owner (a node), so the graph can
+     * report every node's footprint. An optional budget caps what the
+     * arena reserves: past it, allocations come from the regular heap and
+     * count as over budget. A session still loads, but the overrun shows
+     * in the report.
+     *
+     * Thread-safe, since nodes are prepared on several threads at once.
+     * Never used from the audio thread.
+     */
+    class NodeArena
+    {
+    public:
+        static constexpr size_t CHUNK_SIZE = size_t(2) << 20;
+        static constexpr size_t ALIGNMENT = 64;
+
+        NodeArena() = default;
+        ~NodeArena();
+        NodeArena(const NodeArena &) = delete;
+        NodeArena &operator=(const NodeArena &) = delete;
+
+        /** `bytes` of zeroed memory, aligned to ALIGNMENT. Null only if the system is out of memory. */
+        void *allocate(size_t bytes, const void *owner);
+        void release(void *ptr);
+
+        /** Most the arena may reserve, in bytes; 0 for no limit. */
+        void setBudget(size_t bytes);
+
+        struct Usage
+        {
+            size_t inUse = 0;      // allocated, arena and heap
+            size_t reserved = 0;   // held in chunks
+            size_t overBudget = 0; // allocated from the heap past the budget
+            size_t budget = 0;
+        };
+        Usage getUsage() const;
+
+        size_t getBytesOwnedBy(const void *owner) const;
+
+    private:
+        struct Chunk
+        {
+            char *base = nullptr;
+            size_t size = 0;
+            size_t used = 0;
+            bool mapped = false;           // from the system's page allocator
+            std::map<size_t, size_t> free; // offset → length, coalesced
+        };
+
+        struct Allocation
+        {
+            size_t size = 0;
+            const void *owner = nullptr;
+            Chunk *chunk = nullptr; // null if from the heap
+        };
+
+        Chunk *reserveChunk(size_t size);
+        void freeChunk(Chunk *chunk);
+
+        mutable std::mutex lock;
+        std::vector<std::unique_ptr<Chunk>> chunks;
+        std::unordered_map<void *, Allocation> allocations;
+        std::unordered_map<const void *, size_t> ownerBytes;
+        Usage usage;
+    };
+
+    /**
+     * ArenaArray — a fixed-size, zeroed array of trivially copyable T,
+     * from a NodeArena (or the heap, without one). Reading and writing it
+     * is plain pointer access, so it's safe on the audio thread;
+     * allocating is not.
+     */
+    template <typename T>
+    class ArenaArray
+    {
+    public:
+        ArenaArray() = default;
+        ~ArenaArray() { release(); }
+
+        ArenaArray(ArenaArray &&other) noexcept { swap(other); }
+        ArenaArray &operator=(ArenaArray &&other) noexcept
+        {
+            ArenaArray moved(std::move(other));
+            swap(moved);
+            return *this;
+        }
+        ArenaArray(const ArenaArray &) = delete;
+        ArenaArray &operator=(const ArenaArray &) = delete;
+
+        /**
+         * Make this `count` zeroed elements. Keeps the current memory
+         * (only clearing it) when the size and arena are unchanged.
+         */
+        void allocate(NodeArena *arena, const void *owner, size_t count)
+        {
+            if (ptr != nullptr && count == length && arena == source)
+            {
+                clear();
+                return;
+            }
+
+            release();
+            if (count == 0)
+                return;
+
+            const size_t bytes = count * sizeof(T);
+            void *memory = arena != nullptr
+                               ? arena->allocate(bytes, owner)
+                               : ::operator new(bytes, std::align_val_t(NodeArena::ALIGNMENT));
+            if (arena == nullptr)
+                std::memset(memory, 0, bytes);
+
+            ptr = static_cast<T *>(memory);
+            length = ptr != nullptr ? count : 0;
+            source = arena;
+        }
+
+        void release()
+        {
+            if (ptr == nullptr)
+                return;
+            if (source != nullptr)
+                source->release(ptr);
+            else
+                ::operator delete(ptr, std::align_val_t(NodeArena::ALIGNMENT));
+            ptr = nullptr;
+            length = 0;
+            source = nullptr;
+        }
+
+        void clear()
+        {
+            if (ptr != nullptr)
+                std::memset(static_cast<void *>(ptr), 0, length * sizeof(T));
+        }
+
+        T *data() { return ptr; }
+        const T *data() const { return ptr; }
+        size_t size() const { return length; }
+        bool empty() const { return length == 0; }
+
+        T &operator[](size_t i) { return ptr[i]; }
+        const T &operator[](size_t i) const { return ptr[i]; }
+
+    private:
+        void swap(ArenaArray &other) noexcept
+        {
+            std::swap(ptr, other.ptr);
+            std::swap(length, other.length);
+            std::swap(source, other.source);
+        }
+
+        T *ptr = nullptr;
+        size_t length = 0;
+        NodeArena *source = nullptr;
+    };
+
+} // namespace rau
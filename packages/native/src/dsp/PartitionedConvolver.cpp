@@ -0,0 +1,498 @@
+#include "PartitionedConvolver.h"
+#include <cmath>
+#include <type_traits>
+
+namespace rau
+{
+
+    namespace
+    {
+        int fftOrderFor(int fftSize)
+        {
+            int order = 0;
+            while ((1 << order) < fftSize)
+                ++order;
+            return order;
+        }
+
+        // acc += a * b * gain over `numBins` interleaved complex bins
+        template <typename Format>
+        void multiplyAccumulate(float *acc, const float *a, const typename Format::Storage *b, float gain, int numBins)
+        {
+            for (int i = 0; i < numBins; ++i)
+            {
+                const float ar = a[2 * i], ai = a[2 * i + 1];
+                float br = Format::load(b[2 * i]), bi = Format::load(b[2 * i + 1]);
+                if constexpr (!std::is_same_v<Format, Float32Format>)
+                {
+                    br *= gain;
+                    bi *= gain;
+                }
+                acc[2 * i] += ar * br - ai * bi;
+                acc[2 * i + 1] += ar * bi + ai * br;
+            }
+        }
+
+        // acc += a * (IR partition `partition` of `channel` in `stage`)
+        void multiplyAccumulate(float *acc, const float *a, const PartitionedIR &ir, const PartitionedIR::Stage &stage,
+                                int channel, int partition, int numBins)
+        {
+            switch (ir.storage)
+            {
+            case SampleStorage::Float16:
+                multiplyAccumulate<Float16Format>(acc, a, stage.getCompactPartition(channel, partition), stage.compactGain, numBins);
+                break;
+            case SampleStorage::BFloat16:
+                multiplyAccumulate<BFloat16Format>(acc, a, stage.getCompactPartition(channel, partition), stage.compactGain, numBins);
+                break;
+            default:
+                multiplyAccumulate<Float32Format>(acc, a, stage.getPartition(channel, partition), 1.0f, numBins);
+                break;
+            }
+        }
+
+        // Convert a stage's float spectra to 16-bit storage, scaled by a
+        // power of two (exact) so the peak lands just under 2^15
+        void compactStage(PartitionedIR::Stage &stage, SampleStorage storage)
+        {
+            float peak = 0.0f;
+            for (auto &ch : stage.spectra)
+                for (float v : ch)
+                    peak = juce::jmax(peak, std::abs(v));
+
+            int exponent = 0;
+            if (peak > 0.0f)
+                std::frexp(peak, &exponent);
+            const float scale = std::ldexp(1.0f, 15 - exponent);
+            stage.compactGain = 1.0f / scale;
+
+            std::vector<float> scaled;
+            stage.compactSpectra.resize(stage.spectra.size());
+            for (size_t ch = 0; ch < stage.spectra.size(); ++ch)
+            {
+                auto &source = stage.spectra[ch];
+                scaled.resize(source.size());
+                juce::FloatVectorOperations::multiply(scaled.data(), source.data(), scale, static_cast<int>(source.size()));
+
+                auto &compact = stage.compactSpectra[ch];
+                compact.resize(source.size());
+                if (storage == SampleStorage::Float16)
+                    encode<Float16Format>(scaled.data(), compact.data(), static_cast<int>(scaled.size()));
+                else
+                    encode<BFloat16Format>(scaled.data(), compact.data(), static_cast<int>(scaled.size()));
+            }
+            stage.spectra.clear();
+        }
+    } // namespace
+
+    // ---------------------------------------------------------------------------
+    // PartitionedIR
+    // ---------------------------------------------------------------------------
+
+    size_t PartitionedIR::getSizeInBytes() const
+    {
+        size_t bytes = sizeof(PartitionedIR);
+        for (auto &stage : stages)
+        {
+            for (auto &ch : stage.spectra)
+                bytes += ch.size() * sizeof(float);
+            for (auto &ch : stage.compactSpectra)
+                bytes += ch.size() * sizeof(uint16_t);
+        }
+        return bytes;
+    }
+
+    std::shared_ptr<const PartitionedIR> PartitionedIR::create(const std::vector<std::vector<float>> &channels,
+                                                               double sampleRate, int headSize, SampleStorage storage)
+    {
+        auto result = std::make_shared<PartitionedIR>();
+        result->storage = storage;
+        result->numChannels = static_cast<int>(channels.size());
+        result->length = channels.empty() ? 0 : static_cast<int>(channels[0].size());
+        result->headSize = headSize;
+        result->sampleRate = sampleRate;
+
+        if (result->numChannels == 0 || result->length == 0 || headSize <= 0)
+            return result;
+
+        const int length = result->length;
+
+        // Plan the stages (see class comment)
+        {
+            Stage head;
+            head.partitionSize = headSize;
+            head.offset = 0;
+            const int end = juce::jmin(length, 2 * headSize * STAGE_GROWTH);
+            head.numPartitions = (end + headSize - 1) / headSize;
+            result->stages.push_back(std::move(head));
+        }
+
+        int offset = 2 * headSize * STAGE_GROWTH;
+        int nominalSize = headSize;
+        for (int s = 1; s < MAX_STAGES && offset < length; ++s)
+        {
+            nominalSize *= STAGE_GROWTH;
+
+            Stage stage;
+            stage.partitionSize = juce::jmin(nominalSize, MAX_PARTITION);
+            stage.offset = offset;
+            const int end = (s == MAX_STAGES - 1) ? length : juce::jmin(length, offset * STAGE_GROWTH);
+            stage.numPartitions = (end - offset + stage.partitionSize - 1) / stage.partitionSize;
+            result->stages.push_back(std::move(stage));
+            offset = end;
+        }
+
+        // Transform every partition of every channel
+        for (auto &stage : result->stages)
+        {
+            const int P = stage.partitionSize;
+            const int specSize = getSpectrumSize(P);
+            juce::dsp::FFT fft(fftOrderFor(2 * P));
+            std::vector<float> scratch(static_cast<size_t>(4 * P));
+
+            stage.spectra.resize(channels.size());
+            for (size_t ch = 0; ch < channels.size(); ++ch)
+            {
+                auto &spectra = stage.spectra[ch];
+                spectra.resize(static_cast<size_t>(stage.numPartitions) * static_cast<size_t>(specSize));
+
+                for (int p = 0; p < stage.numPartitions; ++p)
+                {
+                    const int start = stage.offset + p * P;
+                    const int count = juce::jmin(P, length - start);
+
+                    std::fill(scratch.begin(), scratch.end(), 0.0f);
+                    if (count > 0)
+                        std::copy(channels[ch].begin() + start, channels[ch].begin() + start + count, scratch.begin());
+
+                    fft.performRealOnlyForwardTransform(scratch.data(), true);
+                    std::copy(scratch.begin(), scratch.begin() + specSize,
+                              spectra.begin() + static_cast<ptrdiff_t>(p) * specSize);
+                }
+            }
+
+            if (storage != SampleStorage::Float32)
+                compactStage(stage, storage);
+        }
+
+        return result;
+    }
+
+    // ---------------------------------------------------------------------------
+    // PartitionedConvolver
+    // ---------------------------------------------------------------------------
+
+    PartitionedConvolver::PartitionedConvolver(std::shared_ptr<const PartitionedIR> partitionedIR, int channels,
+                                               ConvolutionWorkerPool *workerPool)
+        : ir(std::move(partitionedIR)), numChannels(channels), pool(workerPool)
+    {
+        int maxPartition = 0;
+
+        for (size_t s = 0; s < ir->stages.size(); ++s)
+        {
+            const auto &irStage = ir->stages[s];
+
+            Stage stage;
+            stage.ir = &irStage;
+            stage.partitionSize = irStage.partitionSize;
+            stage.spectrumSize = PartitionedIR::getSpectrumSize(irStage.partitionSize);
+            stage.fft = std::make_unique<juce::dsp::FFT>(fftOrderFor(2 * irStage.partitionSize));
+
+            if (s == 0)
+            {
+                // Head: FDL holds partitions 1..N-1, the current block is
+                // transformed on every call.
+                stage.delayBlocks = 0;
+                stage.fdlLength = irStage.numPartitions - 1;
+            }
+            else
+            {
+                stage.delayBlocks = irStage.offset / irStage.partitionSize - 1;
+                stage.fdlLength = stage.delayBlocks + irStage.numPartitions;
+            }
+
+            const size_t P = static_cast<size_t>(stage.partitionSize);
+            stage.channels.resize(static_cast<size_t>(numChannels));
+            for (auto &cs : stage.channels)
+            {
+                cs.input.assign(2 * P, 0.0f);
+                cs.fdl.assign(static_cast<size_t>(stage.fdlLength) * static_cast<size_t>(stage.spectrumSize), 0.0f);
+                cs.carry.assign(s == 0 ? static_cast<size_t>(stage.spectrumSize) : P, 0.0f);
+            }
+
+            maxPartition = juce::jmax(maxPartition, stage.partitionSize);
+            stages.push_back(std::move(stage));
+        }
+
+        // JUCE's real-only transforms need 2 × FFT size floats of storage
+        fftScratch.assign(static_cast<size_t>(4 * maxPartition), 0.0f);
+        spectrumScratch.assign(static_cast<size_t>(4 * maxPartition), 0.0f);
+
+        // Hand the big tail stages to the pool. Smaller ones are cheaper to
+        // run inline than to schedule. Tasks keep references into `stages`,
+        // so they are created only once the vector is final.
+        if (pool != nullptr)
+        {
+            for (size_t s = 1; s < stages.size(); ++s)
+            {
+                auto &stage = stages[s];
+                if (stage.partitionSize < MIN_ASYNC_PARTITION || stage.delayBlocks < 1)
+                    continue;
+
+                const size_t P = static_cast<size_t>(stage.partitionSize);
+                for (auto &cs : stage.channels)
+                {
+                    cs.taskInput.assign(2 * P, 0.0f);
+                    cs.pending.assign(P, 0.0f);
+                }
+                stage.taskScratch.assign(8 * P, 0.0f);
+                stage.task = std::make_unique<TailTask>(*this, stage);
+                pool->add(*stage.task);
+            }
+        }
+    }
+
+    PartitionedConvolver::~PartitionedConvolver()
+    {
+        for (auto &stage : stages)
+            if (stage.task != nullptr)
+                pool->remove(*stage.task);
+    }
+
+    void PartitionedConvolver::reset()
+    {
+        for (auto &stage : stages)
+        {
+            if (stage.task != nullptr)
+                pool->complete(*stage.task);
+
+            stage.fdlHead = 0;
+            stage.position = 0;
+            stage.taskChannels = 0;
+            for (auto &cs : stage.channels)
+            {
+                std::fill(cs.input.begin(), cs.input.end(), 0.0f);
+                std::fill(cs.fdl.begin(), cs.fdl.end(), 0.0f);
+                std::fill(cs.carry.begin(), cs.carry.end(), 0.0f);
+                std::fill(cs.pending.begin(), cs.pending.end(), 0.0f);
+            }
+        }
+    }
+
+    size_t PartitionedConvolver::getSizeInBytes() const
+    {
+        size_t bytes = sizeof(PartitionedConvolver) + (fftScratch.size() + spectrumScratch.size()) * sizeof(float);
+        for (auto &stage : stages)
+        {
+            bytes += stage.taskScratch.size() * sizeof(float);
+            for (auto &cs : stage.channels)
+                bytes += (cs.input.size() + cs.fdl.size() + cs.carry.size() + cs.taskInput.size() + cs.pending.size()) *
+                         sizeof(float);
+        }
+        return bytes;
+    }
+
+    void PartitionedConvolver::process(const float *const *input, float *const *output, int channels, int numSamples)
+    {
+        channels = juce::jmin(channels, numChannels);
+
+        for (int ch = 0; ch < channels; ++ch)
+            juce::FloatVectorOperations::clear(output[ch], numSamples);
+
+        if (stages.empty())
+            return;
+
+        processHead(stages[0], input, output, channels, numSamples);
+        for (size_t s = 1; s < stages.size(); ++s)
+            processTail(stages[s], input, output, channels, numSamples);
+    }
+
+    void PartitionedConvolver::processHead(Stage &stage, const float *const *input, float *const *output,
+                                           int channels, int numSamples)
+    {
+        const int P = stage.partitionSize;
+        const int specSize = stage.spectrumSize;
+        const int numBins = P + 1;
+        const int numPartitions = stage.ir->numPartitions;
+
+        int done = 0;
+        while (done < numSamples)
+        {
+            const int n = juce::jmin(numSamples - done, P - stage.position);
+            const bool blockComplete = stage.position + n == P;
+            const int nextHead = stage.fdlLength > 0 ? (stage.fdlHead + 1) % stage.fdlLength : 0;
+
+            for (int ch = 0; ch < channels; ++ch)
+            {
+                auto &cs = stage.channels[static_cast<size_t>(ch)];
+                const int irCh = juce::jmin(ch, ir->numChannels - 1);
+
+                juce::FloatVectorOperations::copy(cs.input.data() + P + stage.position, input[ch] + done, n);
+
+                // Zero-latency: transform the partially filled block every call
+                // and combine it with the precomputed older partitions.
+                juce::FloatVectorOperations::copy(fftScratch.data(), cs.input.data(), 2 * P);
+                juce::FloatVectorOperations::clear(fftScratch.data() + 2 * P, 2 * P);
+                stage.fft->performRealOnlyForwardTransform(fftScratch.data(), true);
+
+                juce::FloatVectorOperations::copy(spectrumScratch.data(), cs.carry.data(), specSize);
+                multiplyAccumulate(spectrumScratch.data(), fftScratch.data(), *ir, *stage.ir, irCh, 0, numBins);
+                stage.fft->performRealOnlyInverseTransform(spectrumScratch.data());
+
+                juce::FloatVectorOperations::add(output[ch] + done, spectrumScratch.data() + P + stage.position, n);
+
+                if (blockComplete && stage.fdlLength > 0)
+                {
+                    juce::FloatVectorOperations::copy(cs.fdl.data() + static_cast<size_t>(nextHead) * static_cast<size_t>(specSize),
+                                                      fftScratch.data(), specSize);
+                }
+            }
+
+            stage.position += n;
+            done += n;
+
+            if (blockComplete)
+            {
+                stage.fdlHead = nextHead;
+                stage.position = 0;
+
+                for (int ch = 0; ch < channels; ++ch)
+                {
+                    auto &cs = stage.channels[static_cast<size_t>(ch)];
+                    const int irCh = juce::jmin(ch, ir->numChannels - 1);
+
+                    // Precompute partitions 1..N-1 for the next block
+                    juce::FloatVectorOperations::clear(cs.carry.data(), specSize);
+                    for (int j = 1; j < numPartitions; ++j)
+                    {
+                        const int slot = (stage.fdlHead - (j - 1) + stage.fdlLength) % stage.fdlLength;
+                        multiplyAccumulate(cs.carry.data(),
+                                           cs.fdl.data() + static_cast<size_t>(slot) * static_cast<size_t>(specSize),
+                                           *ir, *stage.ir, irCh, j, numBins);
+                    }
+
+                    juce::FloatVectorOperations::copy(cs.input.data(), cs.input.data() + P, P);
+                }
+            }
+        }
+    }
+
+    void PartitionedConvolver::processTail(Stage &stage, const float *const *input, float *const *output,
+                                           int channels, int numSamples)
+    {
+        const int P = stage.partitionSize;
+
+        int done = 0;
+        while (done < numSamples)
+        {
+            const int n = juce::jmin(numSamples - done, P - stage.position);
+
+            for (int ch = 0; ch < channels; ++ch)
+            {
+                auto &cs = stage.channels[static_cast<size_t>(ch)];
+                juce::FloatVectorOperations::copy(cs.input.data() + P + stage.position, input[ch] + done, n);
+                juce::FloatVectorOperations::add(output[ch] + done, cs.carry.data() + stage.position, n);
+            }
+
+            stage.position += n;
+            done += n;
+
+            if (stage.position != P)
+                continue;
+
+            stage.position = 0;
+
+            if (stage.task == nullptr)
+            {
+                stage.fdlHead = (stage.fdlHead + 1) % stage.fdlLength;
+                for (int ch = 0; ch < channels; ++ch)
+                {
+                    auto &cs = stage.channels[static_cast<size_t>(ch)];
+                    computeTailBlock(stage, ch, cs.input.data(), cs.carry.data(),
+                                     fftScratch.data(), spectrumScratch.data(), stage.delayBlocks);
+                    juce::FloatVectorOperations::copy(cs.input.data(), cs.input.data() + P, P);
+                }
+                continue;
+            }
+
+            // Async: the block submitted one partition ago is due now. The
+            // new block isn't needed until the next boundary, so it uses one
+            // block less of FDL delay — the same partitions the synchronous
+            // path would multiply one boundary later.
+            collectTailBlock(stage);
+
+            stage.fdlHead = (stage.fdlHead + 1) % stage.fdlLength;
+            stage.taskChannels = channels;
+            for (int ch = 0; ch < channels; ++ch)
+            {
+                auto &cs = stage.channels[static_cast<size_t>(ch)];
+                juce::FloatVectorOperations::copy(cs.taskInput.data(), cs.input.data(), 2 * P);
+                juce::FloatVectorOperations::copy(cs.input.data(), cs.input.data() + P, P);
+            }
+
+            const auto period = static_cast<juce::int64>(static_cast<double>(P) / ir->sampleRate *
+                                                         static_cast<double>(juce::Time::getHighResolutionTicksPerSecond()));
+            pool->submit(*stage.task, juce::Time::getHighResolutionTicks() + period);
+        }
+    }
+
+    void PartitionedConvolver::collectTailBlock(Stage &stage)
+    {
+        if (pool->complete(*stage.task))
+            ++numLateBlocks;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto &cs = stage.channels[static_cast<size_t>(ch)];
+            if (ch < stage.taskChannels)
+                std::swap(cs.carry, cs.pending);
+            else
+                std::fill(cs.carry.begin(), cs.carry.end(), 0.0f);
+        }
+    }
+
+    void PartitionedConvolver::TailTask::run()
+    {
+        const int P = stage.partitionSize;
+        float *fftBuffer = stage.taskScratch.data();
+        float *spectrumBuffer = fftBuffer + 4 * P;
+
+        for (int ch = 0; ch < stage.taskChannels; ++ch)
+        {
+            auto &cs = stage.channels[static_cast<size_t>(ch)];
+            owner.computeTailBlock(stage, ch, cs.taskInput.data(), cs.pending.data(),
+                                   fftBuffer, spectrumBuffer, stage.delayBlocks - 1);
+        }
+    }
+
+    void PartitionedConvolver::computeTailBlock(Stage &stage, int ch, const float *window, float *result,
+                                                float *fftBuffer, float *spectrumBuffer, int delayBlocks)
+    {
+        auto &cs = stage.channels[static_cast<size_t>(ch)];
+        const int P = stage.partitionSize;
+        const int specSize = stage.spectrumSize;
+        const int irCh = juce::jmin(ch, ir->numChannels - 1);
+
+        juce::FloatVectorOperations::copy(fftBuffer, window, 2 * P);
+        juce::FloatVectorOperations::clear(fftBuffer + 2 * P, 2 * P);
+        stage.fft->performRealOnlyForwardTransform(fftBuffer, true);
+        juce::FloatVectorOperations::copy(cs.fdl.data() + static_cast<size_t>(stage.fdlHead) * static_cast<size_t>(specSize),
+                                          fftBuffer, specSize);
+
+        juce::FloatVectorOperations::clear(spectrumBuffer, specSize);
+        for (int j = 0; j < stage.ir->numPartitions; ++j)
+        {
+            const int slot = ((stage.fdlHead - delayBlocks - j) % stage.fdlLength + stage.fdlLength) % stage.fdlLength;
+            multiplyAccumulate(spectrumBuffer,
+                               cs.fdl.data() + static_cast<size_t>(slot) * static_cast<size_t>(specSize),
+                               *ir, *stage.ir, irCh, j, P + 1);
+        }
+        stage.fft->performRealOnlyInverseTransform(spectrumBuffer);
+
+        // Overlap-save: the second half is the valid output for this block.
+        // It is played back during the next P samples (one-partition latency,
+        // compensated by the stage offset).
+        juce::FloatVectorOperations::copy(result, spectrumBuffer + P, P);
+    }
+
+} // namespace rau
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "ConvolutionWorkerPool.h"
+#include "SampleFormat.h"
+#include <juce_dsp/juce_dsp.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace rau
+{
+
+    /**
+     * PartitionedIR — an impulse response split into frequency-domain
+     * partitions, ready for convolution.
+     *
+     * Immutable once built, so a single instance is shared (via IRCache)
+     * by every ConvolverNode that loads the same IR at the same sample
+     * rate and head size.
+     *
+     * Partitioning is non-uniform (Gardner-style): a head stage with small
+     * partitions of B = `headSize` samples keeps latency at zero, then each
+     * later stage uses partitions 8× larger so long tails cost far fewer
+     * FFTs per second.
+     *
+     *   stage 0: [0, 16B)      partitions of B   (zero latency)
+     *   stage 1: [16B, 128B)   partitions of 8B
+     *   stage 2: [128B, end)   partitions of 64B (capped at MAX_PARTITION)
+     *
+     * Every tail stage starts at least two of its own partitions in. One
+     * partition hides the stage's block latency; the other is slack, which
+     * lets the stage's work run on a worker thread for a whole partition
+     * period before the audio thread needs it.
+     *
+     * Partitions can be stored as float16 or bfloat16 to halve the IR's
+     * memory and the bandwidth of every block's multiply-accumulate. Each
+     * stage is then scaled by a power of two so its largest value sits
+     * near the top of float16's range, keeping quiet tails out of the
+     * subnormals; `compactGain` undoes it as partitions are read.
+     */
+    struct PartitionedIR
+    {
+        struct Stage
+        {
+            int partitionSize = 0; // P — FFT size is 2P
+            int offset = 0;        // first IR sample covered by this stage
+            int numPartitions = 0;
+
+            // [irChannel][partition * spectrumSize + k], JUCE real-FFT layout
+            // (interleaved re/im, bins 0..P).
+            // Float32 storage only; otherwise `compactSpectra`, same layout.
+            std::vector<std::vector<float>> spectra;
+            std::vector<std::vector<uint16_t>> compactSpectra;
+            float compactGain = 1.0f;
+
+            const float *getPartition(int channel, int partition) const
+            {
+                return spectra[static_cast<size_t>(channel)].data() +
+                       static_cast<size_t>(partition) * static_cast<size_t>(getSpectrumSize(partitionSize));
+            }
+
+            const uint16_t *getCompactPartition(int channel, int partition) const
+            {
+                return compactSpectra[static_cast<size_t>(channel)].data() +
+                       static_cast<size_t>(partition) * static_cast<size_t>(getSpectrumSize(partitionSize));
+            }
+        };
+
+        std::vector<Stage> stages;
+        SampleStorage storage = SampleStorage::Float32;
+        int numChannels = 0;
+        int length = 0;
+        int headSize = 0;
+        double sampleRate = 0.0;
+
+        size_t getSizeInBytes() const;
+
+        static constexpr int STAGE_GROWTH = 8;
+        static constexpr int MAX_STAGES = 3;
+        // Keeps JUCE's fallback FFT scratch on the stack (no allocation
+        // on the audio thread).
+        static constexpr int MAX_PARTITION = 8192;
+
+        static int getSpectrumSize(int partitionSize) { return 2 * (partitionSize + 1); }
+
+        /**
+         * Build partitions from de-interleaved IR channels. Allocates and
+         * runs FFTs — call from a background thread only.
+         */
+        static std::shared_ptr<const PartitionedIR> create(const std::vector<std::vector<float>> &channels,
+                                                           double sampleRate, int headSize,
+                                                           SampleStorage storage = SampleStorage::Float32);
+    };
+
+    /**
+     * PartitionedConvolver — per-instance convolution state (input history,
+     * frequency-domain delay lines, scratch) for a shared PartitionedIR.
+     *
+     * Construct on a background thread; process() is real-time safe and
+     * accepts any block size (it chunks internally at partition edges).
+     * Input channel c is convolved with IR channel min(c, irChannels - 1).
+     *
+     * Given a ConvolutionWorkerPool, tail stages with partitions of at
+     * least MIN_ASYNC_PARTITION are computed by the pool: a stage's block
+     * is submitted at one partition boundary and collected at the next.
+     * The head always runs on the audio thread. Output is bit-identical
+     * with or without the pool, including when a worker runs late.
+     */
+    class PartitionedConvolver
+    {
+    public:
+        PartitionedConvolver(std::shared_ptr<const PartitionedIR> ir, int numChannels,
+                             ConvolutionWorkerPool *pool = nullptr);
+        ~PartitionedConvolver();
+
+        static constexpr int MIN_ASYNC_PARTITION = 2048;
+
+        /** Clear all history (audio-thread safe, no allocation). */
+        void reset();
+
+        /** Convolve `numChannels` input channels into `output` (overwritten). */
+        void process(const float *const *input, float *const *output, int numChannels, int numSamples);
+
+        int getNumChannels() const { return numChannels; }
+        const PartitionedIR &getIR() const { return *ir; }
+
+        /** Bytes owned by this instance (excludes the shared IR partitions). */
+        size_t getSizeInBytes() const;
+
+        /** Tail blocks the pool didn't finish before their deadline. */
+        uint32_t getNumLateBlocks() const { return numLateBlocks; }
+
+    private:
+        struct ChannelState
+        {
+            std::vector<float> input; // 2P: previous block + current block
+            std::vector<float> fdl;   // frequency-domain delay line (ring)
+            std::vector<float> carry; // head: summed older partitions; tail: output block
+
+            // Async tail stages: the task's input window and the block it
+            // is computing (swapped into `carry` when collected)
+            std::vector<float> taskInput;
+            std::vector<float> pending;
+        };
+
+        struct Stage;
+
+        class TailTask : public ConvolutionWorkerPool::Task
+        {
+        public:
+            TailTask(PartitionedConvolver &c, Stage &s) : owner(c), stage(s) {}
+            void run() override;
+
+        private:
+            PartitionedConvolver &owner;
+            Stage &stage;
+        };
+
+        struct Stage
+        {
+            const PartitionedIR::Stage *ir = nullptr;
+            std::unique_ptr<juce::dsp::FFT> fft;
+            int partitionSize = 0;
+            int spectrumSize = 0;
+            int delayBlocks = 0; // tail stages: extra FDL offset beyond 1 block
+            int fdlLength = 0;   // ring entries
+            int fdlHead = 0;     // index of the newest entry
+            int position = 0;    // samples into the current block
+            std::vector<ChannelState> channels;
+
+            // Async tail stages only
+            std::unique_ptr<TailTask> task;
+            int taskChannels = 0;
+            std::vector<float> taskScratch; // private FFT scratch (2 × 4P)
+        };
+
+        void processHead(Stage &stage, const float *const *input, float *const *output, int numChannels, int numSamples);
+        void processTail(Stage &stage, const float *const *input, float *const *output, int numChannels, int numSamples);
+        void collectTailBlock(Stage &stage);
+        void computeTailBlock(Stage &stage, int channel, const float *window, float *result,
+                              float *fftBuffer, float *spectrumBuffer, int delayBlocks);
+
+        std::shared_ptr<const PartitionedIR> ir;
+        int numChannels = 0;
+        std::vector<Stage> stages;
+
+        ConvolutionWorkerPool *pool = nullptr;
+        uint32_t numLateBlocks = 0;
+
+        // Scratch sized for the largest stage (2 × FFT size floats)
+        std::vector<float> fftScratch;
+        std::vector<float> spectrumScratch;
+    };
+
+} // namespace rau
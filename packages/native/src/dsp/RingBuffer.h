@@ -0,0 +1,107 @@
+#pragma once
+
+#include "SampleFormat.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <cstring>
+#include <type_traits>
+
+namespace rau
+{
+
+    /**
+     * Block helpers for power-of-two ring buffers (`mask` = size - 1).
+     *
+     * `start` may be any integer, including negative, and is masked. A run
+     * of samples is split into at most two contiguous segments around the
+     * wrap point, each handled with a single copy or vector op.
+     *
+     * The ring holds `Format::Storage` samples (float by default; see
+     * SampleFormat.h), converted to and from float as they're accessed.
+     */
+    namespace ring
+    {
+        template <typename Fn>
+        inline void forEachSegment(int start, int numSamples, int mask, Fn &&fn)
+        {
+            const int pos = start & mask;
+            const int first = juce::jmin(numSamples, mask + 1 - pos);
+            fn(pos, 0, first);
+            if (first < numSamples)
+                fn(0, first, numSamples - first);
+        }
+
+        /** dest[i] = ring[start + i] */
+        template <typename Format = Float32Format>
+        inline void read(const typename Format::Storage *ring, int mask, int start, float *dest, int numSamples)
+        {
+            forEachSegment(start, numSamples, mask, [&](int pos, int offset, int n)
+                           {
+                if constexpr (std::is_same_v<Format, Float32Format>)
+                    std::memcpy(dest + offset, ring + pos, static_cast<size_t>(n) * sizeof(float));
+                else
+                    decode<Format>(ring + pos, dest + offset, n); });
+        }
+
+        /** dest[i] += ring[start + i] * gain */
+        template <typename Format = Float32Format>
+        inline void addFrom(const typename Format::Storage *ring, int mask, int start, float *dest, float gain, int numSamples)
+        {
+            forEachSegment(start, numSamples, mask, [&](int pos, int offset, int n)
+                           {
+                if constexpr (std::is_same_v<Format, Float32Format>)
+                {
+                    juce::FloatVectorOperations::addWithMultiply(dest + offset, ring + pos, gain, n);
+                }
+                else
+                {
+                    for (int i = 0; i < n; ++i)
+                        dest[offset + i] += Format::load(ring[pos + i]) * gain;
+                } });
+        }
+
+        /** ring[start + i] = src[i] */
+        template <typename Format = Float32Format>
+        inline void write(typename Format::Storage *ring, int mask, int start, const float *src, int numSamples)
+        {
+            forEachSegment(start, numSamples, mask, [&](int pos, int offset, int n)
+                           {
+                if constexpr (std::is_same_v<Format, Float32Format>)
+                    std::memcpy(ring + pos, src + offset, static_cast<size_t>(n) * sizeof(float));
+                else
+                    encode<Format>(src + offset, ring + pos, n); });
+        }
+
+        /** ring[start + i] += src[i] * gain */
+        template <typename Format = Float32Format>
+        inline void addTo(typename Format::Storage *ring, int mask, int start, const float *src, float gain, int numSamples)
+        {
+            forEachSegment(start, numSamples, mask, [&](int pos, int offset, int n)
+                           {
+                if constexpr (std::is_same_v<Format, Float32Format>)
+                {
+                    juce::FloatVectorOperations::addWithMultiply(ring + pos, src + offset, gain, n);
+                }
+                else
+                {
+                    for (int i = 0; i < n; ++i)
+                        ring[pos + i] = Format::store(Format::load(ring[pos + i]) + src[offset + i] * gain);
+                } });
+        }
+
+        /**
+         * dest[i] = ring[start + i] * (1 - frac) + ring[start + i - 1] * frac,
+         * i.e. a linearly interpolated read `frac` samples further back.
+         */
+        template <typename Format = Float32Format>
+        inline void readInterpolated(const typename Format::Storage *ring, int mask, int start, float frac, float *dest, int numSamples)
+        {
+            read<Format>(ring, mask, start, dest, numSamples);
+            if (frac > 0.0f)
+            {
+                juce::FloatVectorOperations::multiply(dest, 1.0f - frac, numSamples);
+                addFrom<Format>(ring, mask, start - 1, dest, frac, numSamples);
+            }
+        }
+    } // namespace ring
+
+} // namespace rau
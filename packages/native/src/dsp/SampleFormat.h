@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace rau
+{
+
+    /**
+     * How a node stores long-lived sample data (delay lines, IR
+     * partitions). The 16-bit formats halve memory and bandwidth at a
+     * cost in precision: float16 keeps 11 significant bits (about 66 dB
+     * of signal-to-noise, ±65504), bfloat16 keeps float's range but only
+     * 8 bits (about 48 dB). Processing is always in float; values are
+     * converted as they're read and written.
+     */
+    enum class SampleStorage
+    {
+        Float32 = 0,
+        Float16 = 1,
+        BFloat16 = 2
+    };
+
+    /** The storage a node's "storage" parameter selects. */
+    inline SampleStorage sampleStorageFromParam(float value)
+    {
+        const int index = static_cast<int>(value + 0.5f);
+        return index == 1 ? SampleStorage::Float16 : index == 2 ? SampleStorage::BFloat16
+                                                                : SampleStorage::Float32;
+    }
+
+    /**
+     * Sample formats, for templates over storage. Each has a `Storage`
+     * type and converts one sample at a time; the conversions are plain
+     * integer arithmetic with no branches, so loops over them vectorise.
+     * Rounding is to nearest, ties to even.
+     */
+    struct Float32Format
+    {
+        using Storage = float;
+
+        static float load(float s) { return s; }
+        static float store(float v) { return v; }
+    };
+
+    struct Float16Format
+    {
+        using Storage = uint16_t;
+
+        static float load(uint16_t h)
+        {
+            // Move exponent and mantissa into place and rebias; infinities
+            // and NaNs take the float's top exponent, subnormals are
+            // renormalised by a float subtraction
+            constexpr uint32_t exponentMask = 0x7c00u << 13;
+            uint32_t bits = (static_cast<uint32_t>(h) & 0x7fffu) << 13;
+            const uint32_t exponent = bits & exponentMask;
+            bits += (127 - 15) << 23;
+            bits += exponent == exponentMask ? (128 - 16) << 23 : 0;
+            const uint32_t subnormal = toBits(fromBits(bits + (1u << 23)) - fromBits(113u << 23));
+            bits = exponent == 0 ? subnormal : bits;
+            return fromBits(bits | (static_cast<uint32_t>(h) & 0x8000u) << 16);
+        }
+
+        static uint16_t store(float v)
+        {
+            uint32_t bits = toBits(v);
+            const uint32_t sign = bits & 0x80000000u;
+            bits ^= sign;
+
+            // Too large: infinity (NaN stays NaN)
+            const uint32_t overflow = bits > (255u << 23) ? 0x7e00u : 0x7c00u;
+
+            // Too small for a normal half: let a float addition round the
+            // mantissa into the subnormal range
+            constexpr uint32_t magic = ((127 - 15) + (23 - 10) + 1) << 23;
+            const uint32_t subnormal = toBits(fromBits(bits) + fromBits(magic)) - magic;
+
+            // Normal: rebias and round the dropped 13 bits
+            const uint32_t normal = (bits + ((15u - 127u) << 23) + 0xfffu + ((bits >> 13) & 1u)) >> 13;
+
+            const uint32_t half = bits >= (143u << 23) ? overflow : bits < (113u << 23) ? subnormal
+                                                                                         : normal;
+            return static_cast<uint16_t>(half | sign >> 16);
+        }
+
+    private:
+        static uint32_t toBits(float f)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &f, sizeof(bits));
+            return bits;
+        }
+
+        static float fromBits(uint32_t bits)
+        {
+            float f;
+            std::memcpy(&f, &bits, sizeof(f));
+            return f;
+        }
+
+        friend struct BFloat16Format;
+    };
+
+    struct BFloat16Format
+    {
+        using Storage = uint16_t;
+
+        static float load(uint16_t b) { return Float16Format::fromBits(static_cast<uint32_t>(b) << 16); }
+
+        static uint16_t store(float v)
+        {
+            // A float's top half, rounded on the dropped bits. NaNs aren't
+            // special-cased: audio never carries them on purpose.
+            const uint32_t bits = Float16Format::toBits(v);
+            return static_cast<uint16_t>((bits + 0x7fffu + ((bits >> 16) & 1u)) >> 16);
+        }
+    };
+
+    /** dest[i] = load(src[i]) */
+    template <typename Format>
+    inline void decode(const typename Format::Storage *src, float *dest, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] = Format::load(src[i]);
+    }
+
+    /** dest[i] = store(src[i]) */
+    template <typename Format>
+    inline void encode(const float *src, typename Format::Storage *dest, int numSamples)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            dest[i] = Format::store(src[i]);
+    }
+
+} // namespace rau
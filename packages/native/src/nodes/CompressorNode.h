@@ -26,6 +26,9 @@ namespace rau
         void prepare(double sampleRate, int maxBlockSize) override;
         void process(int numSamples) override;
 
+        int getNumOutputChannels(int inputChannels) const override { return inputChannels; }
+        bool acceptsMonoInput(int inlet) const override { return inlet == 1; }
+
     private:
         float envelopeDb = 0.0f;
     };
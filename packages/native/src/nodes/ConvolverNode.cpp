@@ -1,31 +1,209 @@
 #include "ConvolverNode.h"
+#include <juce_audio_formats/juce_audio_formats.h>
 
 namespace rau
 {
 
+    // ---------------------------------------------------------------------------
+    // LoaderState
+    // ---------------------------------------------------------------------------
+
+    ConvolverNode::LoaderState::LoaderState()
+    {
+        for (auto &r : retired)
+            r.store(nullptr, std::memory_order_relaxed);
+    }
+
+    ConvolverNode::LoaderState::~LoaderState()
+    {
+        delete incoming.load(std::memory_order_acquire);
+        collectRetired();
+    }
+
+    void ConvolverNode::LoaderState::publish(std::unique_ptr<PartitionedConvolver> next)
+    {
+        collectRetired();
+        // An engine the audio thread never picked up is simply replaced
+        delete incoming.exchange(next.release(), std::memory_order_acq_rel);
+    }
+
+    void ConvolverNode::LoaderState::collectRetired()
+    {
+        for (auto &r : retired)
+            delete r.exchange(nullptr, std::memory_order_acq_rel);
+    }
+
+    void ConvolverNode::LoaderState::invalidate()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        ++sourceGeneration;
+        generation.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    // ---------------------------------------------------------------------------
+    // ConvolverNode
+    // ---------------------------------------------------------------------------
+
     ConvolverNode::ConvolverNode()
-        : convolution(juce::dsp::Convolution::NonUniform{512})
+        : loader(std::make_shared<LoaderState>())
     {
         addParam("mix", 0.5f);
         addParam("gain", 1.0f);
+        addParam("storage", 0.0f);
         addParam("bypass", 0.0f);
     }
 
+    ConvolverNode::~ConvolverNode()
+    {
+        // Invalidate any queued job, then free the engine we own. Pending
+        // jobs keep `loader` alive on their own.
+        loader->invalidate();
+        delete engine;
+    }
+
+    int ConvolverNode::headSizeForBlockSize(int blockSize)
+    {
+        return juce::jlimit(64, 1024, juce::nextPowerOfTwo(juce::jmax(1, blockSize)));
+    }
+
+    int ConvolverNode::headSizeFor(int blockSize) const
+    {
+        return headSizeForBlockSize(subBlockSize > 0 ? juce::jmin(subBlockSize, blockSize) : blockSize);
+    }
+
+    int ConvolverNode::getHeadSize() const
+    {
+        std::lock_guard<std::mutex> guard(loader->lock);
+        return loader->headSize;
+    }
+
     void ConvolverNode::prepare(double sr, int blockSize)
     {
         AudioNodeBase::prepare(sr, blockSize);
 
-        juce::dsp::ProcessSpec spec;
-        spec.sampleRate = sr;
-        spec.maximumBlockSize = static_cast<juce::uint32>(blockSize);
-        spec.numChannels = 2;
-        convolution.prepare(spec);
-
         // Pre-allocate the wet buffer so process() never allocates on the audio thread
-        wetBuffer.setSize(2, blockSize);
+        wetBuffer.setSize(NUM_CHANNELS, blockSize);
 
         mixSmoothed.reset(sr, 0.02); // 20ms smoothing
         mixSmoothed.setCurrentAndTargetValue(getParam("mix"));
+
+        // The running engine was built for the old config. prepare() never
+        // runs concurrently with process(), so it can be dropped here.
+        delete engine;
+        engine = nullptr;
+
+        {
+            std::lock_guard<std::mutex> guard(loader->lock);
+            loader->sampleRate = sr;
+            loader->headSize = headSizeFor(blockSize);
+            loader->storage = sampleStorageFromParam(getParam("storage"));
+        }
+
+        // Rebuilt here rather than on the worker, so a render starting
+        // right after prepareToPlay() isn't dry
+        buildEngineNow();
+    }
+
+    void ConvolverNode::reset()
+    {
+        // A reused convolver starts without an IR. Jobs still working for
+        // the old one keep its loader alive and drop their results.
+        loader->invalidate();
+        loader = std::make_shared<LoaderState>();
+        prepare(sampleRate, maxBlockSize);
+    }
+
+    void ConvolverNode::setSubBlockSize(int numSamples)
+    {
+        // The head's FFTs run on every call, so a head sized for longer
+        // blocks than the node gets multiplies its cost. The running
+        // engine plays on until the rebuilt one arrives.
+        subBlockSize = juce::jmax(0, numSamples);
+        {
+            std::lock_guard<std::mutex> guard(loader->lock);
+            const int headSize = headSizeFor(maxBlockSize);
+            if (loader->headSize == headSize)
+                return;
+            loader->headSize = headSize;
+        }
+        requestEngine();
+    }
+
+    void ConvolverNode::requestEngine()
+    {
+        {
+            std::lock_guard<std::mutex> guard(loader->lock);
+            if (!loader->source)
+                return;
+        }
+
+        const auto gen = loader->generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+        worker->post([state = loader, cache = irCache, gen]
+                     { buildEngine(*state, *cache, gen); });
+    }
+
+    void ConvolverNode::buildEngineNow()
+    {
+        // Supersedes any queued job; the engine is adopted at the start of
+        // the next block
+        const auto gen = loader->generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+        buildEngine(*loader, *irCache, gen);
+    }
+
+    void ConvolverNode::buildEngine(LoaderState &state, IRCache &cache, uint32_t gen)
+    {
+        if (state.generation.load(std::memory_order_acquire) != gen)
+            return; // superseded before we started
+
+        std::shared_ptr<const IRData> source;
+        double sr;
+        int headSize;
+        SampleStorage storage;
+        {
+            std::lock_guard<std::mutex> guard(state.lock);
+            source = state.source;
+            sr = state.sampleRate;
+            headSize = state.headSize;
+            storage = state.storage;
+        }
+
+        if (!source || source->getNumSamples() == 0)
+            return;
+
+        auto partitioned = cache.getPartitioned(source, sr, headSize, storage);
+        if (!partitioned || partitioned->stages.empty())
+            return;
+
+        auto next = std::make_unique<PartitionedConvolver>(std::move(partitioned), NUM_CHANNELS, state.pool.get());
+
+        // Checked and published in one step, so an older build that
+        // finishes late can't replace a newer one's engine
+        std::lock_guard<std::mutex> guard(state.lock);
+        if (state.generation.load(std::memory_order_acquire) == gen)
+            state.publish(std::move(next));
+    }
+
+    void ConvolverNode::adoptPendingEngine()
+    {
+        if (loader->incoming.load(std::memory_order_acquire) == nullptr)
+            return;
+
+        // Only the audio thread fills retire slots, so a free slot found
+        // here stays free until we use it.
+        for (auto &slot : loader->retired)
+        {
+            if (slot.load(std::memory_order_acquire) != nullptr)
+                continue;
+
+            auto *next = loader->incoming.exchange(nullptr, std::memory_order_acq_rel);
+            if (next == nullptr)
+                return;
+
+            slot.store(engine, std::memory_order_release);
+            engine = next;
+            return;
+        }
+        // All slots still awaiting collection — try again next block
     }
 
     void ConvolverNode::process(int numSamples)
@@ -33,6 +211,8 @@ namespace rau
         if (!outputBuffer.isValid())
             return;
 
+        adoptPendingEngine();
+
         auto &outBuf = *outputBuffer.buffer;
         const int numCh = outBuf.getNumChannels();
 
@@ -54,58 +234,94 @@ namespace rau
             return;
         }
 
-        if (!irLoaded)
+        if (engine == nullptr)
             return;
 
         float mix = getParam("mix");
         float gain = getParam("gain");
         mixSmoothed.setTargetValue(mix);
 
-        // Use the pre-allocated wet buffer (sized in prepare())
-        for (int ch = 0; ch < numCh; ++ch)
-            wetBuffer.copyFrom(ch, 0, outBuf, ch, 0, numSamples);
-
-        // Process convolution on the wet buffer
-        juce::dsp::AudioBlock<float> block(wetBuffer);
-        juce::dsp::ProcessContextReplacing<float> context(block);
-        convolution.process(context);
+        const int wetCh = juce::jmin(numCh, wetBuffer.getNumChannels());
+        engine->process(outBuf.getArrayOfReadPointers(), wetBuffer.getArrayOfWritePointers(), wetCh, numSamples);
 
-        // Mix dry/wet
+        // Mix dry/wet. Channels past the engine's pair have no wet
+        // signal, but still take the dry share and the gain.
         for (int sample = 0; sample < numSamples; ++sample)
         {
-            float m = mixSmoothed.getNextValue();
-            for (int ch = 0; ch < numCh; ++ch)
+            const float m = mixSmoothed.getNextValue();
+            for (int ch = 0; ch < wetCh; ++ch)
             {
-                float dry = outBuf.getSample(ch, sample);
-                float wet = wetBuffer.getSample(ch, sample);
-                outBuf.setSample(ch, sample, (dry * (1.0f - m) + wet * m) * gain);
+                float *out = outBuf.getWritePointer(ch);
+                const float wet = wetBuffer.getReadPointer(ch)[sample];
+                out[sample] = (out[sample] * (1.0f - m) + wet * m) * gain;
             }
+            for (int ch = wetCh; ch < numCh; ++ch)
+                outBuf.getWritePointer(ch)[sample] *= (1.0f - m) * gain;
         }
     }
 
     void ConvolverNode::loadIR(const float *data, int numSamples, int numChannels, double irSampleRate)
     {
-        if (data == nullptr || numSamples <= 0)
+        if (data == nullptr || numSamples <= 0 || numChannels <= 0)
             return;
 
-        // Create an AudioBuffer from the raw data
-        juce::AudioBuffer<float> irBuffer(numChannels, numSamples);
-        for (int ch = 0; ch < numChannels; ++ch)
+        // De-interleave in a single pass straight into the cache's layout
+        std::vector<std::vector<float>> channels(static_cast<size_t>(numChannels),
+                                                 std::vector<float>(static_cast<size_t>(numSamples)));
+        for (int i = 0; i < numSamples; ++i)
         {
-            for (int i = 0; i < numSamples; ++i)
-            {
-                irBuffer.setSample(ch, i, data[i * numChannels + ch]);
-            }
+            const float *frame = data + static_cast<size_t>(i) * static_cast<size_t>(numChannels);
+            for (int ch = 0; ch < numChannels; ++ch)
+                channels[static_cast<size_t>(ch)][static_cast<size_t>(i)] = frame[ch];
         }
 
-        convolution.loadImpulseResponse(
-            std::move(irBuffer),
-            irSampleRate,
-            numChannels == 1 ? juce::dsp::Convolution::Stereo::no : juce::dsp::Convolution::Stereo::yes,
-            juce::dsp::Convolution::Trim::yes,
-            juce::dsp::Convolution::Normalise::yes);
+        auto ir = irCache->intern(std::move(channels), irSampleRate);
+        {
+            std::lock_guard<std::mutex> guard(loader->lock);
+            loader->source = std::move(ir);
+            ++loader->sourceGeneration;
+        }
+        requestEngine();
+    }
+
+    void ConvolverNode::loadIR(const IRData &ir)
+    {
+        if (ir.getNumChannels() == 0 || ir.getNumSamples() == 0)
+            return;
+
+        auto interned = irCache->intern(ir.channels, ir.sampleRate);
+        {
+            // Already running this IR (a node kept across a restore)
+            std::lock_guard<std::mutex> guard(loader->lock);
+            if (loader->source == interned)
+                return;
+            loader->source = std::move(interned);
+            ++loader->sourceGeneration;
+        }
+        requestEngine();
+    }
+
+    void ConvolverNode::loadIRSync(const IRData &ir)
+    {
+        if (ir.getNumChannels() == 0 || ir.getNumSamples() == 0)
+            return;
+
+        auto interned = irCache->intern(ir.channels, ir.sampleRate);
+        {
+            // Already running this IR (a node kept across a restore)
+            std::lock_guard<std::mutex> guard(loader->lock);
+            if (loader->source == interned)
+                return;
+            loader->source = std::move(interned);
+            ++loader->sourceGeneration;
+        }
+        buildEngineNow();
+    }
 
-        irLoaded = true;
+    std::shared_ptr<const IRData> ConvolverNode::getIR() const
+    {
+        std::lock_guard<std::mutex> guard(loader->lock);
+        return loader->source;
     }
 
     void ConvolverNode::loadIRFromFile(const void *fileData, size_t fileSize)
@@ -113,14 +329,46 @@ namespace rau
         if (fileData == nullptr || fileSize == 0)
             return;
 
-        convolution.loadImpulseResponse(
-            fileData, fileSize,
-            juce::dsp::Convolution::Stereo::yes,
-            juce::dsp::Convolution::Trim::yes,
-            0, // use entire file
-            juce::dsp::Convolution::Normalise::yes);
+        auto bytes = std::make_shared<std::vector<char>>(static_cast<const char *>(fileData),
+                                                         static_cast<const char *>(fileData) + fileSize);
+        uint32_t sourceGen;
+        {
+            std::lock_guard<std::mutex> guard(loader->lock);
+            sourceGen = ++loader->sourceGeneration;
+        }
+
+        worker->post([state = loader, cache = irCache, bytes, sourceGen]
+                     {
+            juce::AudioFormatManager formatManager;
+            formatManager.registerBasicFormats();
 
-        irLoaded = true;
+            std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(
+                std::make_unique<juce::MemoryInputStream>(bytes->data(), bytes->size(), false)));
+            if (reader == nullptr || reader->lengthInSamples <= 0)
+                return;
+
+            const int numChannels = juce::jmin(static_cast<int>(reader->numChannels), NUM_CHANNELS);
+            const int numSamples = static_cast<int>(reader->lengthInSamples);
+
+            juce::AudioBuffer<float> decoded(numChannels, numSamples);
+            reader->read(&decoded, 0, numSamples, 0, true, numChannels > 1);
+
+            std::vector<std::vector<float>> channels(static_cast<size_t>(numChannels));
+            for (int ch = 0; ch < numChannels; ++ch)
+                channels[static_cast<size_t>(ch)].assign(decoded.getReadPointer(ch),
+                                                         decoded.getReadPointer(ch) + numSamples);
+
+            // Dropped if another IR was loaded meanwhile. A prepare() that
+            // ran meanwhile only rebuilt the old IR's engine, so this one
+            // still gets an engine, under a generation of its own.
+            auto ir = cache->intern(std::move(channels), reader->sampleRate);
+            {
+                std::lock_guard<std::mutex> guard(state->lock);
+                if (state->sourceGeneration != sourceGen)
+                    return;
+                state->source = std::move(ir);
+            }
+            buildEngine(*state, *cache, state->generation.fetch_add(1, std::memory_order_acq_rel) + 1); });
     }
 
 } // namespace rau
@@ -1,6 +1,12 @@
 #pragma once
 #include "NodeBase.h"
-#include <juce_dsp/juce_dsp.h>
+#include "../BackgroundWorker.h"
+#include "../dsp/IRCache.h"
+#include "../dsp/PartitionedConvolver.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace rau
@@ -10,26 +16,41 @@ namespace rau
      * ConvolverNode — IR-based convolution reverb.
      *
      * Convolves the input signal with an impulse response loaded from
-     * BinaryData or provided as raw samples. Uses JUCE's uniformly-partitioned
-     * convolution engine for efficient frequency-domain processing.
+     * BinaryData or provided as raw samples. Uses a non-uniformly
+     * partitioned, zero-latency FFT engine (PartitionedConvolver). The
+     * engine convolves the first two channels; on wider layouts the rest
+     * get the dry share of the mix and the gain, without reverb.
      *
      * Parameters:
      *   mix      - Dry/wet blend (0 = fully dry, 1 = fully wet, default 0.5)
      *   gain     - Output gain (default 1.0)
+     *   storage  - IR partition storage: 0 = float32 (default), 1 = float16,
+     *              2 = bfloat16 (see SampleStorage). Takes effect when the
+     *              node is prepared or reset.
      *   bypass   - Bypass flag
      *
-     * The IR is loaded via loadIR() from the message thread. The convolution
-     * engine is prepared on the audio thread automatically.
+     * IRs are interned in the process-wide IRCache, so identical IRs share
+     * one copy of their frequency-domain partitions across nodes and plugin
+     * instances. Decoding, resampling and partitioning of a new IR run on
+     * the shared BackgroundWorker; the finished engine is handed to the
+     * audio thread lock-free and the node stays dry until it arrives.
+     * prepare() and loadIRSync() build it in place instead. Large tail
+     * partitions of long IRs are computed by the shared
+     * ConvolutionWorkerPool rather than on the audio thread.
      */
     class ConvolverNode : public AudioNodeBase
     {
     public:
         ConvolverNode();
+        ~ConvolverNode() override;
+
         void prepare(double sampleRate, int maxBlockSize) override;
+        void reset() override;
+        void setSubBlockSize(int numSamples) override;
         void process(int numSamples) override;
 
         /**
-         * Load an impulse response from raw sample data.
+         * Load an impulse response from raw sample data (message thread).
          * @param data        Pointer to float samples (interleaved if stereo)
          * @param numSamples  Number of samples per channel
          * @param numChannels Number of channels (1 or 2)
@@ -38,16 +59,91 @@ namespace rau
         void loadIR(const float *data, int numSamples, int numChannels, double irSampleRate);
 
         /**
-         * Load an impulse response from a WAV/AIFF file in memory.
+         * Load an impulse response from a WAV/AIFF file in memory (message thread).
+         * The data is copied; decoding happens on the background worker.
          * @param fileData Pointer to the raw file data (WAV/AIFF)
          * @param fileSize Size in bytes
          */
         void loadIRFromFile(const void *fileData, size_t fileSize);
 
+        /**
+         * Load an impulse response held elsewhere, e.g. one read back from
+         * saved state (message thread). Identical IRs still share one copy.
+         */
+        void loadIR(const IRData &ir);
+
+        /**
+         * Like loadIR(), but the engine is built before this returns and
+         * plays from the next block. Slow: for restoring saved state, where
+         * an offline render may start straight away.
+         */
+        void loadIRSync(const IRData &ir);
+
+        /** The loaded IR, or null if none has been decoded yet (message thread). */
+        std::shared_ptr<const IRData> getIR() const;
+
+        /** Head partition size used for a given host block size. */
+        static int headSizeForBlockSize(int blockSize);
+
+        /** The head partition size engines are built with (message thread). */
+        int getHeadSize() const;
+
     private:
-        juce::dsp::Convolution convolution;
+        static constexpr int NUM_CHANNELS = 2;
+
+        /**
+         * State shared between the node and its background jobs. Jobs hold
+         * a shared_ptr, so a node can be destroyed while a load is pending.
+         */
+        struct LoaderState
+        {
+            LoaderState();
+            ~LoaderState();
+
+            // Declared first so it outlives every engine freed below
+            juce::SharedResourcePointer<ConvolutionWorkerPool> pool;
+
+            // Message thread / worker — guarded by `lock`
+            std::mutex lock;
+            std::shared_ptr<const IRData> source;
+            double sampleRate = 44100.0;
+            int headSize = 512;
+            SampleStorage storage = SampleStorage::Float32;
+
+            // Bumped for every new IR; a decode job whose IR was replaced
+            // meanwhile drops it. Guarded by `lock`.
+            uint32_t sourceGeneration = 0;
+
+            // Bumped for every engine build; stale builds drop their result.
+            std::atomic<uint32_t> generation{0};
+
+            // Worker → audio thread handoff. The audio thread parks the
+            // engine it replaces in `retired`; the worker frees it later.
+            std::atomic<PartitionedConvolver *> incoming{nullptr};
+            std::array<std::atomic<PartitionedConvolver *>, 4> retired;
+
+            void publish(std::unique_ptr<PartitionedConvolver> engine);
+            void collectRetired();
+            void invalidate();
+        };
+
+        static void buildEngine(LoaderState &state, IRCache &cache, uint32_t generation);
+        void requestEngine();
+        void buildEngineNow();
+        void adoptPendingEngine();
+
+        juce::SharedResourcePointer<IRCache> irCache;
+        juce::SharedResourcePointer<BackgroundWorker> worker;
+
+        // The graph's sub-block size (0 for none); the head is sized for
+        // the blocks process() actually gets
+        int subBlockSize = 0;
+        int headSizeFor(int blockSize) const;
+        std::shared_ptr<LoaderState> loader;
+
+        // Audio thread only
+        PartitionedConvolver *engine = nullptr;
         juce::SmoothedValue<float> mixSmoothed;
-        bool irLoaded = false;
 
         // Pre-allocated wet buffer — avoids heap allocation on the audio thread
         juce::AudioBuffer<float> wetBuffer;
@@ -0,0 +1,97 @@
+#include "CrossoverNode.h"
+
+namespace rau
+{
+
+    CrossoverNode::CrossoverNode()
+    {
+        nodeType = "crossover";
+        addParam("lowCrossover", 200.0f);   // Hz, between bands 0 and 1
+        addParam("midCrossover", 1000.0f);  // Hz, between bands 1 and 2
+        addParam("highCrossover", 5000.0f); // Hz, between bands 2 and 3
+        addParam("bypass", 0.0f);
+        setNumOutlets(NUM_BANDS);
+
+        lowAllpass.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
+        highAllpass.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
+    }
+
+    void CrossoverNode::prepare(double sr, int maxBlock)
+    {
+        AudioNodeBase::prepare(sr, maxBlock);
+
+        const juce::dsp::ProcessSpec spec{sr, static_cast<juce::uint32>(maxBlock), static_cast<juce::uint32>(maxChannels)};
+        for (auto *filter : {&midSplit, &lowSplit, &lowAllpass, &highSplit, &highAllpass})
+        {
+            filter->prepare(spec);
+            filter->reset();
+        }
+
+        prevLow = -1.0f; // force frequency update
+        updateFrequencies();
+    }
+
+    void CrossoverNode::updateFrequencies()
+    {
+        // Keep the three frequencies ordered and below Nyquist
+        const float maxFreq = static_cast<float>(sampleRate * 0.45);
+        const float low = juce::jlimit(20.0f, maxFreq, getParam("lowCrossover"));
+        const float mid = juce::jlimit(low, maxFreq, getParam("midCrossover"));
+        const float high = juce::jlimit(mid, maxFreq, getParam("highCrossover"));
+
+        if (low == prevLow && mid == prevMid && high == prevHigh)
+            return;
+
+        midSplit.setCutoffFrequency(mid);
+        lowSplit.setCutoffFrequency(low);
+        highAllpass.setCutoffFrequency(low);
+        highSplit.setCutoffFrequency(high);
+        lowAllpass.setCutoffFrequency(high);
+
+        prevLow = low;
+        prevMid = mid;
+        prevHigh = high;
+    }
+
+    void CrossoverNode::process(int numSamples)
+    {
+        if (inputBuffers.empty() || !inputBuffers[0].isValid())
+            return;
+
+        std::array<juce::AudioBuffer<float> *, NUM_BANDS> bands{};
+        int numChannels = juce::jmin(inputBuffers[0].buffer->getNumChannels(), maxChannels);
+        for (int band = 0; band < NUM_BANDS; ++band)
+        {
+            auto ref = getOutputBuffer(band);
+            if (!ref.isValid())
+                return;
+            bands[static_cast<size_t>(band)] = ref.buffer;
+            numChannels = juce::jmin(numChannels, ref.buffer->getNumChannels());
+        }
+
+        updateFrequencies();
+
+        auto &in = *inputBuffers[0].buffer;
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const float *src = in.getReadPointer(ch);
+            float *band0 = bands[0]->getWritePointer(ch);
+            float *band1 = bands[1]->getWritePointer(ch);
+            float *band2 = bands[2]->getWritePointer(ch);
+            float *band3 = bands[3]->getWritePointer(ch);
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                float lowHalf, highHalf;
+                midSplit.processSample(ch, src[i], lowHalf, highHalf);
+
+                lowHalf = lowAllpass.processSample(ch, lowHalf);
+                highHalf = highAllpass.processSample(ch, highHalf);
+
+                lowSplit.processSample(ch, lowHalf, band0[i], band1[i]);
+                highSplit.processSample(ch, highHalf, band2[i], band3[i]);
+            }
+        }
+    }
+
+} // namespace rau
@@ -0,0 +1,40 @@
+#pragma once
+#include "NodeBase.h"
+
+namespace rau
+{
+
+    /**
+     * CrossoverNode — 4-band Linkwitz-Riley (24 dB/oct) crossover.
+     *
+     * Splits inlet 0 into four bands on outlets 0-3 (low to high) in one
+     * pass. The input is first split at the mid frequency; the low half is
+     * split again at the low frequency and the high half at the high
+     * frequency. Each half also runs through an allpass at the other
+     * half's frequency so all four bands stay phase-aligned and sum back
+     * to a flat (allpassed) response.
+     */
+    class CrossoverNode : public AudioNodeBase
+    {
+    public:
+        static constexpr int NUM_BANDS = 4;
+
+        CrossoverNode();
+        void prepare(double sampleRate, int maxBlockSize) override;
+        void process(int numSamples) override;
+
+        int getNumOutputChannels(int inputChannels) const override { return inputChannels; }
+
+    private:
+        void updateFrequencies();
+
+        juce::dsp::LinkwitzRileyFilter<float> midSplit;
+        juce::dsp::LinkwitzRileyFilter<float> lowSplit, lowAllpass;
+        juce::dsp::LinkwitzRileyFilter<float> highSplit, highAllpass;
+
+        float prevLow = -1.0f;
+        float prevMid = -1.0f;
+        float prevHigh = -1.0f;
+    };
+
+} // namespace rau
@@ -1,13 +1,21 @@
 #include "DelayNode.h"
+#include "../dsp/RingBuffer.h"
 #include <cmath>
 
 namespace rau
 {
 
+    namespace
+    {
+        using FVO = juce::FloatVectorOperations;
+    } // namespace
+
     DelayNode::DelayNode()
     {
         nodeType = "delay";
         addParam("time", 500.0f);   // ms
+        addParam("maxTime", MAX_DELAY_MS);
+        addParam("storage", 0.0f);
         addParam("feedback", 0.0f); // 0–1
         addParam("mix", 1.0f);      // dry/wet
         addParam("bypass", 0.0f);
@@ -17,19 +25,57 @@ namespace rau
     {
         AudioNodeBase::prepare(sr, maxBlock);
 
-        // Allocate delay buffer for max delay time
-        delayBufferSize = static_cast<int>(std::ceil(MAX_DELAY_MS * sr / 1000.0)) + 1;
-        delayBuffer.resize(2); // stereo
-        for (auto &ch : delayBuffer)
-        {
-            ch.assign(delayBufferSize, 0.0f);
-        }
+        // Room for the longest delay, one block of writes and the
+        // interpolator's second tap
+        maxDelaySamples = maxTimeInSamples();
+        const int size = juce::nextPowerOfTwo(static_cast<int>(maxDelaySamples) + maxBlock + 2);
+        const size_t lineSamples = static_cast<size_t>(maxChannels) * static_cast<size_t>(size);
+        storage = sampleStorageFromParam(getParam("storage"));
+        const bool compact = storage != SampleStorage::Float32;
+        allocateState(delayLines, compact ? 0 : lineSamples);
+        allocateState(compactLines, compact ? lineSamples : 0);
+        numLines = (compact ? compactLines.empty() : delayLines.empty()) ? 0 : maxChannels;
+        ringMask = size - 1;
         writePos = 0;
 
+        wet.assign(static_cast<size_t>(maxBlock), 0.0f);
+        lineInput.assign(static_cast<size_t>(maxBlock), 0.0f);
+        readIndex.assign(static_cast<size_t>(maxBlock), 0);
+        readFrac.assign(static_cast<size_t>(maxBlock), 0.0f);
+
         smoothedTime.reset(sr, 0.05); // 50ms smoothing for delay time changes
         smoothedTime.setCurrentAndTargetValue(getParam("time"));
     }
 
+    void DelayNode::reset()
+    {
+        // The lines keep their storage unless the new owner sizes or
+        // stores them differently
+        if (maxTimeInSamples() != maxDelaySamples || sampleStorageFromParam(getParam("storage")) != storage ||
+            numLines != maxChannels)
+        {
+            prepare(sampleRate, maxBlockSize);
+            return;
+        }
+
+        delayLines.clear();
+        compactLines.clear();
+        writePos = 0;
+        smoothedTime.setCurrentAndTargetValue(getParam("time"));
+    }
+
+    float DelayNode::maxTimeInSamples() const
+    {
+        const float maxTimeMs = juce::jlimit(1.0f, MAX_DELAY_MS, getParam("maxTime"));
+        return static_cast<float>(std::ceil(maxTimeMs * sampleRate / 1000.0));
+    }
+
+    float DelayNode::toDelaySamples(float ms) const
+    {
+        // At least one sample, so a read never lands on the sample being written
+        return juce::jlimit(1.0f, maxDelaySamples, static_cast<float>(ms * sampleRate / 1000.0));
+    }
+
     void DelayNode::process(int numSamples)
     {
         if (!outputBuffer.isValid() || inputBuffers.empty() || !inputBuffers[0].isValid())
@@ -37,42 +83,132 @@ namespace rau
 
         auto &in = *inputBuffers[0].buffer;
         auto &out = *outputBuffer.buffer;
-        const int numChannels = juce::jmin(in.getNumChannels(), out.getNumChannels());
+        const int numChannels = juce::jmin(in.getNumChannels(), out.getNumChannels(), numLines);
 
         const float feedback = juce::jlimit(0.0f, 0.95f, getParam("feedback"));
         const float mix = juce::jlimit(0.0f, 1.0f, getParam("mix"));
         smoothedTime.setTargetValue(getParam("time"));
 
-        for (int s = 0; s < numSamples; ++s)
+        switch (storage)
+        {
+        case SampleStorage::Float16:
+            processLines<Float16Format>(compactLines.data(), in, out, numChannels, numSamples, feedback, mix);
+            break;
+        case SampleStorage::BFloat16:
+            processLines<BFloat16Format>(compactLines.data(), in, out, numChannels, numSamples, feedback, mix);
+            break;
+        default:
+            processLines<Float32Format>(delayLines.data(), in, out, numChannels, numSamples, feedback, mix);
+            break;
+        }
+    }
+
+    template <typename Format>
+    void DelayNode::processLines(typename Format::Storage *lines, const juce::AudioBuffer<float> &in,
+                                 juce::AudioBuffer<float> &out, int numChannels, int numSamples,
+                                 float feedback, float mix)
+    {
+        const float *inPtrs[MAX_LAYOUT_CHANNELS] = {};
+        float *outPtrs[MAX_LAYOUT_CHANNELS] = {};
+
+        // Scratch holds one prepared block, so longer host blocks are split
+        for (int start = 0; start < numSamples; start += maxBlockSize)
         {
-            const float delayMs = smoothedTime.getNextValue();
-            const float delaySamples = static_cast<float>(delayMs * sampleRate / 1000.0);
+            const int len = juce::jmin(maxBlockSize, numSamples - start);
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                inPtrs[ch] = in.getReadPointer(ch, start);
+                outPtrs[ch] = out.getWritePointer(ch, start);
+            }
 
-            // Read position with linear interpolation
-            float readPosF = static_cast<float>(writePos) - delaySamples;
-            if (readPosF < 0.0f)
-                readPosF += static_cast<float>(delayBufferSize);
+            if (smoothedTime.isSmoothing())
+                processGliding<Format>(lines, inPtrs, outPtrs, numChannels, len, feedback, mix);
+            else
+                processSteady<Format>(lines, inPtrs, outPtrs, numChannels, len,
+                                      toDelaySamples(smoothedTime.getCurrentValue()), feedback, mix);
+        }
+    }
 
-            const int readPos0 = static_cast<int>(readPosF) % delayBufferSize;
-            const int readPos1 = (readPos0 + 1) % delayBufferSize;
-            const float frac = readPosF - std::floor(readPosF);
+    template <typename Format>
+    void DelayNode::processSteady(typename Format::Storage *lines, const float *const *in, float *const *out,
+                                  int numChannels, int numSamples, float delaySamples, float feedback, float mix)
+    {
+        // Output sample s reads ring[w + s - whole] * (1 - frac)
+        //                 + ring[w + s - whole - 1] * frac
+        const int whole = static_cast<int>(delaySamples);
+        const float frac = delaySamples - static_cast<float>(whole);
+
+        // A chunk no longer than the delay only reads samples written
+        // before it began
+        for (int done = 0; done < numSamples;)
+        {
+            const int len = juce::jmin(numSamples - done, whole);
+            const int readPos = writePos - whole;
 
-            for (int ch = 0; ch < numChannels && ch < 2; ++ch)
+            for (int ch = 0; ch < numChannels; ++ch)
             {
-                const float dry = in.getSample(ch, s);
+                auto *buffer = lines + static_cast<size_t>(ch) * static_cast<size_t>(ringMask + 1);
+                float *delayed = wet.data();
+
+                ring::readInterpolated<Format>(buffer, ringMask, readPos, frac, delayed, len);
+
+                // Sum in float and store once, so compact lines round once
+                if (feedback != 0.0f)
+                {
+                    FVO::copy(lineInput.data(), in[ch] + done, len);
+                    FVO::addWithMultiply(lineInput.data(), delayed, feedback, len);
+                    ring::write<Format>(buffer, ringMask, writePos, lineInput.data(), len);
+                }
+                else
+                {
+                    ring::write<Format>(buffer, ringMask, writePos, in[ch] + done, len);
+                }
+
+                // `out` may alias `in`, so the dry term goes first
+                FVO::copyWithMultiply(out[ch] + done, in[ch] + done, 1.0f - mix, len);
+                FVO::addWithMultiply(out[ch] + done, delayed, mix, len);
+            }
 
-                // Interpolated read from delay buffer
-                const float delayed = delayBuffer[ch][readPos0] * (1.0f - frac) + delayBuffer[ch][readPos1] * frac;
+            writePos = (writePos + len) & ringMask;
+            done += len;
+        }
+    }
 
-                // Write input + feedback to delay buffer
-                delayBuffer[ch][writePos] = dry + delayed * feedback;
+    template <typename Format>
+    void DelayNode::processGliding(typename Format::Storage *lines, const float *const *in, float *const *out,
+                                   int numChannels, int numSamples, float feedback, float mix)
+    {
+        // Read positions are shared by all channels, so compute them once
+        for (int s = 0; s < numSamples; ++s)
+        {
+            const float delaySamples = toDelaySamples(smoothedTime.getNextValue());
+            const float readPos = static_cast<float>(s) - delaySamples;
+            const float base = std::floor(readPos);
+            readIndex[static_cast<size_t>(s)] = writePos + static_cast<int>(base);
+            readFrac[static_cast<size_t>(s)] = readPos - base;
+        }
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto *buffer = lines + static_cast<size_t>(ch) * static_cast<size_t>(ringMask + 1);
+            const float *src = in[ch];
+            float *delayed = wet.data();
 
-                // Output: dry/wet mix
-                out.setSample(ch, s, dry * (1.0f - mix) + delayed * mix);
+            for (int s = 0; s < numSamples; ++s)
+            {
+                const int i0 = readIndex[static_cast<size_t>(s)];
+                const float frac = readFrac[static_cast<size_t>(s)];
+                const float a = Format::load(buffer[i0 & ringMask]);
+                const float b = Format::load(buffer[(i0 + 1) & ringMask]);
+                delayed[s] = a + (b - a) * frac;
+                buffer[(writePos + s) & ringMask] = Format::store(src[s] + delayed[s] * feedback);
             }
 
-            writePos = (writePos + 1) % delayBufferSize;
+            FVO::copyWithMultiply(out[ch], src, 1.0f - mix, numSamples);
+            FVO::addWithMultiply(out[ch], delayed, mix, numSamples);
         }
+
+        writePos = (writePos + numSamples) & ringMask;
     }
 
 } // namespace rau
@@ -1,23 +1,79 @@
 #pragma once
 #include "NodeBase.h"
+#include "../dsp/SampleFormat.h"
 
 namespace rau
 {
 
+    /**
+     * DelayNode — feedback delay line with dry/wet mix.
+     *
+     * The ring buffer is a power of two long so positions wrap with a mask.
+     * While the delay time is steady, each block is read, fed back and
+     * written as whole runs (at most two contiguous segments around the
+     * wrap point), chunked so no read overtakes the write head. While the
+     * time is gliding, per-sample read positions are computed up front and
+     * the line runs sample by sample.
+     *
+     * The lines come from the graph's arena, sized for `maxTime`, so a
+     * short slapback doesn't hold five seconds of memory per channel.
+     *
+     * Parameters:
+     *   time     - Delay time in ms, up to maxTime (default 500)
+     *   maxTime  - Longest delay time in ms, 1–5000 (default 5000). Sizes
+     *              the lines, so it takes effect when the node is prepared
+     *              or reset.
+     *   storage  - Line storage: 0 = float32 (default), 1 = float16,
+     *              2 = bfloat16 (see SampleStorage). The 16-bit formats
+     *              halve the lines' memory; like maxTime, it takes effect
+     *              when the node is prepared or reset.
+     *   feedback - Feedback, 0–0.95 (default 0)
+     *   mix      - Dry/wet mix (default 1)
+     *   bypass   - Bypass flag
+     */
     class DelayNode : public AudioNodeBase
     {
     public:
         DelayNode();
         void prepare(double sampleRate, int maxBlockSize) override;
+        void reset() override;
+        bool hasHeavyPrepare() const override { return true; }
         void process(int numSamples) override;
 
+        int getNumOutputChannels(int inputChannels) const override { return inputChannels; }
+
     private:
         static constexpr float MAX_DELAY_MS = 5000.0f;
 
-        std::vector<std::vector<float>> delayBuffer; // [channel][sample]
+        template <typename Format>
+        void processLines(typename Format::Storage *lines, const juce::AudioBuffer<float> &in,
+                          juce::AudioBuffer<float> &out, int numChannels, int numSamples,
+                          float feedback, float mix);
+        template <typename Format>
+        void processSteady(typename Format::Storage *lines, const float *const *in, float *const *out,
+                           int numChannels, int numSamples, float delaySamples, float feedback, float mix);
+        template <typename Format>
+        void processGliding(typename Format::Storage *lines, const float *const *in, float *const *out,
+                            int numChannels, int numSamples, float feedback, float mix);
+        float toDelaySamples(float ms) const;
+        float maxTimeInSamples() const;
+
+        // One line per layout channel, back to back, in `delayLines` for
+        // float32 storage or `compactLines` for the 16-bit formats
+        ArenaArray<float> delayLines;
+        ArenaArray<uint16_t> compactLines;
+        SampleStorage storage = SampleStorage::Float32;
+        int numLines = 0;
         int writePos = 0;
-        int delayBufferSize = 0;
+        int ringMask = 0;
+        float maxDelaySamples = 1.0f;
         juce::SmoothedValue<float> smoothedTime;
+
+        // Scratch, sized to one block in prepare()
+        std::vector<float> wet;
+        std::vector<float> lineInput; // what processSteady() writes to the lines
+        std::vector<int> readIndex;
+        std::vector<float> readFrac;
     };
 
 } // namespace rau
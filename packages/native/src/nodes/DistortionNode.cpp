@@ -28,17 +28,27 @@ namespace rau
         auto &out = *outputBuffer.buffer;
         const int numChannels = juce::jmin(in.getNumChannels(), out.getNumChannels());
 
-        const int distType = static_cast<int>(getParam("distortionType"));
-        const float drive = std::max(1.0f, getParam("drive"));
-        const float outputGain = getParam("outputGain");
-        const float mix = juce::jlimit(0.0f, 1.0f, getParam("mix"));
+        beginBlock(numSamples);
+        processRange(in.getArrayOfReadPointers(), out.getArrayOfWritePointers(), numChannels, 0, numSamples);
+    }
 
+    void DistortionNode::beginBlock(int)
+    {
+        distType = static_cast<int>(getParam("distortionType"));
+        drive = std::max(1.0f, getParam("drive"));
+        outputGain = getParam("outputGain");
+        mix = juce::jlimit(0.0f, 1.0f, getParam("mix"));
+    }
+
+    void DistortionNode::processRange(const float *const *in, float *const *out,
+                                      int numChannels, int start, int numSamples)
+    {
         for (int ch = 0; ch < numChannels; ++ch)
         {
-            auto *inPtr = in.getReadPointer(ch);
-            auto *outPtr = out.getWritePointer(ch);
+            auto *inPtr = in[ch];
+            auto *outPtr = out[ch];
 
-            for (int s = 0; s < numSamples; ++s)
+            for (int s = start; s < start + numSamples; ++s)
             {
                 float dry = inPtr[s];
                 float x = dry * drive;
@@ -23,6 +23,20 @@ namespace rau
         DistortionNode();
         void prepare(double sampleRate, int maxBlockSize) override;
         void process(int numSamples) override;
+
+        int getNumOutputChannels(int inputChannels) const override { return inputChannels; }
+
+        bool isFusible() const override { return true; }
+        void beginBlock(int numSamples) override;
+        void processRange(const float *const *in, float *const *out,
+                          int numChannels, int start, int numSamples) override;
+
+    private:
+        // Parameters read once per block
+        int distType = 0;
+        float drive = 1.0f;
+        float outputGain = 1.0f;
+        float mix = 1.0f;
     };
 
 } // namespace rau
@@ -13,6 +13,7 @@ namespace rau
         addParam("sustain", 0.7f);
         addParam("release", 200.0f); // ms
         addParam("gate", 0.0f);
+        addParam("controlInterval", static_cast<float>(control::DEFAULT_INTERVAL));
         addParam("bypass", 0.0f);
     }
 
@@ -21,91 +22,141 @@ namespace rau
         AudioNodeBase::prepare(sr, maxBlock);
         stage = Stage::Idle;
         envelope = 0.0f;
+        segment = {};
         wasGateOn = false;
     }
 
+    void EnvelopeNode::advance(int numSamples, const Rates &rates)
+    {
+        // Closed forms for `numSamples` per-sample steps. A stage that
+        // ends partway hands the remaining steps to the next one; the
+        // exponential stages snap once they're close, checked at the end.
+        while (numSamples > 0)
+        {
+            switch (stage)
+            {
+            case Stage::Idle:
+                envelope = 0.0f;
+                return;
+            case Stage::Attack:
+            {
+                const int toPeak = static_cast<int>(std::ceil((1.0f - envelope) / rates.attack));
+                if (toPeak > numSamples)
+                {
+                    envelope += rates.attack * static_cast<float>(numSamples);
+                    return;
+                }
+                envelope = 1.0f;
+                stage = Stage::Decay;
+                numSamples -= std::max(1, toPeak);
+                break;
+            }
+            case Stage::Decay:
+            {
+                const float factor = numSamples == rates.interval
+                                         ? rates.decayPerInterval
+                                         : std::pow(1.0f - rates.decay, static_cast<float>(numSamples));
+                envelope = rates.sustain + (envelope - rates.sustain) * factor;
+                if (std::abs(envelope - rates.sustain) < 0.001f)
+                {
+                    envelope = rates.sustain;
+                    stage = Stage::Sustain;
+                }
+                return;
+            }
+            case Stage::Sustain:
+                envelope = rates.sustain;
+                return;
+            case Stage::Release:
+            {
+                const float factor = numSamples == rates.interval
+                                         ? rates.releasePerInterval
+                                         : std::pow(1.0f - rates.release, static_cast<float>(numSamples));
+                envelope *= factor;
+                if (envelope < 0.001f)
+                {
+                    envelope = 0.0f;
+                    stage = Stage::Idle;
+                }
+                return;
+            }
+            }
+        }
+    }
+
     void EnvelopeNode::process(int numSamples)
     {
         if (!outputBuffer.isValid())
             return;
 
         auto &out = *outputBuffer.buffer;
-        const int numChannels = out.getNumChannels();
 
         const float attackMs = std::max(0.1f, getParam("attack"));
         const float decayMs = std::max(0.1f, getParam("decay"));
-        const float sustainLevel = juce::jlimit(0.0f, 1.0f, getParam("sustain"));
         const float releaseMs = std::max(0.1f, getParam("release"));
 
         // Time constants (exponential approach)
         const float sr = static_cast<float>(sampleRate);
-        const float attackRate = 1.0f / (attackMs * 0.001f * sr);
-        const float decayRate = 1.0f / (decayMs * 0.001f * sr);
-        const float releaseRate = 1.0f / (releaseMs * 0.001f * sr);
+        Rates rates;
+        rates.attack = 1.0f / (attackMs * 0.001f * sr);
+        rates.decay = 1.0f / (decayMs * 0.001f * sr);
+        rates.release = 1.0f / (releaseMs * 0.001f * sr);
+        rates.sustain = juce::jlimit(0.0f, 1.0f, getParam("sustain"));
+        rates.interval = control::toInterval(getParam("controlInterval"));
+        rates.decayPerInterval = std::pow(1.0f - rates.decay, static_cast<float>(rates.interval));
+        rates.releasePerInterval = std::pow(1.0f - rates.release, static_cast<float>(rates.interval));
+
+        // Read gate from the input signal, or else the parameter
+        const float *gate = nullptr;
+        if (!inputBuffers.empty() && inputBuffers[0].isValid())
+            gate = inputBuffers[0].buffer->getReadPointer(0);
+        const bool gateParam = getParam("gate") > 0.5f;
 
-        for (int s = 0; s < numSamples; ++s)
+        float *dest = out.getWritePointer(0);
+        for (int start = 0; start < numSamples;)
         {
-            // Read gate from parameter or from input signal
-            float gateValue = getParam("gate");
-            if (!inputBuffers.empty() && inputBuffers[0].isValid())
-            {
-                gateValue = inputBuffers[0].buffer->getSample(0, s);
-            }
-            bool gateOn = gateValue > 0.5f;
+            const bool gateOn = gate != nullptr ? gate[start] > 0.5f : gateParam;
 
             // Gate transitions
-            if (gateOn && !wasGateOn)
+            const bool edge = gateOn != wasGateOn;
+            if (edge)
             {
-                // Note on — start attack
-                stage = Stage::Attack;
+                // Note on starts the attack, note off the release, from
+                // wherever the line being drawn has got to
+                stage = gateOn ? Stage::Attack : Stage::Release;
+                envelope = segment.current();
             }
-            else if (!gateOn && wasGateOn)
+            wasGateOn = gateOn;
+
+            // A gate edge starts a new interval, so it stays sample
+            // accurate; otherwise a line cut short by the end of the
+            // block carries on in the next one
+            if (edge || segment.remaining() == 0)
             {
-                // Note off — start release
-                stage = Stage::Release;
+                const float from = envelope;
+                advance(rates.interval, rates);
+                segment.start(from, envelope, rates.interval);
             }
-            wasGateOn = gateOn;
 
-            // Process current stage
-            switch (stage)
+            // Draw to the end of the interval, or up to the next gate edge
+            int n = juce::jmin(segment.remaining(), numSamples - start);
+            if (gate != nullptr)
             {
-            case Stage::Idle:
-                envelope = 0.0f;
-                break;
-            case Stage::Attack:
-                envelope += attackRate;
-                if (envelope >= 1.0f)
-                {
-                    envelope = 1.0f;
-                    stage = Stage::Decay;
-                }
-                break;
-            case Stage::Decay:
-                envelope -= (envelope - sustainLevel) * decayRate;
-                if (std::abs(envelope - sustainLevel) < 0.001f)
+                for (int i = 1; i < n; ++i)
                 {
-                    envelope = sustainLevel;
-                    stage = Stage::Sustain;
+                    if ((gate[start + i] > 0.5f) != gateOn)
+                    {
+                        n = i;
+                        break;
+                    }
                 }
-                break;
-            case Stage::Sustain:
-                envelope = sustainLevel;
-                break;
-            case Stage::Release:
-                envelope -= envelope * releaseRate;
-                if (envelope < 0.001f)
-                {
-                    envelope = 0.0f;
-                    stage = Stage::Idle;
-                }
-                break;
             }
 
-            for (int ch = 0; ch < numChannels; ++ch)
-            {
-                out.setSample(ch, s, envelope);
-            }
+            segment.draw(dest + start, n);
+            start += n;
         }
+
+        control::fillChannels(out, numSamples);
     }
 
 } // namespace rau
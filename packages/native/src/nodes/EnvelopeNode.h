@@ -1,5 +1,6 @@
 #pragma once
 #include "NodeBase.h"
+#include "../dsp/ControlRate.h"
 
 namespace rau
 {
@@ -16,9 +17,14 @@ namespace rau
      *   sustain - Sustain level 0–1 (default 0.7)
      *   release - Release time in ms (default 200)
      *   gate    - Gate trigger (0 or 1) — can also come from input 0
+     *   controlInterval - Samples between computed values (default 16;
+     *                     1 = every sample)
      *   bypass  - Bypass flag
      *
-     * Output: control signal 0–1.
+     * Output: control signal 0–1. The envelope advances a whole control
+     * interval at a time and is interpolated linearly in between. A gate
+     * edge starts a new interval, so note-on and note-off stay sample
+     * accurate.
      */
     class EnvelopeNode : public AudioNodeBase
     {
@@ -27,7 +33,18 @@ namespace rau
         void prepare(double sampleRate, int maxBlockSize) override;
         void process(int numSamples) override;
 
+        // Mono generator: one channel, broadcast where it's read
+        int getNumOutputChannels(int) const override { return 1; }
+
     private:
+        struct Rates
+        {
+            float attack, decay, release, sustain;
+            int interval;
+            float decayPerInterval, releasePerInterval; // (1 - rate)^interval
+        };
+        void advance(int numSamples, const Rates &rates);
+
         enum class Stage
         {
             Idle,
@@ -37,7 +54,8 @@ namespace rau
             Release
         };
         Stage stage = Stage::Idle;
-        float envelope = 0.0f;
+        float envelope = 0.0f;    // at the end of the interval being drawn
+        control::Segment segment; // the interval being drawn
         bool wasGateOn = false;
     };
 
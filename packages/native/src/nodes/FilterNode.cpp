@@ -19,6 +19,15 @@ namespace rau
             Peaking
         };
 
+        // Batched biquads run side by side, one (filter, channel) pair per
+        // lane. A fixed lane count lets the compiler keep each state term
+        // of all lanes in vector registers.
+        constexpr int BATCH_LANES = 8;
+
+        // While the cutoff is modulated, coefficients follow it every this
+        // many samples
+        constexpr int MODULATION_SUBBLOCK = 32;
+
     }
 
     FilterNode::FilterNode()
@@ -34,16 +43,13 @@ namespace rau
     void FilterNode::prepare(double sr, int maxBlock)
     {
         AudioNodeBase::prepare(sr, maxBlock);
-        for (auto &s : state)
-        {
-            s = {};
-        }
+        state.assign(static_cast<size_t>(maxChannels), {});
         prevCutoff = -1; // force coefficient recalculation
     }
 
-    void FilterNode::updateCoefficients()
+    void FilterNode::updateCoefficients(float cutoffHz)
     {
-        const float cutoff = juce::jlimit(20.0f, static_cast<float>(sampleRate * 0.499), getParam("cutoff"));
+        const float cutoff = juce::jlimit(20.0f, static_cast<float>(sampleRate * 0.499), cutoffHz);
         const float Q = juce::jmax(0.1f, getParam("resonance"));
         const float gainDb = getParam("gainDb");
         const float typeVal = getParam("filterType");
@@ -142,13 +148,9 @@ namespace rau
         a2 = _a2 / _a0;
     }
 
-    void FilterNode::process(int numSamples)
+    void FilterNode::updateCoefficientsIfChanged(float cutoff)
     {
-        if (!outputBuffer.isValid() || inputBuffers.empty() || !inputBuffers[0].isValid())
-            return;
-
         // Recalculate coefficients if params changed
-        float cutoff = getParam("cutoff");
         float resonance = getParam("resonance");
         float filterType = getParam("filterType");
         float gainDb = getParam("gainDb");
@@ -158,36 +160,129 @@ namespace rau
             std::abs(filterType - prevFilterType) > 0.5f ||
             std::abs(gainDb - prevGainDb) > 1e-6f)
         {
-            updateCoefficients();
+            updateCoefficients(cutoff);
             prevCutoff = cutoff;
             prevResonance = resonance;
             prevFilterType = filterType;
             prevGainDb = gainDb;
         }
+    }
+
+    void FilterNode::process(int numSamples)
+    {
+        // Channels run side by side as lanes of the batch kernel
+        AudioNodeBase *self = this;
+        const auto cutoff = getModulatedParam("cutoff");
+        if (cutoff.offsets == nullptr)
+        {
+            processBatch(&self, 1, numSamples);
+            return;
+        }
+
+        for (int start = 0; start < numSamples; start += MODULATION_SUBBLOCK)
+        {
+            updateCoefficientsIfChanged(cutoff.at(start));
+            runBiquads(&self, 1, start, juce::jmin(MODULATION_SUBBLOCK, numSamples - start));
+        }
+    }
+
+    void FilterNode::processBatch(AudioNodeBase *const *batch, int count, int numSamples)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            auto *filter = static_cast<FilterNode *>(batch[i]);
+            filter->updateCoefficientsIfChanged(filter->getParam("cutoff"));
+        }
+        runBiquads(batch, count, 0, numSamples);
+    }
 
-        auto &in = *inputBuffers[0].buffer;
-        auto &out = *outputBuffer.buffer;
-        const int numChannels = juce::jmin(in.getNumChannels(), out.getNumChannels());
+    void FilterNode::runBiquads(AudioNodeBase *const *batch, int count, int start, int numSamples)
+    {
+        struct Lane
+        {
+            FilterNode *filter;
+            BiquadState *state;
+            const float *in;
+            float *out;
+        };
+        std::array<Lane, BATCH_LANES> lanes;
+        int numLanes = 0;
 
-        for (size_t ch = 0; ch < static_cast<size_t>(numChannels) && ch < 2; ++ch)
+        // Same arithmetic, in the same order, as process(). Unused lanes
+        // have zero coefficients and input, so they stay silent.
+        auto runLanes = [&]()
         {
-            auto &st = state[ch];
-            const float *inData = in.getReadPointer(static_cast<int>(ch));
-            float *outData = out.getWritePointer(static_cast<int>(ch));
+            alignas(32) float c0[BATCH_LANES] = {}, c1[BATCH_LANES] = {}, c2[BATCH_LANES] = {};
+            alignas(32) float d1[BATCH_LANES] = {}, d2[BATCH_LANES] = {};
+            alignas(32) float x1[BATCH_LANES] = {}, x2[BATCH_LANES] = {};
+            alignas(32) float y1[BATCH_LANES] = {}, y2[BATCH_LANES] = {};
+            alignas(32) float x[BATCH_LANES] = {}, y[BATCH_LANES] = {};
+
+            for (int l = 0; l < numLanes; ++l)
+            {
+                auto &lane = lanes[static_cast<size_t>(l)];
+                c0[l] = lane.filter->b0;
+                c1[l] = lane.filter->b1;
+                c2[l] = lane.filter->b2;
+                d1[l] = lane.filter->a1;
+                d2[l] = lane.filter->a2;
+                x1[l] = lane.state->x1;
+                x2[l] = lane.state->x2;
+                y1[l] = lane.state->y1;
+                y2[l] = lane.state->y2;
+            }
 
             for (int s = 0; s < numSamples; ++s)
             {
-                const float x = inData[s];
-                const float y = b0 * x + b1 * st.x1 + b2 * st.x2 - a1 * st.y1 - a2 * st.y2;
+                for (int l = 0; l < numLanes; ++l)
+                    x[l] = lanes[static_cast<size_t>(l)].in[s];
+
+                for (int l = 0; l < BATCH_LANES; ++l)
+                {
+                    y[l] = c0[l] * x[l] + c1[l] * x1[l] + c2[l] * x2[l] - d1[l] * y1[l] - d2[l] * y2[l];
+                    x2[l] = x1[l];
+                    x1[l] = x[l];
+                    y2[l] = y1[l];
+                    y1[l] = y[l];
+                }
+
+                for (int l = 0; l < numLanes; ++l)
+                    lanes[static_cast<size_t>(l)].out[s] = y[l];
+            }
+
+            for (int l = 0; l < numLanes; ++l)
+            {
+                auto &st = *lanes[static_cast<size_t>(l)].state;
+                st.x1 = x1[l];
+                st.x2 = x2[l];
+                st.y1 = y1[l];
+                st.y2 = y2[l];
+            }
+            numLanes = 0;
+        };
+
+        for (int i = 0; i < count; ++i)
+        {
+            auto *filter = static_cast<FilterNode *>(batch[i]);
+            if (!filter->outputBuffer.isValid() || filter->inputBuffers.empty() || !filter->inputBuffers[0].isValid())
+                continue;
 
-                st.x2 = st.x1;
-                st.x1 = x;
-                st.y2 = st.y1;
-                st.y1 = y;
+            auto &in = *filter->inputBuffers[0].buffer;
+            auto &out = *filter->outputBuffer.buffer;
+            const int numChannels = juce::jmin(in.getNumChannels(), out.getNumChannels(),
+                                               static_cast<int>(filter->state.size()));
 
-                outData[s] = y;
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                if (numLanes == BATCH_LANES)
+                    runLanes();
+                lanes[static_cast<size_t>(numLanes++)] = {filter, &filter->state[static_cast<size_t>(ch)],
+                                                          in.getReadPointer(ch, start), out.getWritePointer(ch, start)};
             }
         }
+
+        if (numLanes > 0)
+            runLanes();
     }
 
 } // namespace rau
@@ -11,8 +11,18 @@ namespace rau
         void prepare(double sampleRate, int maxBlockSize) override;
         void process(int numSamples) override;
 
+        int getNumOutputChannels(int inputChannels) const override { return inputChannels; }
+
+        bool isBatchable() const override { return true; }
+        void processBatch(AudioNodeBase *const *batch, int count, int numSamples) override;
+
     private:
-        void updateCoefficients();
+        void updateCoefficients(float cutoff);
+        void updateCoefficientsIfChanged(float cutoff);
+
+        // The biquads of every (filter, channel) pair, over samples
+        // [start, start + numSamples), with the current coefficients
+        static void runBiquads(AudioNodeBase *const *batch, int count, int start, int numSamples);
 
         // Per-channel biquad state
         struct BiquadState
@@ -21,7 +31,7 @@ namespace rau
             float y1 = 0, y2 = 0; // output history
         };
 
-        std::array<BiquadState, 2> state; // stereo
+        std::vector<BiquadState> state; // one per layout channel
 
         // Biquad coefficients
         float b0 = 1, b1 = 0, b2 = 0;
@@ -26,35 +26,54 @@ namespace rau
         auto &out = *outputBuffer.buffer;
         const int numChannels = juce::jmin(in.getNumChannels(), out.getNumChannels());
 
-        smoothedGain.setTargetValue(getParam("gain"));
-
-        // Check for amplitude modulation input (e.g. envelope on inlet 1).
-        // When present, multiply audio (input 0) by modulation (input 1)
-        // sample-by-sample, then scale by the gain parameter.
-        if (inputBuffers.size() >= 2 && inputBuffers[1].isValid())
+        // Check for amplitude modulation input (e.g. envelope on inlet 1)
+        // or a connection driving the gain parameter. Either way, run
+        // sample by sample: audio (input 0) times the modulation input
+        // times the gain parameter.
+        const auto gain = getModulatedParam("gain");
+        const bool hasModInput = inputBuffers.size() >= 2 && inputBuffers[1].isValid();
+        if (hasModInput || gain.offsets != nullptr)
         {
-            auto &mod = *inputBuffers[1].buffer;
+            smoothedGain.setTargetValue(gain.base);
+            const float *mod = hasModInput ? inputBuffers[1].buffer->getReadPointer(0) : nullptr;
 
             for (int s = 0; s < numSamples; ++s)
             {
-                const float g = smoothedGain.getNextValue();
+                float g = smoothedGain.getNextValue();
+                if (gain.offsets != nullptr)
+                    g += gain.offsets[s];
                 // Read modulation value from first channel of mod input
-                const float modVal = mod.getSample(0, s);
+                if (mod != nullptr)
+                    g *= mod[s];
 
                 for (int ch = 0; ch < numChannels; ++ch)
                 {
-                    out.setSample(ch, s, in.getSample(ch, s) * modVal * g);
+                    out.setSample(ch, s, in.getSample(ch, s) * g);
                 }
             }
+            return;
         }
-        else if (smoothedGain.isSmoothing())
+
+        beginBlock(numSamples);
+        processRange(in.getArrayOfReadPointers(), out.getArrayOfWritePointers(), numChannels, 0, numSamples);
+    }
+
+    void GainNode::beginBlock(int)
+    {
+        smoothedGain.setTargetValue(getParam("gain"));
+    }
+
+    void GainNode::processRange(const float *const *in, float *const *out,
+                                int numChannels, int start, int numSamples)
+    {
+        if (smoothedGain.isSmoothing())
         {
-            for (int s = 0; s < numSamples; ++s)
+            for (int s = start; s < start + numSamples; ++s)
             {
                 const float g = smoothedGain.getNextValue();
                 for (int ch = 0; ch < numChannels; ++ch)
                 {
-                    out.setSample(ch, s, in.getSample(ch, s) * g);
+                    out[ch][s] = in[ch][s] * g;
                 }
             }
         }
@@ -63,8 +82,7 @@ namespace rau
             const float g = smoothedGain.getCurrentValue();
             for (int ch = 0; ch < numChannels; ++ch)
             {
-                out.copyFrom(ch, 0, in, ch, 0, numSamples);
-                out.applyGain(ch, 0, numSamples, g);
+                juce::FloatVectorOperations::copyWithMultiply(out[ch] + start, in[ch] + start, g, numSamples);
             }
         }
     }
@@ -11,6 +11,14 @@ namespace rau
         void prepare(double sampleRate, int maxBlockSize) override;
         void process(int numSamples) override;
 
+        int getNumOutputChannels(int inputChannels) const override { return inputChannels; }
+        bool acceptsMonoInput(int inlet) const override { return inlet == 1; }
+
+        bool isFusible() const override { return true; }
+        void beginBlock(int numSamples) override;
+        void processRange(const float *const *in, float *const *out,
+                          int numChannels, int start, int numSamples) override;
+
     private:
         juce::SmoothedValue<float> smoothedGain;
     };
@@ -11,15 +11,59 @@ namespace rau
         addParam("rate", 1.0f);  // Hz
         addParam("depth", 1.0f);
         addParam("phase", 0.0f); // degrees
+        addParam("controlInterval", static_cast<float>(control::DEFAULT_INTERVAL));
         addParam("bypass", 0.0f);
     }
 
     void LFONode::prepare(double sr, int maxBlock)
     {
         AudioNodeBase::prepare(sr, maxBlock);
-        lfoPhase = 0.0;
+        intervalPhase = 0.0;
         randomValue = 0.5f;
         prevPhaseWrap = 0.0f;
+        segment = {};
+        primed = false;
+    }
+
+    float LFONode::valueAt(double phase, int shape, float phaseOffset)
+    {
+        float p = static_cast<float>(std::fmod(phase + static_cast<double>(phaseOffset), 1.0));
+        if (p < 0.0f)
+            p += 1.0f;
+
+        float value = 0.0f;
+        switch (shape)
+        {
+        case 0: // Sine
+            value = 0.5f + 0.5f * std::sin(p * juce::MathConstants<float>::twoPi);
+            break;
+        case 1: // Triangle
+            value = (p < 0.5f) ? (p * 2.0f) : (2.0f - p * 2.0f);
+            break;
+        case 2: // Saw
+            value = p;
+            break;
+        case 3: // Square
+            value = (p < 0.5f) ? 1.0f : 0.0f;
+            break;
+        case 4: // Random (sample & hold)
+        {
+            // New random value at each cycle — uses deterministic PRNG
+            // instead of rand() for thread safety on the audio thread.
+            if (p < prevPhaseWrap)
+            {
+                randomValue = nextRandom();
+            }
+            value = randomValue;
+            break;
+        }
+        default:
+            value = 0.5f + 0.5f * std::sin(p * juce::MathConstants<float>::twoPi);
+            break;
+        }
+
+        prevPhaseWrap = p;
+        return value;
     }
 
     void LFONode::process(int numSamples)
@@ -28,63 +72,41 @@ namespace rau
             return;
 
         auto &out = *outputBuffer.buffer;
-        const int numChannels = out.getNumChannels();
         const int shape = static_cast<int>(getParam("shape"));
         const float rate = std::max(0.001f, getParam("rate"));
         const float depth = juce::jlimit(0.0f, 1.0f, getParam("depth"));
         const float phaseOffset = getParam("phase") / 360.0f;
+        const int interval = control::toInterval(getParam("controlInterval"));
+        const double increment = static_cast<double>(rate) / sampleRate;
 
-        for (int s = 0; s < numSamples; ++s)
+        // Each line ends on a computed value: the one for the last sample
+        // of its interval. A line cut short by the end of the block
+        // carries on in the next one.
+        float *dest = out.getWritePointer(0);
+        for (int start = 0; start < numSamples;)
         {
-            float p = static_cast<float>(std::fmod(lfoPhase + static_cast<double>(phaseOffset), 1.0));
-            if (p < 0.0f)
-                p += 1.0f;
-
-            float value = 0.0f;
-            switch (shape)
-            {
-            case 0: // Sine
-                value = 0.5f + 0.5f * std::sin(p * juce::MathConstants<float>::twoPi);
-                break;
-            case 1: // Triangle
-                value = (p < 0.5f) ? (p * 2.0f) : (2.0f - p * 2.0f);
-                break;
-            case 2: // Saw
-                value = p;
-                break;
-            case 3: // Square
-                value = (p < 0.5f) ? 1.0f : 0.0f;
-                break;
-            case 4: // Random (sample & hold)
+            if (segment.remaining() == 0)
             {
-                // New random value at each cycle — uses deterministic PRNG
-                // instead of rand() for thread safety on the audio thread.
-                if (p < prevPhaseWrap)
-                {
-                    randomValue = nextRandom();
-                }
-                value = randomValue;
-                break;
-            }
-            default:
-                value = 0.5f + 0.5f * std::sin(p * juce::MathConstants<float>::twoPi);
-                break;
-            }
+                double lastPhase = intervalPhase + increment * static_cast<double>(interval - 1);
+                lastPhase -= std::floor(lastPhase);
+                intervalPhase += increment * static_cast<double>(interval);
+                intervalPhase -= std::floor(intervalPhase);
 
-            prevPhaseWrap = p;
-
-            // Apply depth: interpolate between 0.5 (no modulation) and value
-            float output = 0.5f + (value - 0.5f) * depth;
-
-            for (int ch = 0; ch < numChannels; ++ch)
-            {
-                out.setSample(ch, s, output);
+                // Apply depth: interpolate between 0.5 (no modulation) and value.
+                // Square and sample & hold jump, so they hold each value
+                // rather than ramping into the edge.
+                const float value = 0.5f + (valueAt(lastPhase, shape, phaseOffset) - 0.5f) * depth;
+                const bool stepped = shape == 3 || shape == 4;
+                segment.start(primed && !stepped ? segment.to : value, value, interval);
+                primed = true;
             }
 
-            lfoPhase += static_cast<double>(rate) / sampleRate;
-            if (lfoPhase >= 1.0)
-                lfoPhase -= 1.0;
+            const int n = juce::jmin(segment.remaining(), numSamples - start);
+            segment.draw(dest + start, n);
+            start += n;
         }
+
+        control::fillChannels(out, numSamples);
     }
 
 } // namespace rau
@@ -1,5 +1,6 @@
 #pragma once
 #include "NodeBase.h"
+#include "../dsp/ControlRate.h"
 
 namespace rau
 {
@@ -15,9 +16,13 @@ namespace rau
      *   rate   - Rate in Hz (default 1.0)
      *   depth  - Modulation depth (0–1, default 1.0)
      *   phase  - Phase offset in degrees (default 0)
+     *   controlInterval - Samples between computed values (default 16;
+     *                     1 = every sample)
      *   bypass - Bypass flag
      *
-     * Output is a control signal (0–1 range, centered at 0.5).
+     * Output is a control signal (0–1 range, centered at 0.5). The shape
+     * is evaluated once per control interval and interpolated linearly in
+     * between, so square and random steps ramp over one interval.
      */
     class LFONode : public AudioNodeBase
     {
@@ -26,10 +31,17 @@ namespace rau
         void prepare(double sampleRate, int maxBlockSize) override;
         void process(int numSamples) override;
 
+        // Mono generator: one channel, broadcast where it's read
+        int getNumOutputChannels(int) const override { return 1; }
+
     private:
-        double lfoPhase = 0.0;
+        float valueAt(double phase, int shape, float phaseOffset);
+
+        double intervalPhase = 0.0; // phase at the start of the next interval
         float randomValue = 0.0f;
         float prevPhaseWrap = 0.0f;
+        control::Segment segment; // the interval being drawn
+        bool primed = false;      // segment holds a computed value
 
         // Deterministic PRNG state (xorshift32) — avoids calling rand()
         // which is not thread-safe and may lock on the audio thread.
@@ -25,6 +25,9 @@ namespace rau
         void prepare(double sampleRate, int maxBlockSize) override;
         void process(int numSamples) override;
 
+        // Channel 0 is the gate, channel 1 the frequency
+        int getNumOutputChannels(int) const override { return juce::jmin(2, maxChannels); }
+
         /** Set by AudioGraph::processBlock before processing. */
         const juce::MidiBuffer *midiBuffer = nullptr;
 
@@ -0,0 +1,205 @@
+#include "ModDelayNode.h"
+#include <cmath>
+
+namespace rau
+{
+
+    ModDelayNode::ModDelayNode()
+    {
+        nodeType = "modDelay";
+        addParam("time", 15.0f);   // ms
+        addParam("depth", 5.0f);   // ms
+        addParam("rate", 1.5f);    // Hz
+        addParam("voices", 2.0f);  // 1–4
+        addParam("spread", 0.5f);  // 0–1
+        addParam("feedback", 0.0f);
+        addParam("mix", 0.5f);
+        addParam("bypass", 0.0f);
+    }
+
+    void ModDelayNode::prepare(double sr, int maxBlock)
+    {
+        AudioNodeBase::prepare(sr, maxBlock);
+
+        // Room for the longest delay plus one block and the interpolator
+        const int needed = static_cast<int>(std::ceil(MAX_DELAY_MS * sr / 1000.0)) + maxBlock + 4;
+        const int size = juce::nextPowerOfTwo(needed);
+        allocateState(rings, static_cast<size_t>(maxChannels) * static_cast<size_t>(size));
+        numRings = rings.empty() ? 0 : maxChannels;
+        ringMask = size - 1;
+        writePos = 0;
+
+        delayTimes.assign(static_cast<size_t>(LFO_SIDES * MAX_VOICES * maxBlock), 0.0f);
+        wet.assign(static_cast<size_t>(maxBlock), 0.0f);
+
+        prevRate = -1.0f;
+        prevVoices = -1;
+
+        smoothedTime.reset(sr, 0.05);
+        smoothedTime.setCurrentAndTargetValue(getParam("time"));
+        smoothedDepth.reset(sr, 0.05);
+        smoothedDepth.setCurrentAndTargetValue(getParam("depth"));
+    }
+
+    void ModDelayNode::reset()
+    {
+        // The rings are sized for MAX_DELAY_MS whatever the parameters, so
+        // they keep their storage unless the layout changed
+        if (numRings != maxChannels)
+        {
+            prepare(sampleRate, maxBlockSize);
+            return;
+        }
+
+        rings.clear();
+        writePos = 0;
+        prevRate = -1.0f;
+        prevVoices = -1;
+        smoothedTime.setCurrentAndTargetValue(getParam("time"));
+        smoothedDepth.setCurrentAndTargetValue(getParam("depth"));
+    }
+
+    void ModDelayNode::resetVoicePhases(int numVoices)
+    {
+        // Spread the voices evenly around the cycle, starting from voice 0
+        const float start = std::atan2(lfoSin[0], lfoCos[0]);
+        for (int v = 0; v < MAX_VOICES; ++v)
+        {
+            const float phase = start + juce::MathConstants<float>::twoPi * static_cast<float>(v) / static_cast<float>(numVoices);
+            lfoSin[static_cast<size_t>(v)] = std::sin(phase);
+            lfoCos[static_cast<size_t>(v)] = std::cos(phase);
+        }
+    }
+
+    void ModDelayNode::process(int numSamples)
+    {
+        if (!outputBuffer.isValid() || inputBuffers.empty() || !inputBuffers[0].isValid())
+            return;
+
+        auto &in = *inputBuffers[0].buffer;
+        auto &out = *outputBuffer.buffer;
+        const int numChannels = juce::jmin(in.getNumChannels(), out.getNumChannels(), numRings);
+        const int numSides = juce::jmin(numChannels, LFO_SIDES);
+
+        const int numVoices = juce::jlimit(1, MAX_VOICES, static_cast<int>(getParam("voices")));
+        const float rate = juce::jlimit(0.01f, 20.0f, getParam("rate"));
+        const float spread = juce::jlimit(0.0f, 1.0f, getParam("spread")) * juce::MathConstants<float>::halfPi;
+        const float feedback = juce::jlimit(-0.95f, 0.95f, getParam("feedback"));
+        const float mix = juce::jlimit(0.0f, 1.0f, getParam("mix"));
+        smoothedTime.setTargetValue(getParam("time"));
+        smoothedDepth.setTargetValue(juce::jmax(0.0f, getParam("depth")));
+
+        if (numVoices != prevVoices)
+        {
+            resetVoicePhases(numVoices);
+            prevVoices = numVoices;
+        }
+        if (rate != prevRate)
+        {
+            const float w = juce::MathConstants<float>::twoPi * rate / static_cast<float>(sampleRate);
+            rotationCos = std::cos(w);
+            rotationSin = std::sin(w);
+            prevRate = rate;
+        }
+
+        // --- Delay times for the whole block --------------------------------
+        const float msToSamples = static_cast<float>(sampleRate / 1000.0);
+        const float minDelay = 3.0f; // Hermite reads two samples ahead
+        const float maxDelay = MAX_DELAY_MS * msToSamples;
+        const float spreadCos = std::cos(spread);
+        const float spreadSin = std::sin(spread);
+        float shortest = maxDelay;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float centre = smoothedTime.getNextValue() * msToSamples;
+            const float halfDepth = 0.5f * smoothedDepth.getNextValue() * msToSamples;
+
+            for (int v = 0; v < numVoices; ++v)
+            {
+                auto &s = lfoSin[static_cast<size_t>(v)];
+                auto &c = lfoCos[static_cast<size_t>(v)];
+
+                for (int side = 0; side < numSides; ++side)
+                {
+                    // Right LFO = left rotated by the spread angle
+                    const float lfo = side == 0 ? s : s * spreadCos + c * spreadSin;
+                    const float d = juce::jlimit(minDelay, maxDelay, centre + halfDepth * lfo);
+                    delayTimes[static_cast<size_t>((side * MAX_VOICES + v) * maxBlockSize + i)] = d;
+                    shortest = juce::jmin(shortest, d);
+                }
+
+                const float nextSin = s * rotationCos + c * rotationSin;
+                c = c * rotationCos - s * rotationSin;
+                s = nextSin;
+            }
+        }
+
+        // Keep the rotating oscillators on the unit circle
+        for (int v = 0; v < MAX_VOICES; ++v)
+        {
+            auto &s = lfoSin[static_cast<size_t>(v)];
+            auto &c = lfoCos[static_cast<size_t>(v)];
+            const float norm = 1.0f / std::sqrt(s * s + c * c);
+            s *= norm;
+            c *= norm;
+        }
+
+        // --- Taps -----------------------------------------------------------
+        // Work in chunks shorter than the shortest delay, so every tap in a
+        // chunk reads samples written before it. The tap loops then have no
+        // dependency on the feedback writes.
+        const int chunkSize = juce::jmax(1, static_cast<int>(shortest) - 2);
+        const float voiceGain = 1.0f / static_cast<float>(numVoices);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            float *buf = rings.data() + static_cast<size_t>(ch) * static_cast<size_t>(ringMask + 1);
+            const int side = ch % LFO_SIDES;
+            const float *src = in.getReadPointer(ch);
+            float *dst = out.getWritePointer(ch);
+            int pos = writePos;
+
+            for (int start = 0; start < numSamples; start += chunkSize)
+            {
+                const int len = juce::jmin(chunkSize, numSamples - start);
+                std::fill(wet.begin(), wet.begin() + len, 0.0f);
+
+                for (int v = 0; v < numVoices; ++v)
+                {
+                    const float *times = delayTimes.data() + (side * MAX_VOICES + v) * maxBlockSize + start;
+                    for (int i = 0; i < len; ++i)
+                    {
+                        const float readPos = static_cast<float>(i) - times[i];
+                        const float base = std::floor(readPos);
+                        const float f = readPos - base;
+                        const int n = pos + static_cast<int>(base);
+
+                        const float xm1 = buf[(n - 1) & ringMask];
+                        const float x0 = buf[n & ringMask];
+                        const float x1 = buf[(n + 1) & ringMask];
+                        const float x2 = buf[(n + 2) & ringMask];
+
+                        // 4-point, 3rd-order Hermite
+                        const float c1 = 0.5f * (x1 - xm1);
+                        const float c2 = xm1 - 2.5f * x0 + 2.0f * x1 - 0.5f * x2;
+                        const float c3 = 0.5f * (x2 - xm1) + 1.5f * (x0 - x1);
+                        wet[static_cast<size_t>(i)] += ((c3 * f + c2) * f + c1) * f + x0;
+                    }
+                }
+
+                for (int i = 0; i < len; ++i)
+                {
+                    const float dry = src[start + i];
+                    const float w = wet[static_cast<size_t>(i)] * voiceGain;
+                    buf[(pos + i) & ringMask] = dry + w * feedback;
+                    dst[start + i] = dry * (1.0f - mix) + w * mix;
+                }
+                pos += len;
+            }
+        }
+
+        writePos = (writePos + numSamples) & ringMask;
+    }
+
+} // namespace rau
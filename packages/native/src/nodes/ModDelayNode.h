@@ -0,0 +1,69 @@
+#pragma once
+#include "NodeBase.h"
+#include <array>
+
+namespace rau
+{
+
+    /**
+     * ModDelayNode — multi-voice modulated delay (chorus / flanger).
+     *
+     * Each voice is a tap into one short ring buffer per channel, swept
+     * by its own sine LFO around the base delay time. Voices are spread
+     * evenly in phase, and the right channel's LFOs are offset from the
+     * left by `spread` (0 = in phase, 1 = 90°). On wider layouts, even
+     * channels follow the left LFOs and odd ones the right. Taps are read
+     * with 4-point Hermite interpolation; the summed taps feed back into
+     * the ring.
+     *
+     * Parameters:
+     *   time     - Base delay in ms (default 15)
+     *   depth    - Sweep depth in ms, peak to peak (default 5)
+     *   rate     - LFO rate in Hz (default 1.5)
+     *   voices   - Number of taps, 1–4 (default 2)
+     *   spread   - Stereo LFO phase offset, 0–1 (default 0.5)
+     *   feedback - Feedback, -0.95–0.95 (default 0)
+     *   mix      - Dry/wet mix (default 0.5)
+     *   bypass   - Bypass flag
+     */
+    class ModDelayNode : public AudioNodeBase
+    {
+    public:
+        ModDelayNode();
+        void prepare(double sampleRate, int maxBlockSize) override;
+        void reset() override;
+        bool hasHeavyPrepare() const override { return true; }
+        void process(int numSamples) override;
+
+        int getNumOutputChannels(int inputChannels) const override { return inputChannels; }
+
+    private:
+        static constexpr float MAX_DELAY_MS = 50.0f;
+        static constexpr int MAX_VOICES = 4;
+        static constexpr int LFO_SIDES = 2; // left and right LFO sets
+
+        void resetVoicePhases(int numVoices);
+
+        // Power-of-two rings so wrapping is a mask
+        ArenaArray<float> rings; // one ring per layout channel, back to back
+        int numRings = 0;
+        int ringMask = 0;
+        int writePos = 0;
+
+        // Quadrature LFO per voice, advanced by a rotation each sample
+        std::array<float, MAX_VOICES> lfoSin{};
+        std::array<float, MAX_VOICES> lfoCos{};
+        float rotationCos = 1.0f;
+        float rotationSin = 0.0f;
+        float prevRate = -1.0f;
+        int prevVoices = -1;
+
+        // Per-block delay times in samples: [side][voice][sample]
+        std::vector<float> delayTimes;
+        std::vector<float> wet;
+
+        juce::SmoothedValue<float> smoothedTime;
+        juce::SmoothedValue<float> smoothedDepth;
+    };
+
+} // namespace rau
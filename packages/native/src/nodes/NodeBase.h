@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../ParamMailbox.h"
+#include "../dsp/NodeArena.h"
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_dsp/juce_dsp.h>
 #include <atomic>
@@ -10,6 +12,9 @@
 namespace rau
 {
 
+    // Widest channel layout the graph runs (7.1.4)
+    static constexpr int MAX_LAYOUT_CHANNELS = 12;
+
     /**
      * BufferRef — lightweight reference to a buffer in the pool.
      * Used to pass audio between nodes without copying.
@@ -78,6 +83,30 @@ namespace rau
             maxBlockSize = blockSize;
         }
 
+        /**
+         * Whether prepare() does enough work (long delay lines, reverb
+         * tanks) to be worth running off the message thread. The graph
+         * can then prepare the node in the background and run a
+         * pass-through in its place until it's ready.
+         */
+        virtual bool hasHeavyPrepare() const { return false; }
+
+        /**
+         * Clear all processing state (delay lines, filter memories) and
+         * settle smoothers on the current parameters, as prepare() would
+         * for the same config. Used when a pooled node is reused. The
+         * default prepares again; override it where prepare() allocates.
+         */
+        virtual void reset() { prepare(sampleRate, maxBlockSize); }
+
+        /**
+         * The graph runs this node in sub-blocks of at most `numSamples`
+         * (0 for whole prepared blocks; see AudioGraph::setSubBlockSize()).
+         * Message thread, before or after prepare(). Nodes whose per-call
+         * cost depends on the block size re-plan for it.
+         */
+        virtual void setSubBlockSize(int /*numSamples*/) {}
+
         /**
          * Process one block of audio. Read from inputBuffers, write to outputBuffer.
          * Called on the audio thread — must be real-time safe.
@@ -85,17 +114,26 @@ namespace rau
         virtual void process(int numSamples) = 0;
 
         /**
-         * Bypass processing — copy first input to output.
+         * Bypass processing — copy first input to outlet 0 and silence any
+         * other outlets.
          */
         virtual void processBypass(int numSamples)
         {
+            for (auto &extra : extraOutputBuffers)
+            {
+                if (extra.isValid())
+                    extra.buffer->clear(0, numSamples);
+            }
+
             if (!inputBuffers.empty() && inputBuffers[0].isValid() && outputBuffer.isValid())
             {
+                const int inChannels = inputBuffers[0].buffer->getNumChannels();
                 for (int ch = 0; ch < outputBuffer.buffer->getNumChannels(); ++ch)
                 {
-                    if (ch < inputBuffers[0].buffer->getNumChannels())
+                    if (ch < inChannels || inChannels == 1)
                     {
-                        outputBuffer.buffer->copyFrom(ch, 0, *inputBuffers[0].buffer, ch, 0, numSamples);
+                        // A mono input is broadcast
+                        outputBuffer.buffer->copyFrom(ch, 0, *inputBuffers[0].buffer, juce::jmin(ch, inChannels - 1), 0, numSamples);
                     }
                     else
                     {
@@ -105,6 +143,82 @@ namespace rau
             }
         }
 
+        // --- Channels ------------------------------------------------------------
+
+        /** Widest buffer the graph will hand this node. Set before prepare(). */
+        void setMaxChannels(int numChannels) { maxChannels = numChannels; }
+
+        /**
+         * Channels this node writes, given how many arrive on inlet 0. The
+         * default is the full layout. Nodes that treat each channel on its
+         * own return `inputChannels`, so a mono signal stays one channel
+         * through them; mono generators return 1.
+         */
+        virtual int getNumOutputChannels(int /*inputChannels*/) const { return maxChannels; }
+
+        /**
+         * Whether an inlet handles fewer channels than the node writes.
+         * Otherwise the graph broadcasts a mono input to the node's width
+         * before it runs.
+         */
+        virtual bool acceptsMonoInput(int /*inlet*/) const { return false; }
+
+        // --- Memory --------------------------------------------------------------
+
+        /**
+         * Where the node keeps its DSP state (see allocateState()). Set by
+         * the graph before prepare(); without one, state comes from the heap.
+         */
+        void setArena(NodeArena *nodeArena) { arena = nodeArena; }
+
+        // --- Fusion --------------------------------------------------------------
+
+        /**
+         * Nodes whose output is a per-sample function of inlet 0 (with
+         * block-rate parameters and smoothers as their only state) can be
+         * fused: the graph runs a chain of them tile by tile, so each tile
+         * stays in cache from the first node to the last instead of every
+         * node streaming the whole block through memory.
+         *
+         * A fusible node's process() must amount to beginBlock() followed by
+         * processRange() over the whole block (when input and output have
+         * the same channel count), so fused and unfused output are
+         * bit-identical.
+         */
+        virtual bool isFusible() const { return false; }
+
+        /** Read parameters for the coming block. */
+        virtual void beginBlock(int /*numSamples*/) {}
+
+        /**
+         * Process samples [start, start + numSamples) of every channel.
+         * `in` and `out` may point at the same channels (in place).
+         */
+        virtual void processRange(const float *const * /*in*/, float *const * /*out*/,
+                                  int /*numChannels*/, int /*start*/, int /*numSamples*/) {}
+
+        // --- Batching ------------------------------------------------------------
+
+        /**
+         * Independent nodes of one type can run together, one node channel
+         * per SIMD lane, when their state is small and uniform (a biquad,
+         * say). The graph groups nodes of a batchable type whose inputs are
+         * all ready at the first one's place in the order, wires each as
+         * usual, then calls processBatch() on one of them with the group.
+         */
+        virtual bool isBatchable() const { return false; }
+
+        /**
+         * Process `count` nodes of this node's type (this one included).
+         * Inputs and outputs are already wired as for process() and none
+         * is bypassed. Must match calling process() on each node.
+         */
+        virtual void processBatch(AudioNodeBase *const *batch, int count, int numSamples)
+        {
+            for (int i = 0; i < count; ++i)
+                batch[i]->process(numSamples);
+        }
+
         // --- Parameters ----------------------------------------------------------
 
         void setParam(const std::string &name, float value)
@@ -112,46 +226,169 @@ namespace rau
             auto it = params.find(name);
             if (it != params.end())
             {
-                it->second.store(value, std::memory_order_relaxed);
+                it->second.value.store(value, std::memory_order_relaxed);
             }
         }
 
+        /**
+         * A modulated parameter reads as its value at the start of the
+         * block; see getModulatedParam() to follow it sample by sample.
+         */
         float getParam(const std::string &name) const
         {
             auto it = params.find(name);
             if (it != params.end())
             {
-                return it->second.load(std::memory_order_relaxed);
+                const float value = it->second.value.load(std::memory_order_relaxed);
+                return it->second.modulation != nullptr ? value + it->second.modulation[0] : value;
             }
             return 0.0f;
         }
 
+        /**
+         * The stored value of a parameter, for writers that can't afford a
+         * lookup per update (host bindings). Null if there's no such
+         * parameter.
+         */
+        AtomicFloat *getParamStorage(const std::string &name)
+        {
+            auto it = params.find(name);
+            return it != params.end() ? &it->second.value : nullptr;
+        }
+
+        /**
+         * A parameter's mailbox slot, for updates that should land at the
+         * start of the next block (see ParamMailbox). Null if there's no
+         * such parameter.
+         */
+        ParamMailbox::Slot *getMailboxSlot(const std::string &name)
+        {
+            auto it = params.find(name);
+            return it != params.end() ? &it->second.mailbox : nullptr;
+        }
+
+        /** Put every parameter back to its default (message thread). */
+        void resetParams()
+        {
+            for (auto &[name, param] : params)
+            {
+                param.value.store(param.defaultValue);
+                param.modulation = nullptr;
+            }
+        }
+
+        /**
+         * Every parameter's value, by name (message thread), including
+         * updates still waiting in the mailbox, so it's current while no
+         * blocks run to deliver them.
+         */
+        std::unordered_map<std::string, float> getParamValues() const
+        {
+            std::unordered_map<std::string, float> values;
+            for (auto &[name, param] : params)
+                values.emplace(name, ParamMailbox::latest(param.mailbox));
+            return values;
+        }
+
         bool isBypassed() const
         {
             auto it = params.find("bypass");
             if (it != params.end())
             {
-                return it->second.load(std::memory_order_relaxed) > 0.5f;
+                return it->second.value.load(std::memory_order_relaxed) > 0.5f;
             }
             return false;
         }
 
+        // --- Modulation ----------------------------------------------------------
+
+        /**
+         * A parameter and its modulation this block: the value at sample s
+         * is `base + offsets[s]`. `offsets` is null when no connection
+         * drives the parameter. Audio thread only.
+         */
+        struct ModulatedParam
+        {
+            float base = 0.0f;
+            const float *offsets = nullptr;
+
+            float at(int s) const { return offsets != nullptr ? base + offsets[s] : base; }
+        };
+
+        ModulatedParam getModulatedParam(const std::string &name) const
+        {
+            auto it = params.find(name);
+            if (it != params.end())
+                return {it->second.value.load(std::memory_order_relaxed), it->second.modulation};
+            return {};
+        }
+
+        /**
+         * Where the graph points a parameter's modulation buffer while the
+         * node runs. Null if the node has no such parameter.
+         */
+        const float **getModulationSlot(const std::string &name)
+        {
+            auto it = params.find(name);
+            return it != params.end() ? &it->second.modulation : nullptr;
+        }
+
         // --- Connections ---------------------------------------------------------
 
         std::vector<BufferRef> inputBuffers;
-        BufferRef outputBuffer;
+        BufferRef outputBuffer;                    // outlet 0
+        std::vector<BufferRef> extraOutputBuffers; // outlets 1..N-1
+
+        int getNumOutlets() const { return 1 + static_cast<int>(extraOutputBuffers.size()); }
+
+        BufferRef getOutputBuffer(int outlet) const
+        {
+            if (outlet == 0)
+                return outputBuffer;
+            if (outlet > 0 && outlet < getNumOutlets())
+                return extraOutputBuffers[static_cast<size_t>(outlet - 1)];
+            return {};
+        }
 
     protected:
         double sampleRate = 44100.0;
         int maxBlockSize = 512;
+        int maxChannels = 2;
+        NodeArena *arena = nullptr;
+
+        // Size a piece of DSP state (a delay line, say) from prepare(),
+        // charged to this node in the graph's memory report.
+        template <typename T>
+        void allocateState(ArenaArray<T> &state, size_t count)
+        {
+            state.allocate(arena, this, count);
+        }
+
+        // Call from the constructor of nodes with more than one output. The
+        // graph gives every outlet its own pool buffer each block.
+        void setNumOutlets(int numOutlets)
+        {
+            extraOutputBuffers.resize(static_cast<size_t>(juce::jmax(1, numOutlets) - 1));
+        }
 
         void addParam(const std::string &name, float defaultValue = 0.0f)
         {
-            params.emplace(name, defaultValue);
+            // Built in place: the mailbox slot points at its own value
+            auto &param = params.try_emplace(name).first->second;
+            param.value.store(defaultValue);
+            param.defaultValue = defaultValue;
+            param.mailbox.target = &param.value.value;
         }
 
     private:
-        std::unordered_map<std::string, AtomicFloat> params;
+        struct Param
+        {
+            AtomicFloat value;
+            float defaultValue = 0.0f;
+            const float *modulation = nullptr; // set by the graph while the node runs
+            ParamMailbox::Slot mailbox;        // pending updates for `value`
+        };
+        std::unordered_map<std::string, Param> params;
     };
 
 } // namespace rau
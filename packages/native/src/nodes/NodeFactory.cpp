@@ -1,8 +1,11 @@
 #include "NodeFactory.h"
 #include "GainNode.h"
 #include "DelayNode.h"
+#include "ModDelayNode.h"
+#include "PhaserNode.h"
 #include "FilterNode.h"
 #include "MixNode.h"
+#include "SumNode.h"
 #include "OscillatorNode.h"
 #include "CompressorNode.h"
 #include "ReverbNode.h"
@@ -14,6 +17,7 @@
 #include "SpectrumNode.h"
 #include "ConvolverNode.h"
 #include "SplitNode.h"
+#include "CrossoverNode.h"
 #include "MergeNode.h"
 #include "MidiInputNode.h"
 
@@ -27,10 +31,16 @@ namespace rau
             return std::make_unique<GainNode>();
         if (type == "delay")
             return std::make_unique<DelayNode>();
+        if (type == "modDelay")
+            return std::make_unique<ModDelayNode>();
+        if (type == "phaser")
+            return std::make_unique<PhaserNode>();
         if (type == "filter")
             return std::make_unique<FilterNode>();
         if (type == "mix")
             return std::make_unique<MixNode>();
+        if (type == "sum")
+            return std::make_unique<SumNode>();
         if (type == "compressor")
             return std::make_unique<CompressorNode>();
         if (type == "reverb")
@@ -47,6 +57,8 @@ namespace rau
             return std::make_unique<SplitNode>();
         if (type == "merge")
             return std::make_unique<MergeNode>();
+        if (type == "crossover")
+            return std::make_unique<CrossoverNode>();
 
         // Generators / Modulators
         if (type == "oscillator")
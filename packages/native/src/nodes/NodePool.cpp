@@ -0,0 +1,69 @@
+#include "NodePool.h"
+#include "NodeFactory.h"
+
+namespace rau
+{
+
+    std::unique_ptr<AudioNodeBase> NodePool::take(const std::string &type)
+    {
+        auto it = pools.find(type);
+        if (it == pools.end() || it->second.spares.empty())
+            return nullptr;
+
+        auto node = std::move(it->second.spares.back());
+        it->second.spares.pop_back();
+        return node;
+    }
+
+    void NodePool::recycle(std::unique_ptr<AudioNodeBase> node)
+    {
+        // Placeholders and other untyped nodes aren't reusable
+        if (!node || node->nodeType.empty())
+            return;
+
+        auto &pool = pools[node->nodeType];
+        if (pool.spares.size() >= pool.capacity())
+            return;
+
+        node->nodeId.clear();
+        node->resetParams();
+        pool.spares.push_back(std::move(node));
+    }
+
+    std::vector<AudioNodeBase *> NodePool::prewarm(const std::string &type, int count)
+    {
+        std::vector<AudioNodeBase *> created;
+        auto &pool = pools[type];
+        pool.prewarmCount = std::max(0, count);
+
+        while (pool.spares.size() < static_cast<size_t>(pool.prewarmCount))
+        {
+            auto node = NodeFactory::create(type);
+            if (!node)
+                break; // unknown type
+            node->nodeType = type;
+            created.push_back(node.get());
+            pool.spares.push_back(std::move(node));
+        }
+
+        if (pool.spares.size() > pool.capacity())
+            pool.spares.resize(pool.capacity());
+        return created;
+    }
+
+    std::vector<AudioNodeBase *> NodePool::getSpares() const
+    {
+        std::vector<AudioNodeBase *> spares;
+        for (auto &[type, pool] : pools)
+            for (auto &node : pool.spares)
+                spares.push_back(node.get());
+        return spares;
+    }
+
+    int NodePool::getNumSpares(const std::string &type) const
+    {
+        auto it = pools.find(type);
+        return it != pools.end() ? static_cast<int>(it->second.spares.size()) : 0;
+    }
+
+} // namespace rau
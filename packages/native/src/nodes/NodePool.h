@@ -0,0 +1,63 @@
+#pragma once
+#include "NodeBase.h"
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rau
+{
+
+    /**
+     * NodePool — spare nodes kept per type, already constructed and
+     * prepared, so patches that toggle sections or voices on and off
+     * don't allocate a node (or its delay lines) on every add.
+     *
+     * AudioGraph takes from it on AddNode, falling back to NodeFactory,
+     * and gives removed nodes back once the audio thread is done with
+     * them. A type keeps at most its prewarm count of spares, or
+     * DEFAULT_CAPACITY if that is larger; further nodes are freed.
+     *
+     * Spares are prepared for the graph's current config; the graph
+     * re-prepares them when it changes. Message thread only.
+     */
+    class NodePool
+    {
+    public:
+        static constexpr int DEFAULT_CAPACITY = 4;
+
+        /** A spare of `type` with default parameters, or null if there's none. */
+        std::unique_ptr<AudioNodeBase> take(const std::string &type);
+
+        /**
+         * Keep a removed node as a spare if its type has room, otherwise
+         * free it. Its parameters go back to their defaults; its state is
+         * cleared by reset() when it's taken again.
+         */
+        void recycle(std::unique_ptr<AudioNodeBase> node);
+
+        /**
+         * Keep `count` spares of `type` on hand from now on. Creates the
+         * missing ones and returns them, unprepared, for the caller to
+         * prepare; spares beyond the new capacity are freed.
+         */
+        std::vector<AudioNodeBase *> prewarm(const std::string &type, int count);
+
+        /** Every spare, for re-preparing after a config change. */
+        std::vector<AudioNodeBase *> getSpares() const;
+
+        int getNumSpares(const std::string &type) const;
+
+    private:
+        struct TypePool
+        {
+            std::vector<std::unique_ptr<AudioNodeBase>> spares;
+            int prewarmCount = 0;
+
+            size_t capacity() const { return static_cast<size_t>(std::max(prewarmCount, DEFAULT_CAPACITY)); }
+        };
+        std::unordered_map<std::string, TypePool> pools;
+    };
+
+} // namespace rau
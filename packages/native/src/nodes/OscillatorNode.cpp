@@ -33,14 +33,17 @@ namespace rau
         const float detuneCents = getParam("detune");
         const float gain = getParam("gain");
 
-        // Apply detune: frequency * 2^(cents/1200)
-        float baseFreq = getParam("frequency");
+        // Apply detune: frequency * 2^(cents/1200). A connection driving
+        // the frequency adds Hz per sample, detuned with the rest.
+        const auto baseFreq = getModulatedParam("frequency");
         float detuneMultiplier = std::pow(2.0f, detuneCents / 1200.0f);
-        smoothedFreq.setTargetValue(baseFreq * detuneMultiplier);
+        smoothedFreq.setTargetValue(baseFreq.base * detuneMultiplier);
 
         for (int s = 0; s < numSamples; ++s)
         {
             float freq = smoothedFreq.getNextValue();
+            if (baseFreq.offsets != nullptr)
+                freq += baseFreq.offsets[s] * detuneMultiplier;
             float sample = 0.0f;
 
             switch (waveform)
@@ -72,8 +75,8 @@ namespace rau
 
             // Advance phase
             phase += static_cast<double>(freq) / sampleRate;
-            if (phase >= 1.0)
-                phase -= 1.0;
+            if (phase >= 1.0 || phase < 0.0)
+                phase -= std::floor(phase); // through-zero FM runs backwards
         }
     }
 
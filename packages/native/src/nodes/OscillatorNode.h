@@ -24,6 +24,9 @@ namespace rau
         void prepare(double sampleRate, int maxBlockSize) override;
         void process(int numSamples) override;
 
+        // Mono generator: one channel, broadcast where it's read
+        int getNumOutputChannels(int) const override { return 1; }
+
     private:
         double phase = 0.0;
         juce::SmoothedValue<float> smoothedFreq;
@@ -27,8 +27,7 @@ namespace rau
         auto &in = *inputBuffers[0].buffer;
         auto &out = *outputBuffer.buffer;
 
-        const int law = static_cast<int>(getParam("law"));
-        smoothedPan.setTargetValue(juce::jlimit(-1.0f, 1.0f, getParam("pan")));
+        beginBlock(numSamples);
 
         // Handle mono->stereo or stereo->stereo
         const int inCh = in.getNumChannels();
@@ -41,41 +40,81 @@ namespace rau
             return;
         }
 
-        for (int s = 0; s < numSamples; ++s)
+        if (inCh == 1)
         {
-            const float pan = smoothedPan.getNextValue();
-
-            // Convert pan (-1..1) to left/right gains
-            float gainL, gainR;
-            if (law == 0)
+            // Mono to stereo
+            for (int s = 0; s < numSamples; ++s)
             {
-                // Linear pan
-                gainL = 0.5f * (1.0f - pan);
-                gainR = 0.5f * (1.0f + pan);
-            }
-            else
-            {
-                // Equal power pan (constant power)
-                float angle = (pan + 1.0f) * 0.25f * juce::MathConstants<float>::pi;
-                gainL = std::cos(angle);
-                gainR = std::sin(angle);
-            }
+                float gainL, gainR;
+                computeGains(nextPan(s), gainL, gainR);
 
-            if (inCh == 1)
-            {
-                // Mono to stereo
                 float mono = in.getSample(0, s);
                 out.setSample(0, s, mono * gainL);
                 out.setSample(1, s, mono * gainR);
             }
-            else
-            {
-                // Stereo to stereo
-                float left = in.getSample(0, s);
-                float right = in.getSample(1, s);
-                out.setSample(0, s, left * gainL);
-                out.setSample(1, s, right * gainR);
-            }
+            return;
+        }
+
+        // Stereo (or wider) to the same width
+        processRange(in.getArrayOfReadPointers(), out.getArrayOfWritePointers(), juce::jmin(inCh, outCh), 0, numSamples);
+    }
+
+    void PanNode::beginBlock(int)
+    {
+        law = static_cast<int>(getParam("law"));
+        const auto pan = getModulatedParam("pan");
+        smoothedPan.setTargetValue(juce::jlimit(-1.0f, 1.0f, pan.base));
+        panOffsets = pan.offsets;
+    }
+
+    void PanNode::processRange(const float *const *in, float *const *out,
+                               int numChannels, int start, int numSamples)
+    {
+        if (numChannels < 2)
+        {
+            if (numChannels == 1 && out[0] != in[0])
+                juce::FloatVectorOperations::copy(out[0] + start, in[0] + start, numSamples);
+            return;
+        }
+
+        for (int s = start; s < start + numSamples; ++s)
+        {
+            float gainL, gainR;
+            computeGains(nextPan(s), gainL, gainR);
+
+            out[0][s] = in[0][s] * gainL;
+            out[1][s] = in[1][s] * gainR;
+        }
+
+        // Channels past the stereo pair (centre, LFE, surrounds) pass through
+        for (int ch = 2; ch < numChannels; ++ch)
+        {
+            if (out[ch] != in[ch])
+                juce::FloatVectorOperations::copy(out[ch] + start, in[ch] + start, numSamples);
+        }
+    }
+
+    float PanNode::nextPan(int s)
+    {
+        const float pan = smoothedPan.getNextValue();
+        return panOffsets != nullptr ? juce::jlimit(-1.0f, 1.0f, pan + panOffsets[s]) : pan;
+    }
+
+    void PanNode::computeGains(float pan, float &gainL, float &gainR) const
+    {
+        // Convert pan (-1..1) to left/right gains
+        if (law == 0)
+        {
+            // Linear pan
+            gainL = 0.5f * (1.0f - pan);
+            gainR = 0.5f * (1.0f + pan);
+        }
+        else
+        {
+            // Equal power pan (constant power)
+            float angle = (pan + 1.0f) * 0.25f * juce::MathConstants<float>::pi;
+            gainL = std::cos(angle);
+            gainR = std::sin(angle);
         }
     }
 
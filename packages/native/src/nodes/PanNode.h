@@ -5,7 +5,8 @@ namespace rau
 {
 
     /**
-     * PanNode — stereo panner.
+     * PanNode — stereo panner. On wider layouts it pans the front pair and
+     * passes the other channels through.
      *
      * Pan law (float enum):
      *   0 = linear, 1 = equal power
@@ -22,8 +23,20 @@ namespace rau
         void prepare(double sampleRate, int maxBlockSize) override;
         void process(int numSamples) override;
 
+        bool acceptsMonoInput(int inlet) const override { return inlet == 0; }
+
+        bool isFusible() const override { return true; }
+        void beginBlock(int numSamples) override;
+        void processRange(const float *const *in, float *const *out,
+                          int numChannels, int start, int numSamples) override;
+
     private:
+        float nextPan(int s);
+        void computeGains(float pan, float &gainL, float &gainR) const;
+
         juce::SmoothedValue<float> smoothedPan;
+        const float *panOffsets = nullptr; // this block's modulation, if any
+        int law = 1;
     };
 
 } // namespace rau
@@ -0,0 +1,149 @@
+#include "PhaserNode.h"
+#include <cmath>
+
+namespace rau
+{
+
+    PhaserNode::PhaserNode()
+    {
+        nodeType = "phaser";
+        addParam("frequency", 1000.0f); // Hz
+        addParam("depth", 0.7f);
+        addParam("rate", 0.5f); // Hz
+        addParam("stages", 4.0f);
+        addParam("feedback", 0.5f);
+        addParam("spread", 0.0f);
+        addParam("mix", 0.5f);
+        addParam("bypass", 0.0f);
+    }
+
+    void PhaserNode::prepare(double sr, int maxBlock)
+    {
+        AudioNodeBase::prepare(sr, maxBlock);
+        for (auto &pair : state)
+        {
+            for (auto &stage : pair)
+                stage.fill(0.0f);
+        }
+        for (auto &pair : lastWet)
+            pair.fill(0.0f);
+        coeffValid = false;
+        lfoPhase = 0.0;
+    }
+
+    float PhaserNode::coefficientAt(double phase, float minFreq, float maxFreq) const
+    {
+        const float lfo = 0.5f + 0.5f * static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * phase));
+        const float freq = minFreq * std::pow(maxFreq / minFreq, lfo);
+        const float t = std::tan(juce::MathConstants<float>::pi * freq / static_cast<float>(sampleRate));
+        return (t - 1.0f) / (t + 1.0f);
+    }
+
+    void PhaserNode::process(int numSamples)
+    {
+        if (!outputBuffer.isValid() || inputBuffers.empty() || !inputBuffers[0].isValid())
+            return;
+
+        auto &in = *inputBuffers[0].buffer;
+        auto &out = *outputBuffer.buffer;
+        const int inChannels = in.getNumChannels();
+        const int outChannels = out.getNumChannels();
+        if (inChannels == 0 || outChannels == 0)
+            return;
+
+        // A mono input feeds both lanes, so spread still widens it;
+        // outputs past a wider input's channels stay silent
+        const int numChannels = juce::jmin(outChannels, inChannels == 1 ? LANES : inChannels);
+        for (int ch = numChannels; ch < outChannels; ++ch)
+            out.clear(ch, 0, numSamples);
+
+        const float centre = getParam("frequency");
+        const float depth = juce::jlimit(0.0f, 1.0f, getParam("depth"));
+        const float rate = juce::jlimit(0.0f, 20.0f, getParam("rate"));
+        const int numStages = juce::jlimit(1, MAX_STAGES / 2, static_cast<int>(getParam("stages")) / 2) * 2;
+        const float feedback = juce::jlimit(-0.95f, 0.95f, getParam("feedback"));
+        const double spread = 0.25 * juce::jlimit(0.0, 1.0, static_cast<double>(getParam("spread")));
+        const float mix = juce::jlimit(0.0f, 1.0f, getParam("mix"));
+
+        const float maxAllowed = static_cast<float>(sampleRate * 0.45);
+        const float minFreq = juce::jlimit(20.0f, maxAllowed, centre * (1.0f - depth * 0.9f));
+        const float maxFreq = juce::jlimit(minFreq, maxAllowed, centre * (1.0f + depth * 0.9f));
+
+        if (!coeffValid)
+        {
+            for (int lane = 0; lane < LANES; ++lane)
+                coeff[static_cast<size_t>(lane)] = coefficientAt(lfoPhase + lane * spread, minFreq, maxFreq);
+            coeffValid = true;
+        }
+
+        const int numPairs = juce::jmin(MAX_PAIRS, (numChannels + 1) / 2);
+
+        for (int start = 0; start < numSamples; start += CONTROL_INTERVAL)
+        {
+            const int len = juce::jmin(CONTROL_INTERVAL, numSamples - start);
+
+            lfoPhase += static_cast<double>(rate) * len / sampleRate;
+            lfoPhase -= std::floor(lfoPhase);
+
+            // Ramp each lane's coefficient to its exact value at the end of
+            // this segment
+            float step[LANES];
+            for (int lane = 0; lane < LANES; ++lane)
+            {
+                const float target = coefficientAt(lfoPhase + lane * spread, minFreq, maxFreq);
+                step[lane] = (target - coeff[static_cast<size_t>(lane)]) / static_cast<float>(len);
+            }
+
+            // Every pair follows the same ramp
+            float a[LANES];
+            for (int pair = 0; pair < numPairs; ++pair)
+            {
+                const int left = pair * LANES;
+                const int right = juce::jmin(left + 1, numChannels - 1); // an odd last channel fills both lanes
+                const float *src[LANES] = {in.getReadPointer(juce::jmin(left, inChannels - 1)),
+                                           in.getReadPointer(juce::jmin(right, inChannels - 1))};
+                float *dst[LANES] = {out.getWritePointer(left), right > left ? out.getWritePointer(right) : nullptr};
+                auto &pairState = state[static_cast<size_t>(pair)];
+                auto &pairWet = lastWet[static_cast<size_t>(pair)];
+
+                for (int lane = 0; lane < LANES; ++lane)
+                    a[lane] = coeff[static_cast<size_t>(lane)];
+
+                for (int i = start; i < start + len; ++i)
+                {
+                    float x[LANES];
+                    for (int lane = 0; lane < LANES; ++lane)
+                    {
+                        a[lane] += step[lane];
+                        x[lane] = src[lane][i] + feedback * pairWet[static_cast<size_t>(lane)];
+                    }
+
+                    // y = a·x + z, z = x − a·y  (transposed direct form)
+                    for (int s = 0; s < numStages; ++s)
+                    {
+                        auto &z = pairState[static_cast<size_t>(s)];
+                        for (int lane = 0; lane < LANES; ++lane)
+                        {
+                            const float y = a[lane] * x[lane] + z[static_cast<size_t>(lane)];
+                            z[static_cast<size_t>(lane)] = x[lane] - a[lane] * y;
+                            x[lane] = y;
+                        }
+                    }
+
+                    for (int lane = 0; lane < LANES; ++lane)
+                        pairWet[static_cast<size_t>(lane)] = x[lane];
+
+                    for (int lane = 0; lane < LANES; ++lane)
+                    {
+                        if (dst[lane] != nullptr)
+                            dst[lane][i] = src[lane][i] * (1.0f - mix) + x[lane] * mix;
+                    }
+                }
+            }
+
+            for (int lane = 0; lane < LANES; ++lane)
+                coeff[static_cast<size_t>(lane)] = a[lane];
+        }
+    }
+
+} // namespace rau
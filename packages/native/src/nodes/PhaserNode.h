@@ -0,0 +1,52 @@
+#pragma once
+#include "NodeBase.h"
+#include <array>
+
+namespace rau
+{
+
+    /**
+     * PhaserNode — swept first-order allpass cascade with feedback.
+     *
+     * All stages share one allpass coefficient per channel, swept
+     * exponentially between the sweep limits by a sine LFO. The exact
+     * coefficient is computed every CONTROL_INTERVAL samples and
+     * interpolated linearly in between. Left and right run side by side
+     * as two lanes of the same stage loop; the right LFO is offset by
+     * `spread` (0 = in phase, 1 = 90°). Wider layouts run as further
+     * pairs of lanes with their own filter state, on the same LFOs.
+     *
+     * Parameters:
+     *   frequency - Centre frequency in Hz (default 1000)
+     *   depth     - Sweep depth, 0–1 (default 0.7)
+     *   rate      - LFO rate in Hz (default 0.5)
+     *   stages    - Allpass stages, 2–12 and even (default 4)
+     *   feedback  - Feedback, -0.95–0.95 (default 0.5)
+     *   spread    - Stereo LFO phase offset, 0–1 (default 0)
+     *   mix       - Dry/wet mix (default 0.5)
+     *   bypass    - Bypass flag
+     */
+    class PhaserNode : public AudioNodeBase
+    {
+    public:
+        PhaserNode();
+        void prepare(double sampleRate, int maxBlockSize) override;
+        void process(int numSamples) override;
+
+    private:
+        static constexpr int MAX_STAGES = 12;
+        static constexpr int LANES = 2; // stereo
+        static constexpr int MAX_PAIRS = (MAX_LAYOUT_CHANNELS + 1) / 2;
+        static constexpr int CONTROL_INTERVAL = 32;
+
+        float coefficientAt(double phase, float minFreq, float maxFreq) const;
+
+        using PairState = std::array<std::array<float, LANES>, MAX_STAGES>; // [stage][lane]
+        std::array<PairState, MAX_PAIRS> state{};
+        std::array<std::array<float, LANES>, MAX_PAIRS> lastWet{};
+        std::array<float, LANES> coeff{};
+        bool coeffValid = false;
+        double lfoPhase = 0.0;
+    };
+
+} // namespace rau
@@ -1,4 +1,5 @@
 #include "ReverbNode.h"
+#include "../dsp/RingBuffer.h"
 #include <cmath>
 
 namespace rau
@@ -7,6 +8,7 @@ namespace rau
     ReverbNode::ReverbNode()
     {
         nodeType = "reverb";
+        addParam("engine", 0.0f); // 0 = freeverb, 1 = fdn
         addParam("roomSize", 0.5f);
         addParam("damping", 0.5f);
         addParam("preDelay", 0.0f); // ms (0–250)
@@ -17,20 +19,95 @@ namespace rau
     void ReverbNode::prepare(double sr, int maxBlock)
     {
         AudioNodeBase::prepare(sr, maxBlock);
-        reverb.setSampleRate(sr);
-        reverb.reset();
 
-        // Allocate pre-delay buffer for max pre-delay time
-        preDelayBufferSize = static_cast<int>(std::ceil(MAX_PRE_DELAY_MS * sr / 1000.0)) + 1;
-        preDelayBuffer.resize(2); // stereo
-        for (auto &ch : preDelayBuffer)
+        numPairs = (maxChannels + 1) / 2;
+        reverbs = std::make_unique<juce::Reverb[]>(static_cast<size_t>(numPairs));
+        fdns = std::make_unique<FDNReverb[]>(static_cast<size_t>(numPairs));
+        const auto tankSize = static_cast<size_t>(FDNReverb::tankSize(sr));
+        allocateState(fdnTanks, static_cast<size_t>(numPairs) * tankSize);
+        for (int p = 0; p < numPairs; ++p)
         {
-            ch.assign(preDelayBufferSize, 0.0f);
+            reverbs[static_cast<size_t>(p)].setSampleRate(sr);
+            fdns[static_cast<size_t>(p)].prepare(sr, fdnTanks.data() + static_cast<size_t>(p) * tankSize);
         }
+
+        wet.resize(static_cast<size_t>(maxChannels));
+        for (auto &ch : wet)
+        {
+            ch.assign(static_cast<size_t>(maxBlock), 0.0f);
+        }
+        prevEngine = -1;
+
+        // Room for the longest pre-delay, one block of writes and the
+        // interpolator's second tap
+        const int needed = static_cast<int>(std::ceil(MAX_PRE_DELAY_MS * sr / 1000.0)) + maxBlock + 2;
+        const int size = juce::nextPowerOfTwo(needed);
+        allocateState(preDelayLines, static_cast<size_t>(maxChannels) * static_cast<size_t>(size));
+        preDelayMask = size - 1;
         preDelayWritePos = 0;
+        readIndex.assign(static_cast<size_t>(maxBlock), 0);
+        readFrac.assign(static_cast<size_t>(maxBlock), 0.0f);
 
         smoothedPreDelay.reset(sr, 0.05); // 50ms smoothing
         smoothedPreDelay.setCurrentAndTargetValue(getParam("preDelay"));
+        smoothedMix.reset(sr, MIX_SMOOTHING_SECONDS);
+        smoothedMix.setCurrentAndTargetValue(juce::jlimit(0.0f, 1.0f, getParam("mix")));
+    }
+
+    void ReverbNode::reset()
+    {
+        // Same config, so the engines and lines keep their storage
+        for (int p = 0; p < numPairs; ++p)
+        {
+            reverbs[static_cast<size_t>(p)].reset();
+            fdns[static_cast<size_t>(p)].reset();
+        }
+        preDelayLines.clear();
+        preDelayWritePos = 0;
+        prevEngine = -1;
+        smoothedPreDelay.setCurrentAndTargetValue(getParam("preDelay"));
+        smoothedMix.setCurrentAndTargetValue(juce::jlimit(0.0f, 1.0f, getParam("mix")));
+    }
+
+    void ReverbNode::updateParameters(int engine)
+    {
+        const float roomSize = juce::jlimit(0.0f, 1.0f, getParam("roomSize"));
+        const float damping = juce::jlimit(0.0f, 1.0f, getParam("damping"));
+        const float mix = juce::jlimit(0.0f, 1.0f, getParam("mix"));
+
+        if (engine == prevEngine && roomSize == prevRoomSize && damping == prevDamping && mix == prevMix)
+            return;
+
+        if (engine != prevEngine)
+        {
+            // Don't let the previous engine's tail resume if switched back
+            for (int p = 0; p < numPairs; ++p)
+            {
+                reverbs[static_cast<size_t>(p)].reset();
+                fdns[static_cast<size_t>(p)].reset();
+            }
+        }
+
+        prevEngine = engine;
+        prevRoomSize = roomSize;
+        prevDamping = damping;
+        prevMix = mix;
+
+        if (engine == 1)
+        {
+            for (int p = 0; p < numPairs; ++p)
+                fdns[static_cast<size_t>(p)].setParameters(roomSize, damping);
+            return;
+        }
+
+        reverbParams.roomSize = roomSize;
+        reverbParams.damping = damping;
+        reverbParams.wetLevel = mix;
+        reverbParams.dryLevel = 0.0f; // process() mixes the undelayed dry
+        reverbParams.width = 1.0f;
+        reverbParams.freezeMode = 0.0f;
+        for (int p = 0; p < numPairs; ++p)
+            reverbs[static_cast<size_t>(p)].setParameters(reverbParams);
     }
 
     void ReverbNode::process(int numSamples)
@@ -40,72 +117,129 @@ namespace rau
 
         auto &in = *inputBuffers[0].buffer;
         auto &out = *outputBuffer.buffer;
-        const int numChannels = juce::jmin(in.getNumChannels(), out.getNumChannels());
+        const int numChannels = juce::jmin(in.getNumChannels(), out.getNumChannels(), static_cast<int>(wet.size()));
+        if (numChannels == 0)
+            return;
 
-        // Update reverb parameters from atomics
-        reverbParams.roomSize = juce::jlimit(0.0f, 1.0f, getParam("roomSize"));
-        reverbParams.damping = juce::jlimit(0.0f, 1.0f, getParam("damping"));
-        reverbParams.wetLevel = juce::jlimit(0.0f, 1.0f, getParam("mix"));
-        reverbParams.dryLevel = 1.0f - reverbParams.wetLevel;
-        reverbParams.width = 1.0f;
-        reverbParams.freezeMode = 0.0f;
-        reverb.setParameters(reverbParams);
+        const int engine = getParam("engine") >= 0.5f ? 1 : 0;
+        updateParameters(engine);
+        smoothedMix.setTargetValue(prevMix);
+        smoothedPreDelay.setTargetValue(juce::jlimit(0.0f, MAX_PRE_DELAY_MS, getParam("preDelay")));
 
-        const float preDelayMs = juce::jlimit(0.0f, MAX_PRE_DELAY_MS, getParam("preDelay"));
-        smoothedPreDelay.setTargetValue(preDelayMs);
+        const float *inPtrs[MAX_LAYOUT_CHANNELS] = {};
+        float *outPtrs[MAX_LAYOUT_CHANNELS] = {};
+        float *wetPtrs[MAX_LAYOUT_CHANNELS] = {};
 
-        if (preDelayMs < 0.01f && !smoothedPreDelay.isSmoothing())
+        // Scratch holds one prepared block, so longer host blocks are split
+        for (int start = 0; start < numSamples; start += maxBlockSize)
         {
-            // No pre-delay: process directly (fast path)
+            const int len = juce::jmin(maxBlockSize, numSamples - start);
             for (int ch = 0; ch < numChannels; ++ch)
             {
-                out.copyFrom(ch, 0, in, ch, 0, numSamples);
+                inPtrs[ch] = in.getReadPointer(ch, start);
+                outPtrs[ch] = out.getWritePointer(ch, start);
+                wetPtrs[ch] = wet[static_cast<size_t>(ch)].data();
             }
-        }
-        else
-        {
-            // Apply pre-delay via circular buffer
-            for (int s = 0; s < numSamples; ++s)
-            {
-                const float currentPreDelayMs = smoothedPreDelay.getNextValue();
-                const float delaySamples = static_cast<float>(currentPreDelayMs * sampleRate / 1000.0);
-
-                // Read position with linear interpolation
-                float readPosF = static_cast<float>(preDelayWritePos) - delaySamples;
-                if (readPosF < 0.0f)
-                    readPosF += static_cast<float>(preDelayBufferSize);
 
-                const int readPos0 = static_cast<int>(readPosF) % preDelayBufferSize;
-                const int readPos1 = (readPos0 + 1) % preDelayBufferSize;
-                const float frac = readPosF - std::floor(readPosF);
+            // Both engines reverberate the pre-delayed signal in scratch and
+            // the dry input is mixed in undelayed, so pre-delay only opens a
+            // gap before the reverb whichever engine runs
+            processPreDelay(inPtrs, wetPtrs, numChannels, len);
+            for (int ch = 0; ch < numChannels; ch += 2)
+            {
+                float *right = ch + 1 < numChannels ? wetPtrs[ch + 1] : nullptr;
+                if (engine == 1)
+                    fdns[static_cast<size_t>(ch / 2)].process(wetPtrs[ch], right, len);
+                else if (right != nullptr)
+                    reverbs[static_cast<size_t>(ch / 2)].processStereo(wetPtrs[ch], right, len);
+                else
+                    reverbs[static_cast<size_t>(ch / 2)].processMono(wetPtrs[ch], len);
+            }
 
-                for (int ch = 0; ch < numChannels && ch < 2; ++ch)
+            // juce::Reverb applies its own (smoothed) wet level; the FDN is
+            // wet-only
+            const float dryScale = engine == 1 ? 1.0f : FREEVERB_DRY_SCALE;
+            if (smoothedMix.isSmoothing())
+            {
+                for (int s = 0; s < len; ++s)
                 {
-                    const float sample = in.getSample(ch, s);
-
-                    // Write to pre-delay buffer
-                    preDelayBuffer[ch][preDelayWritePos] = sample;
-
-                    // Interpolated read
-                    const float delayed = preDelayBuffer[ch][readPos0] * (1.0f - frac) +
-                                          preDelayBuffer[ch][readPos1] * frac;
-
-                    out.setSample(ch, s, delayed);
+                    const float mix = smoothedMix.getNextValue();
+                    const float wetGain = engine == 1 ? mix : 1.0f;
+                    const float dryGain = (1.0f - mix) * dryScale;
+                    for (int ch = 0; ch < numChannels; ++ch)
+                        outPtrs[ch][s] = inPtrs[ch][s] * dryGain + wetPtrs[ch][s] * wetGain;
+                }
+            }
+            else
+            {
+                const float mix = smoothedMix.getCurrentValue();
+                const float wetGain = engine == 1 ? mix : 1.0f;
+                const float dryGain = (1.0f - mix) * dryScale;
+                for (int ch = 0; ch < numChannels; ++ch)
+                {
+                    juce::FloatVectorOperations::copyWithMultiply(outPtrs[ch], inPtrs[ch], dryGain, len);
+                    juce::FloatVectorOperations::addWithMultiply(outPtrs[ch], wetPtrs[ch], wetGain, len);
                 }
-
-                preDelayWritePos = (preDelayWritePos + 1) % preDelayBufferSize;
             }
         }
+    }
 
-        // Process reverb in-place on the (pre-delayed) output buffer
-        if (numChannels >= 2)
+    void ReverbNode::processPreDelay(const float *const *in, float *const *out, int numChannels, int numSamples)
+    {
+        // The block is written first, so even a pre-delay shorter than the
+        // block reads valid samples
+        for (int ch = 0; ch < numChannels; ++ch)
         {
-            reverb.processStereo(out.getWritePointer(0), out.getWritePointer(1), numSamples);
+            ring::write(preDelayLine(ch), preDelayMask, preDelayWritePos, in[ch], numSamples);
         }
-        else if (numChannels == 1)
+
+        if (!smoothedPreDelay.isSmoothing())
         {
-            reverb.processMono(out.getWritePointer(0), numSamples);
+            const float preDelayMs = smoothedPreDelay.getCurrentValue();
+            const float delaySamples = static_cast<float>(preDelayMs * sampleRate / 1000.0);
+            const int whole = static_cast<int>(delaySamples);
+            const float frac = delaySamples - static_cast<float>(whole);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                if (preDelayMs < 0.01f)
+                {
+                    // No pre-delay: process directly (fast path)
+                    if (out[ch] != in[ch])
+                        juce::FloatVectorOperations::copy(out[ch], in[ch], numSamples);
+                    continue;
+                }
+                ring::readInterpolated(preDelayLine(ch), preDelayMask,
+                                       preDelayWritePos - whole, frac, out[ch], numSamples);
+            }
         }
+        else
+        {
+            // Read positions are shared by all channels, so compute them once
+            for (int s = 0; s < numSamples; ++s)
+            {
+                const float delaySamples = static_cast<float>(smoothedPreDelay.getNextValue() * sampleRate / 1000.0);
+                const float readPos = static_cast<float>(s) - delaySamples;
+                const float base = std::floor(readPos);
+                readIndex[static_cast<size_t>(s)] = preDelayWritePos + static_cast<int>(base);
+                readFrac[static_cast<size_t>(s)] = readPos - base;
+            }
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                const float *buffer = preDelayLine(ch);
+                float *dest = out[ch];
+                for (int s = 0; s < numSamples; ++s)
+                {
+                    const int i0 = readIndex[static_cast<size_t>(s)];
+                    const float a = buffer[i0 & preDelayMask];
+                    const float b = buffer[(i0 + 1) & preDelayMask];
+                    dest[s] = a + (b - a) * readFrac[static_cast<size_t>(s)];
+                }
+            }
+        }
+
+        preDelayWritePos = (preDelayWritePos + numSamples) & preDelayMask;
     }
 
 } // namespace rau
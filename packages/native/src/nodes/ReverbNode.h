@@ -1,15 +1,31 @@
 #pragma once
 #include "NodeBase.h"
-#include <array>
+#include "../dsp/FDNReverb.h"
+#include <memory>
 #include <vector>
 
 namespace rau
 {
 
     /**
-     * ReverbNode — algorithmic reverb based on Schroeder/Moorer design.
+     * ReverbNode — algorithmic reverb with a selectable engine.
+     *
+     * Engines:
+     *   0 (freeverb) - Schroeder/Moorer design (juce::Reverb: 8 combs and
+     *                  4 allpasses per channel)
+     *   1 (fdn)      - 8-line feedback delay network (see FDNReverb)
+     *
+     * Layouts wider than stereo run one engine per channel pair.
+     *
+     * Pre-delay delays only the reverberated signal; the dry input is
+     * mixed in undelayed with either engine.
+     *
+     * Pre-delay runs on a power-of-two ring written and read a block at a
+     * time; only while the pre-delay time glides are positions computed
+     * per sample.
      *
      * Parameters:
+     *   engine    - Reverb engine (0 = freeverb, 1 = fdn; default 0)
      *   roomSize  - Room size (0–1, default 0.5)
      *   damping   - High-frequency damping (0–1, default 0.5)
      *   preDelay  - Pre-delay in ms (0–250, default 0)
@@ -21,18 +37,48 @@ namespace rau
     public:
         ReverbNode();
         void prepare(double sampleRate, int maxBlockSize) override;
+        bool hasHeavyPrepare() const override { return true; }
+        void reset() override;
         void process(int numSamples) override;
 
     private:
-        juce::Reverb reverb;
+        void processPreDelay(const float *const *in, float *const *out, int numChannels, int numSamples);
+        void updateParameters(int engine);
+
+        // One engine of each kind per channel pair
+        int numPairs = 0;
+        std::unique_ptr<juce::Reverb[]> reverbs;
         juce::Reverb::Parameters reverbParams;
+        std::unique_ptr<FDNReverb[]> fdns;
+        ArenaArray<float> fdnTanks; // each FDN's delay lines, back to back
+
+        std::vector<std::vector<float>> wet; // engine scratch, one block per channel
+
+        // juce::Reverb scales its dry level by 2; the freeverb engine's dry
+        // is mixed outside it at the same level
+        static constexpr float FREEVERB_DRY_SCALE = 2.0f;
+
+        // Ramps the gains process() applies (the dry of both engines, and
+        // the FDN's wet) over juce::Reverb's own 10ms, so the freeverb dry
+        // and wet move together
+        static constexpr double MIX_SMOOTHING_SECONDS = 0.01;
+        juce::SmoothedValue<float> smoothedMix;
+
+        // Last values pushed to the engines
+        int prevEngine = -1;
+        float prevRoomSize = -1.0f;
+        float prevDamping = -1.0f;
+        float prevMix = -1.0f;
 
         // Pre-delay line
         static constexpr float MAX_PRE_DELAY_MS = 250.0f;
-        std::vector<std::vector<float>> preDelayBuffer; // [channel][sample]
-        int preDelayBufferSize = 0;
+        ArenaArray<float> preDelayLines; // one line per layout channel, back to back
+        int preDelayMask = 0;
         int preDelayWritePos = 0;
+        float *preDelayLine(int ch) { return preDelayLines.data() + static_cast<size_t>(ch) * static_cast<size_t>(preDelayMask + 1); }
         juce::SmoothedValue<float> smoothedPreDelay;
+        std::vector<int> readIndex;
+        std::vector<float> readFrac;
     };
 
 } // namespace rau
@@ -7,30 +7,33 @@ namespace rau
     {
         nodeType = "split";
         addParam("bypass", 0.0f);
+        setNumOutlets(2);
     }
 
     void SplitNode::process(int numSamples)
     {
-        if (!outputBuffer.isValid() || inputBuffers.empty() || !inputBuffers[0].isValid())
+        if (inputBuffers.empty() || !inputBuffers[0].isValid())
             return;
 
         auto &in = *inputBuffers[0].buffer;
-        auto &out = *outputBuffer.buffer;
         const int inChannels = in.getNumChannels();
-        const int outChannels = out.getNumChannels();
+        if (inChannels == 0)
+            return;
 
-        // Copy left channel (input ch 0) → output ch 0
-        if (outChannels > 0 && inChannels > 0)
+        // Outlet 0 ← left (input ch 0), outlet 1 ← right (input ch 1).
+        // If input is mono, both outlets carry it.
+        for (int outlet = 0; outlet < 2; ++outlet)
         {
-            out.copyFrom(0, 0, in, 0, 0, numSamples);
-        }
+            auto ref = getOutputBuffer(outlet);
+            if (!ref.isValid())
+                continue;
 
-        // Copy right channel (input ch 1) → output ch 1
-        // If input is mono, duplicate left into right.
-        if (outChannels > 1)
-        {
-            const int srcCh = (inChannels > 1) ? 1 : 0;
-            out.copyFrom(1, 0, in, srcCh, 0, numSamples);
+            auto &out = *ref.buffer;
+            const int srcCh = juce::jmin(outlet, inChannels - 1);
+            for (int ch = 0; ch < out.getNumChannels(); ++ch)
+            {
+                out.copyFrom(ch, 0, in, srcCh, 0, numSamples);
+            }
         }
     }
 
@@ -5,11 +5,12 @@ namespace rau
 {
 
     /**
-     * SplitNode — stereo passthrough that semantically marks a split point.
+     * SplitNode — splits a stereo input into two mono outlets.
      *
-     * Takes a stereo input on inlet 0 and copies left channel to output
-     * channel 0, right channel to output channel 1. Downstream nodes can
-     * tap individual channels via inlet routing.
+     * Takes a stereo input on inlet 0. Outlet 0 carries the left channel
+     * and outlet 1 the right channel, each copied to every channel of its
+     * buffer so either can be used directly or fed to a MergeNode inlet.
+     * A mono input is sent to both outlets.
      */
     class SplitNode : public AudioNodeBase
     {
@@ -0,0 +1,44 @@
+#include "SumNode.h"
+
+namespace rau
+{
+
+    SumNode::SumNode()
+    {
+        nodeType = "sum";
+        addParam("bypass", 0.0f);
+    }
+
+    void SumNode::process(int numSamples)
+    {
+        if (!outputBuffer.isValid())
+            return;
+
+        auto &out = *outputBuffer.buffer;
+        if (inputBuffers.empty() || !inputBuffers[0].isValid())
+        {
+            out.clear(0, numSamples);
+            return;
+        }
+
+        auto &in = *inputBuffers[0].buffer;
+        for (int ch = 0; ch < out.getNumChannels(); ++ch)
+        {
+            if (ch < in.getNumChannels())
+                out.copyFrom(ch, 0, in, ch, 0, numSamples);
+            else
+                out.clear(ch, 0, numSamples);
+        }
+    }
+
+    void SumNode::processRange(const float *const *in, float *const *out,
+                               int numChannels, int start, int numSamples)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            if (out[ch] != in[ch])
+                juce::FloatVectorOperations::copy(out[ch] + start, in[ch] + start, numSamples);
+        }
+    }
+
+} // namespace rau
@@ -0,0 +1,28 @@
+#pragma once
+#include "NodeBase.h"
+
+namespace rau
+{
+
+    /**
+     * SumNode — a bus. Every connection into inlet 0 is summed by the
+     * graph (with its per-connection gain) before the node runs, so the
+     * node itself only passes the sum through.
+     *
+     * Parameters:
+     *   bypass - Bypass flag
+     */
+    class SumNode : public AudioNodeBase
+    {
+    public:
+        SumNode();
+        void process(int numSamples) override;
+
+        int getNumOutputChannels(int inputChannels) const override { return inputChannels; }
+
+        bool isFusible() const override { return true; }
+        void processRange(const float *const *in, float *const *out,
+                          int numChannels, int start, int numSamples) override;
+    };
+
+} // namespace rau
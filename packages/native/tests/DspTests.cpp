@@ -0,0 +1,222 @@
+/**
+ * DspTests — checks of the DSP building blocks under src/dsp that the
+ * graph tests only reach indirectly. main() returns non-zero if any check
+ * fails.
+ *
+ * Usage: RauDspTests
+ */
+
+#include "dsp/ConvolutionWorkerPool.h"
+#include "dsp/FDNReverb.h"
+#include "dsp/PartitionedConvolver.h"
+#include "dsp/SampleFormat.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    int numFailures = 0;
+
+    void check(bool condition, const char *test, const std::string &what)
+    {
+        if (condition)
+            return;
+        std::printf("FAIL %s: %s\n", test, what.c_str());
+        ++numFailures;
+    }
+
+    std::vector<float> noise(int numSamples, unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+        std::vector<float> result(static_cast<size_t>(numSamples));
+        for (auto &v : result)
+            v = dist(rng);
+        return result;
+    }
+
+    // Index of the first sample where `a` and `b` differ, or -1
+    int firstDifference(const std::vector<float> &a, const std::vector<float> &b)
+    {
+        for (size_t i = 0; i < a.size(); ++i)
+            if (a[i] != b[i])
+                return static_cast<int>(i);
+        return a.size() == b.size() ? -1 : static_cast<int>(a.size());
+    }
+
+    // One channel through a convolver, in blocks of the given sizes
+    // (repeated until the input runs out)
+    std::vector<float> convolve(const std::shared_ptr<const rau::PartitionedIR> &ir, rau::ConvolutionWorkerPool *pool,
+                                const std::vector<float> &input, const std::vector<int> &blockSizes)
+    {
+        rau::PartitionedConvolver convolver(ir, 1, pool);
+        std::vector<float> output(input.size());
+        size_t block = 0;
+        for (int start = 0; start < static_cast<int>(input.size()); ++block)
+        {
+            const int n = juce::jmin(blockSizes[block % blockSizes.size()], static_cast<int>(input.size()) - start);
+            const float *in = input.data() + start;
+            float *out = output.data() + start;
+            convolver.process(&in, &out, 1, n);
+            start += n;
+        }
+        return output;
+    }
+
+    // A long IR has an async tail stage; its output mustn't depend on
+    // whether a worker, or the audio thread after a missed deadline,
+    // computes the tail blocks
+    void convolverPoolIsBitIdentical()
+    {
+        constexpr double sampleRate = 48000.0;
+        constexpr int headSize = 64;
+        constexpr int irLength = 12000;
+        constexpr int inputLength = 24000;
+
+        // Decaying noise, so every stage contributes
+        auto response = noise(irLength, 1);
+        for (int i = 0; i < irLength; ++i)
+            response[static_cast<size_t>(i)] *= std::exp(-3.0f * static_cast<float>(i) / irLength);
+        const auto ir = rau::PartitionedIR::create({response}, sampleRate, headSize);
+
+        bool hasAsyncStage = false;
+        for (auto &stage : ir->stages)
+            hasAsyncStage |= stage.partitionSize >= rau::PartitionedConvolver::MIN_ASYNC_PARTITION;
+        check(hasAsyncStage, __func__, "the IR has no stage the pool would run");
+
+        const auto input = noise(inputLength, 2);
+        const std::vector<int> blockSizes = {512, 37, 1000, 256, 5};
+
+        rau::ConvolutionWorkerPool pool;
+        rau::ConvolutionWorkerPool noWorkers(0); // every tail block runs late, inline
+        const auto unpooled = convolve(ir, nullptr, input, blockSizes);
+        const auto pooled = convolve(ir, &pool, input, blockSizes);
+        const auto late = convolve(ir, &noWorkers, input, blockSizes);
+
+        const int pooledDiff = firstDifference(unpooled, pooled);
+        const int lateDiff = firstDifference(unpooled, late);
+        check(pooledDiff < 0, __func__, "pooled output differs at sample " + std::to_string(pooledDiff));
+        check(lateDiff < 0, __func__, "late output differs at sample " + std::to_string(lateDiff));
+
+        // And it is the convolution: compare with the direct sum
+        double peak = 0.0, maxError = 0.0;
+        for (int n = 0; n < inputLength; ++n)
+        {
+            double expected = 0.0;
+            for (int k = 0; k < irLength && k <= n; ++k)
+                expected += static_cast<double>(response[static_cast<size_t>(k)]) * input[static_cast<size_t>(n - k)];
+            peak = std::max(peak, std::abs(expected));
+            maxError = std::max(maxError, std::abs(expected - unpooled[static_cast<size_t>(n)]));
+        }
+        check(maxError <= 1.0e-4 * peak, __func__,
+              "error " + std::to_string(maxError) + " against direct convolution (peak " + std::to_string(peak) + ")");
+    }
+
+    // Every float16 encoding but the NaNs loads to its exact value and
+    // stores back to itself, and halfway between two neighbours stores to
+    // the one with the even mantissa
+    void float16RoundTripsEveryEncoding()
+    {
+        int failures = 0;
+        for (uint32_t h = 0; h <= 0xffffu && failures < 10; ++h)
+        {
+            const uint32_t exponent = (h >> 10) & 0x1fu;
+            const uint32_t mantissa = h & 0x3ffu;
+            if (exponent == 0x1fu && mantissa != 0)
+                continue;
+
+            const float magnitude = exponent == 0x1fu ? INFINITY
+                                    : exponent == 0  ? std::ldexp(static_cast<float>(mantissa), -24)
+                                                     : std::ldexp(static_cast<float>(mantissa | 0x400u), static_cast<int>(exponent) - 25);
+            const float expected = (h & 0x8000u) != 0 ? -magnitude : magnitude;
+
+            const float loaded = rau::Float16Format::load(static_cast<uint16_t>(h));
+            const uint16_t stored = rau::Float16Format::store(loaded);
+            if (loaded != expected || std::signbit(loaded) != std::signbit(expected) || stored != h)
+            {
+                check(false, __func__,
+                      "encoding " + std::to_string(h) + " loads " + std::to_string(loaded) + " and stores " +
+                          std::to_string(stored));
+                ++failures;
+                continue;
+            }
+
+            // Ties, between this and the next larger magnitude
+            if (exponent == 0x1fu || (h & 0x7fffu) == 0x7bffu)
+                continue;
+            const float next = rau::Float16Format::load(static_cast<uint16_t>(h + 1));
+            const uint16_t tie = rau::Float16Format::store(loaded + (next - loaded) * 0.5f);
+            const uint32_t even = (h & 1u) == 0 ? h : h + 1;
+            if (tie != even)
+            {
+                check(false, __func__,
+                      "the tie above encoding " + std::to_string(h) + " stores " + std::to_string(tie));
+                ++failures;
+            }
+        }
+
+        const float nan = rau::Float16Format::load(rau::Float16Format::store(NAN));
+        check(std::isnan(nan), __func__, "NaN stores as " + std::to_string(nan));
+    }
+
+    // An FDN's energy decays 60 dB over the RT60 its room size asks for
+    // (0.3 s · 40^roomSize), measured on the backward-integrated energy of
+    // its impulse response so the tail's fluctuations average out
+    void fdnDecaysOverItsRt60()
+    {
+        constexpr double sampleRate = 48000.0;
+        for (const float roomSize : {0.0f, 0.25f, 0.5f})
+        {
+            const double rt60 = 0.3 * std::pow(40.0, static_cast<double>(roomSize));
+            const int length = static_cast<int>(3.0 * rt60 * sampleRate);
+
+            std::vector<float> tank(static_cast<size_t>(rau::FDNReverb::tankSize(sampleRate)));
+            rau::FDNReverb reverb;
+            reverb.prepare(sampleRate, tank.data());
+            reverb.setParameters(roomSize, 0.0f);
+
+            std::vector<float> left(static_cast<size_t>(length), 0.0f), right(left.size(), 0.0f);
+            left[0] = 1.0f;
+            for (int start = 0; start < length; start += 512)
+            {
+                const int len = std::min(512, length - start);
+                reverb.process(left.data() + start, right.data() + start, len);
+            }
+
+            // energyAfter[n] = energy from sample n to the end
+            std::vector<double> energyAfter(left.size() + 1, 0.0);
+            for (size_t n = left.size(); n-- > 0;)
+                energyAfter[n] = energyAfter[n + 1] + static_cast<double>(left[n]) * left[n] +
+                                 static_cast<double>(right[n]) * right[n];
+
+            // From once every line has fed back, a full RT60 later
+            const auto from = static_cast<size_t>(0.1 * sampleRate);
+            const auto to = from + static_cast<size_t>(rt60 * sampleRate);
+            const double drop = 10.0 * std::log10(energyAfter[from] / energyAfter[to]);
+            check(std::abs(drop - 60.0) < 3.0, __func__,
+                  "room size " + std::to_string(roomSize) + " drops " + std::to_string(drop) + " dB over its RT60");
+        }
+    }
+} // namespace
+
+int main()
+{
+    const std::vector<std::function<void()>> tests = {
+        convolverPoolIsBitIdentical,
+        float16RoundTripsEveryEncoding,
+        fdnDecaysOverItsRt60,
+    };
+
+    for (auto &test : tests)
+        test();
+
+    if (numFailures == 0)
+        std::printf("All DSP tests passed\n");
+    return numFailures == 0 ? 0 : 1;
+}
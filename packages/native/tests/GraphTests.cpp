@@ -0,0 +1,1128 @@
+/**
+ * GraphTests — checks of AudioGraph behaviour that the JS tests can't
+ * reach. Each test builds a small graph through the same ops JS sends and
+ * inspects the result; main() returns non-zero if any check fails.
+ *
+ * Usage: RauGraphTests
+ */
+
+#include "AudioGraph.h"
+#include "GraphState.h"
+#include "nodes/ConvolverNode.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    int numFailures = 0;
+
+    void check(bool condition, const char *test, const std::string &what)
+    {
+        if (condition)
+            return;
+        std::printf("FAIL %s: %s\n", test, what.c_str());
+        ++numFailures;
+    }
+
+    rau::GraphOp makeAddNode(const std::string &id, const std::string &type)
+    {
+        rau::GraphOp op;
+        op.type = rau::GraphOp::AddNode;
+        op.nodeId = id;
+        op.nodeType = type;
+        return op;
+    }
+
+    rau::GraphOp makeConnect(const std::string &from, const std::string &to)
+    {
+        rau::GraphOp op;
+        op.type = rau::GraphOp::Connect;
+        op.fromNodeId = from;
+        op.toNodeId = to;
+        return op;
+    }
+
+    rau::GraphOp makeRemoveNode(const std::string &id)
+    {
+        rau::GraphOp op;
+        op.type = rau::GraphOp::RemoveNode;
+        op.nodeId = id;
+        return op;
+    }
+
+    rau::GraphOp makeSetOutput(const std::string &id)
+    {
+        rau::GraphOp op;
+        op.type = rau::GraphOp::SetOutput;
+        op.nodeId = id;
+        return op;
+    }
+
+    // "from→to" for every feedback connection, in cycle order
+    std::vector<std::string> feedbackEdges(const rau::AudioGraph &graph)
+    {
+        std::vector<std::string> result;
+        for (auto &cycle : graph.getCycles())
+            for (auto &conn : cycle.feedbackConnections)
+                result.push_back(conn.fromNodeId + "→" + conn.toNodeId);
+        return result;
+    }
+
+    // Index of the first sample where `a` and `b` differ, or -1
+    int firstDifference(const std::vector<float> &a, const std::vector<float> &b)
+    {
+        for (size_t i = 0; i < a.size() && i < b.size(); ++i)
+            if (a[i] != b[i])
+                return static_cast<int>(i);
+        return a.size() == b.size() ? -1 : static_cast<int>(std::min(a.size(), b.size()));
+    }
+
+    // Largest absolute difference between `a` and `b`, sample by sample
+    float maxDifference(const std::vector<float> &a, const std::vector<float> &b)
+    {
+        float result = a.size() == b.size() ? 0.0f : INFINITY;
+        for (size_t i = 0; i < a.size() && i < b.size(); ++i)
+            result = std::max(result, std::abs(a[i] - b[i]));
+        return result;
+    }
+
+    // A parameter change posted before block `block`
+    struct ParamChange
+    {
+        int block;
+        std::string nodeId;
+        std::string param;
+        float value;
+    };
+
+    // Every channel of every block, one after another, for `numBlocks`
+    // blocks of seeded noise through `graph`. `beforeBlock` is called
+    // with each block's index before it runs.
+    std::vector<float> render(rau::AudioGraph &graph, int numChannels, int blockSize, int numBlocks,
+                              const std::function<void(int)> &beforeBlock = {})
+    {
+        std::mt19937 rng(1);
+        std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+
+        std::vector<float> result;
+        juce::AudioBuffer<float> buffer(numChannels, blockSize);
+        juce::MidiBuffer midi;
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            if (beforeBlock)
+                beforeBlock(block);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < blockSize; ++i)
+                    buffer.setSample(ch, i, noise(rng));
+            graph.processBlock(buffer, midi);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < blockSize; ++i)
+                    result.push_back(buffer.getSample(ch, i));
+        }
+        return result;
+    }
+
+    // `input` through a one-channel `graph`, in blocks of 256
+    std::vector<float> renderSignal(rau::AudioGraph &graph, const std::vector<float> &input)
+    {
+        std::vector<float> result(input.size());
+        juce::AudioBuffer<float> buffer(1, 256);
+        juce::MidiBuffer midi;
+        for (size_t start = 0; start < input.size(); start += 256)
+        {
+            const int len = static_cast<int>(std::min<size_t>(256, input.size() - start));
+            juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), 1, len);
+            std::copy(input.begin() + static_cast<std::ptrdiff_t>(start),
+                      input.begin() + static_cast<std::ptrdiff_t>(start) + len, block.getWritePointer(0));
+            graph.processBlock(block, midi);
+            std::copy(block.getReadPointer(0), block.getReadPointer(0) + len,
+                      result.begin() + static_cast<std::ptrdiff_t>(start));
+        }
+        return result;
+    }
+
+    // A one-channel graph's impulse response, `length` samples long
+    std::vector<float> impulseResponse(rau::AudioGraph &graph, int length)
+    {
+        std::vector<float> impulse(static_cast<size_t>(length), 0.0f);
+        impulse[0] = 1.0f;
+        return renderSignal(graph, impulse);
+    }
+
+    // Gain in dB at `frequency` of the filter with this impulse response
+    double responseDb(const std::vector<float> &response, double frequency, double sampleRate)
+    {
+        const double w = 2.0 * 3.141592653589793 * frequency / sampleRate;
+        double re = 0.0, im = 0.0;
+        for (size_t n = 0; n < response.size(); ++n)
+        {
+            re += response[n] * std::cos(w * static_cast<double>(n));
+            im -= response[n] * std::sin(w * static_cast<double>(n));
+        }
+        return 10.0 * std::log10(re * re + im * im);
+    }
+
+    std::function<void(int)> applyChanges(rau::AudioGraph &graph, const std::vector<ParamChange> &changes)
+    {
+        return [&graph, changes](int block)
+        {
+            for (auto &change : changes)
+                if (change.block == block)
+                    graph.setNodeParam(change.nodeId, change.param, change.value);
+        };
+    }
+
+    std::string join(const std::vector<std::string> &items)
+    {
+        std::string result;
+        for (auto &item : items)
+            result += (result.empty() ? "" : ", ") + item;
+        return "[" + result + "]";
+    }
+
+    // in → a → b with b → a closing the loop: b → a points back toward the
+    // input, so it's the delayed edge whichever connection comes last
+    void feedbackEdgeIgnoresConnectionOrder()
+    {
+        const std::vector<std::vector<std::pair<std::string, std::string>>> orders = {
+            {{"in", "a"}, {"a", "b"}, {"b", "a"}},
+            {{"b", "a"}, {"a", "b"}, {"in", "a"}},
+            {{"a", "b"}, {"b", "a"}, {"in", "a"}},
+        };
+
+        for (auto &connections : orders)
+        {
+            rau::AudioGraph graph;
+            graph.prepare(48000.0, 256, 2);
+            graph.queueOps({makeAddNode("in", "input"), makeAddNode("a", "gain"), makeAddNode("b", "gain"),
+                            makeSetOutput("b")});
+
+            // One edit per connection, so each publishes its own snapshot
+            for (auto &[from, to] : connections)
+                graph.queueOp(makeConnect(from, to));
+
+            const auto delayed = feedbackEdges(graph);
+            check(delayed == std::vector<std::string>{"b→a"}, __func__,
+                  "connected " + connections.front().first + "→" + connections.front().second +
+                      " first, delayed " + join(delayed));
+        }
+    }
+
+    // Saved state restores the same delayed edges, through the same path
+    // as setStateInformation(): a GraphState chunk applied with setGraph()
+    void feedbackEdgeSurvivesSaveAndRestore()
+    {
+        rau::AudioGraph saved;
+        saved.prepare(48000.0, 256, 2);
+        saved.queueOps({makeAddNode("in", "input"), makeAddNode("a", "gain"), makeAddNode("b", "gain"),
+                        makeConnect("in", "a"), makeConnect("a", "b"), makeConnect("b", "a"),
+                        makeSetOutput("b")});
+
+        rau::GraphState state;
+        state.ops = saved.describeGraph();
+        juce::MemoryBlock chunk;
+        state.write(chunk);
+
+        rau::GraphState loaded;
+        check(loaded.read(chunk.getData(), chunk.getSize()), __func__, "chunk didn't read back");
+
+        rau::AudioGraph restored;
+        restored.prepare(48000.0, 256, 2);
+        restored.setGraph(loaded.ops);
+
+        const auto before = feedbackEdges(saved);
+        const auto after = feedbackEdges(restored);
+        check(before == std::vector<std::string>{"b→a"}, __func__, "saved graph delayed " + join(before));
+        check(after == before, __func__, "restored graph delayed " + join(after));
+    }
+
+    // Re-selection after each edit only searches what the edit can reach;
+    // it must delay the same edges as selecting over the whole graph, as
+    // a restore does
+    void feedbackEdgesMatchFullSelection()
+    {
+        constexpr int numNodes = 12;
+        auto id = [](int i) { return "g" + std::to_string(i); };
+
+        rau::AudioGraph graph;
+        graph.prepare(48000.0, 256, 2);
+        std::vector<rau::GraphOp> ops = {makeAddNode("in", "input"), makeConnect("in", id(0))};
+        for (int i = 0; i < numNodes; ++i)
+            ops.push_back(makeAddNode(id(i), "gain"));
+        ops.push_back(makeSetOutput(id(numNodes - 1)));
+        graph.queueOps(ops);
+
+        std::mt19937 rng(7);
+        std::vector<std::pair<std::string, std::string>> connections;
+        for (int edit = 0; edit < 300; ++edit)
+        {
+            if (connections.empty() || rng() % 3 != 0)
+            {
+                connections.emplace_back(id(static_cast<int>(rng() % numNodes)), id(static_cast<int>(rng() % numNodes)));
+                graph.queueOp(makeConnect(connections.back().first, connections.back().second));
+            }
+            else
+            {
+                const auto index = rng() % connections.size();
+                auto disconnect = makeConnect(connections[index].first, connections[index].second);
+                disconnect.type = rau::GraphOp::Disconnect;
+                graph.queueOp(disconnect);
+                connections.erase(connections.begin() + static_cast<std::ptrdiff_t>(index));
+            }
+
+            rau::AudioGraph fresh;
+            fresh.prepare(48000.0, 256, 2);
+            fresh.setGraph(graph.describeGraph());
+
+            auto incremental = feedbackEdges(graph);
+            auto full = feedbackEdges(fresh);
+            std::sort(incremental.begin(), incremental.end());
+            std::sort(full.begin(), full.end());
+            if (incremental != full)
+            {
+                check(false, __func__, "edit " + std::to_string(edit) + " delayed " + join(incremental) +
+                                           ", full selection " + join(full));
+                return;
+            }
+        }
+    }
+
+    // A parameter set while no blocks run (audio stopped, or before the
+    // host starts playback) is what describeGraph() saves, though only the
+    // next block applies it
+    void paramSetWithoutAudioIsSaved()
+    {
+        rau::AudioGraph graph;
+        graph.prepare(48000.0, 256, 2);
+        graph.queueOps({makeAddNode("in", "input"), makeAddNode("g", "gain"), makeConnect("in", "g"),
+                        makeSetOutput("g")});
+
+        graph.setNodeParam("g", "gain", 0.25f);
+
+        rau::GraphOp update;
+        update.type = rau::GraphOp::UpdateParams;
+        update.nodeId = "g";
+        update.params = {{"bypass", 1.0f}};
+        graph.queueOp(update);
+
+        const auto *gain = graph.getParamHandle("g", "gain")->target;
+        check(gain->load() == 1.0f, __func__, "the gain changed before a block ran");
+
+        bool saved = false;
+        for (auto &op : graph.describeGraph())
+        {
+            if (op.type != rau::GraphOp::AddNode || op.nodeId != "g")
+                continue;
+            check(op.params["gain"] == 0.25f, __func__, "saved gain " + std::to_string(op.params["gain"]));
+            check(op.params["bypass"] == 1.0f, __func__, "saved bypass " + std::to_string(op.params["bypass"]));
+            saved = true;
+        }
+        check(saved, __func__, "gain node missing from describeGraph()");
+
+        juce::AudioBuffer<float> buffer(2, 256);
+        juce::MidiBuffer midi;
+        buffer.clear();
+        graph.processBlock(buffer, midi);
+        check(gain->load() == 0.25f, __func__, "the next block applied gain " + std::to_string(gain->load()));
+    }
+
+    // A pooled delay re-added with a longer maximum has to re-prepare, so
+    // with background preparation on it's reset on the worker while a
+    // pass-through runs in its place, as a fresh delay would be
+    void recycledNodePreparesInBackground()
+    {
+        rau::AudioGraph graph;
+        graph.prepare(48000.0, 256, 1);
+        graph.setBackgroundPreparation(true);
+        graph.prewarmNodes("delay", 1);
+
+        auto delay = makeAddNode("d", "delay");
+        delay.params = {{"maxTime", 3000.0f}};
+        graph.queueOps({makeAddNode("in", "input"), delay, makeConnect("in", "d"), makeSetOutput("d")});
+        check(graph.getNodePool().getNumSpares("delay") == 0, __func__, "the spare wasn't reused");
+
+        juce::AudioBuffer<float> buffer(1, 256);
+        juce::MidiBuffer midi;
+        buffer.clear();
+        buffer.setSample(0, 0, 1.0f);
+        graph.processBlock(buffer, midi);
+        check(buffer.getSample(0, 0) == 1.0f, __func__, "the delay ran before it was reset");
+
+        graph.waitForPreparedNodes();
+        graph.publishPreparedNodes();
+        buffer.clear();
+        buffer.setSample(0, 0, 1.0f);
+        graph.processBlock(buffer, midi);
+        check(buffer.getSample(0, 0) == 0.0f, __func__, "the reset delay didn't replace the pass-through");
+    }
+
+    // An ID that changes type to "input" and back gets a new node each
+    // time, not the one it had before it became an input
+    void retypedNodeIsReplaced()
+    {
+        rau::AudioGraph graph;
+        graph.prepare(48000.0, 256, 1);
+
+        auto gain = makeAddNode("x", "gain");
+        gain.params = {{"gain", 0.5f}};
+        graph.queueOps({makeAddNode("in", "input"), gain, makeConnect("in", "x"), makeSetOutput("x")});
+        graph.queueOp(makeAddNode("x", "input"));
+        graph.queueOp(gain);
+
+        // Two blocks, so any ramp has settled
+        juce::AudioBuffer<float> buffer(1, 256);
+        juce::MidiBuffer midi;
+        for (int block = 0; block < 2; ++block)
+        {
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample(0, i, 1.0f);
+            graph.processBlock(buffer, midi);
+        }
+        check(buffer.getSample(0, 255) == 0.5f, __func__,
+              "x passes " + std::to_string(buffer.getSample(0, 255)) + ", not the gain's 0.5");
+
+        int described = 0;
+        for (auto &op : graph.describeGraph())
+        {
+            if (op.type != rau::GraphOp::AddNode || op.nodeId != "x")
+                continue;
+            ++described;
+            check(op.nodeType == "gain", __func__, "describeGraph() has x as " + op.nodeType);
+        }
+        check(described == 1, __func__, "describeGraph() has " + std::to_string(described) + " x nodes");
+
+        int reported = 0;
+        for (auto &node : graph.getMemoryReport().nodes)
+            reported += node.nodeId == "x" ? 1 : 0;
+        check(reported == 1, __func__, "the memory report has " + std::to_string(reported) + " x nodes");
+    }
+
+    // in → d → g, resubmitted with setGraph() before block 3: the same
+    // graph but for g's gain, or (for the reference) only that gain set
+    std::vector<float> renderResubmitted(bool resubmit)
+    {
+        rau::AudioGraph graph;
+        graph.prepare(48000.0, 256, 2);
+        auto delay = makeAddNode("d", "delay");
+        delay.params = {{"time", 20.0f}, {"maxTime", 200.0f}, {"feedback", 0.6f}};
+        graph.queueOps({makeAddNode("in", "input"), delay, makeAddNode("g", "gain"), makeConnect("in", "d"),
+                        makeConnect("d", "g"), makeSetOutput("g")});
+        const auto *delayNode = graph.getNode("d");
+
+        auto output = render(graph, 2, 256, 8, [&](int block)
+                             {
+                                 if (block != 3)
+                                     return;
+                                 if (!resubmit)
+                                 {
+                                     graph.setNodeParam("g", "gain", 0.5f);
+                                     return;
+                                 }
+                                 auto desired = graph.describeGraph();
+                                 for (auto &op : desired)
+                                     if (op.type == rau::GraphOp::AddNode && op.nodeId == "g")
+                                         op.params["gain"] = 0.5f;
+                                 graph.setGraph(desired); });
+        check(graph.getNode("d") == delayNode, __func__, "setGraph() replaced the delay");
+        return output;
+    }
+
+    // A node whose ID and type survive a setGraph() keeps its state (the
+    // delay's line carries on) and only has its parameters updated
+    void setGraphKeepsMatchingNodes()
+    {
+        const auto resubmitted = renderResubmitted(true);
+        const auto reference = renderResubmitted(false);
+        const int diff = firstDifference(resubmitted, reference);
+        check(diff < 0, __func__, "resubmitted output differs at sample " + std::to_string(diff));
+    }
+
+    // The memory report lists each node's arena bytes (a delay's grow
+    // with its maximum time; a gain has none), and once a budget is set
+    // the memory allocated past it shows as overBudget
+    void memoryReportFollowsNodesAndBudget()
+    {
+        rau::AudioGraph graph;
+        graph.prepare(48000.0, 256, 2);
+        auto shortDelay = makeAddNode("short", "delay");
+        shortDelay.params = {{"maxTime", 100.0f}};
+        auto longDelay = makeAddNode("long", "delay");
+        longDelay.params = {{"maxTime", 1000.0f}};
+        graph.queueOps({makeAddNode("in", "input"), shortDelay, longDelay, makeAddNode("g", "gain"),
+                        makeConnect("in", "short"), makeConnect("short", "long"), makeConnect("long", "g"),
+                        makeSetOutput("g")});
+
+        auto bytesOf = [](const rau::GraphMemoryReport &report, const std::string &id)
+        {
+            for (auto &node : report.nodes)
+                if (node.nodeId == id)
+                    return node.bytes;
+            return size_t(0);
+        };
+
+        const auto report = graph.getMemoryReport();
+        const size_t shortBytes = bytesOf(report, "short");
+        const size_t longBytes = bytesOf(report, "long");
+        check(shortBytes >= 4800 * sizeof(float) * 2, __func__,
+              "short delay has " + std::to_string(shortBytes) + " bytes");
+        check(longBytes >= 8 * shortBytes, __func__, "long delay has " + std::to_string(longBytes) + " bytes");
+        check(bytesOf(report, "g") == 0, __func__, "gain has " + std::to_string(bytesOf(report, "g")) + " bytes");
+        check(report.inUse >= shortBytes + longBytes, __func__, "in use " + std::to_string(report.inUse));
+        check(report.overBudget == 0, __func__, "over budget without one");
+
+        // Nothing more fits: the next delay's line comes from the heap
+        graph.setMemoryBudget(report.reserved);
+        auto extra = makeAddNode("extra", "delay");
+        extra.params = {{"maxTime", 5000.0f}};
+        graph.queueOps({extra, makeConnect("g", "extra"), makeSetOutput("extra")});
+
+        const auto over = graph.getMemoryReport();
+        const size_t extraBytes = bytesOf(over, "extra");
+        check(over.budget == report.reserved, __func__, "budget " + std::to_string(over.budget));
+        check(over.reserved <= over.budget, __func__, "reserved " + std::to_string(over.reserved) + " past the budget");
+        check(extraBytes > 0 && over.overBudget >= extraBytes, __func__,
+              "over budget by " + std::to_string(over.overBudget) + " for a " + std::to_string(extraBytes) +
+                  "-byte delay");
+        check(over.inUse >= report.inUse + extraBytes, __func__, "in use " + std::to_string(over.inUse));
+    }
+
+    // Feedback delay output with the given line storage
+    std::vector<float> renderDelay(float storage)
+    {
+        rau::AudioGraph graph;
+        graph.prepare(48000.0, 256, 2);
+
+        auto delay = makeAddNode("d", "delay");
+        delay.params = {{"time", 7.0f}, {"maxTime", 100.0f}, {"feedback", 0.7f}, {"storage", storage}};
+        graph.queueOps({makeAddNode("in", "input"), delay, makeConnect("in", "d"), makeSetOutput("d")});
+        return render(graph, 2, 256, 40);
+    }
+
+    // A float16 line keeps 11 significant bits, so even recirculating
+    // through feedback it stays within a few dB of float16's ~66 dB
+    void float16DelayKeepsItsPrecision()
+    {
+        const auto reference = renderDelay(0.0f);
+        const auto half = renderDelay(1.0f);
+
+        double signal = 0.0, error = 0.0;
+        for (size_t i = 0; i < reference.size(); ++i)
+        {
+            const double difference = static_cast<double>(half[i]) - reference[i];
+            signal += static_cast<double>(reference[i]) * reference[i];
+            error += difference * difference;
+        }
+        const double snr = 10.0 * std::log10(signal / std::max(error, 1.0e-30));
+        check(error > 0.0, __func__, "float16 storage changed nothing");
+        check(snr >= 60.0, __func__, "float16 delay SNR " + std::to_string(snr) + " dB");
+    }
+
+    // A modulator's output through the graph, in host blocks of the given
+    // sizes (repeated until `numSamples`)
+    std::vector<float> renderModulator(const rau::GraphOp &modulator, const std::vector<int> &blockSizes, int numSamples)
+    {
+        rau::AudioGraph graph;
+        graph.prepare(48000.0, 256, 1);
+        graph.queueOps({modulator, makeSetOutput(modulator.nodeId)});
+
+        std::vector<float> result;
+        juce::MidiBuffer midi;
+        for (size_t block = 0; static_cast<int>(result.size()) < numSamples; ++block)
+        {
+            const int size = blockSizes[block % blockSizes.size()];
+            juce::AudioBuffer<float> buffer(1, size);
+            buffer.clear();
+            graph.processBlock(buffer, midi);
+            for (int i = 0; i < size; ++i)
+                result.push_back(buffer.getSample(0, i));
+        }
+        result.resize(static_cast<size_t>(numSamples));
+        return result;
+    }
+
+    // Control points fall every controlInterval samples of the stream, so
+    // the same modulator gives the same output whatever the host's blocks
+    void modulatorsIgnoreBlockSize()
+    {
+        auto lfo = makeAddNode("m", "lfo");
+        lfo.params = {{"rate", 40.0f}, {"shape", 1.0f}, {"controlInterval", 16.0f}};
+        auto envelope = makeAddNode("m", "envelope");
+        envelope.params = {{"attack", 2.0f}, {"decay", 5.0f}, {"gate", 1.0f}, {"controlInterval", 16.0f}};
+
+        for (auto &modulator : {lfo, envelope})
+        {
+            const auto whole = renderModulator(modulator, {256}, 2048);
+            const auto split = renderModulator(modulator, {7, 100, 1, 33, 64, 51}, 2048);
+            for (size_t i = 0; i < whole.size(); ++i)
+            {
+                if (whole[i] == split[i])
+                    continue;
+                check(false, __func__, modulator.nodeType + " differs at sample " + std::to_string(i));
+                break;
+            }
+        }
+    }
+
+    // Square and sample & hold only ever output the values they step
+    // between, never a point on a ramp into the edge
+    void steppedLfoShapesHold()
+    {
+        for (const float shape : {3.0f, 4.0f})
+        {
+            auto lfo = makeAddNode("m", "lfo");
+            lfo.params = {{"rate", 70.0f}, {"shape", shape}, {"depth", 1.0f}, {"controlInterval", 64.0f}};
+            const auto output = renderModulator(lfo, {100}, 4800);
+
+            int changes = 0;
+            for (size_t i = 1; i < output.size(); ++i)
+            {
+                if (output[i] == output[i - 1])
+                    continue;
+                ++changes;
+                check(i % 64 == 0, __func__,
+                      "shape " + std::to_string(static_cast<int>(shape)) + " changes mid-interval at sample " +
+                          std::to_string(i));
+                if (shape == 3.0f)
+                    check(output[i] == 0.0f || output[i] == 1.0f, __func__,
+                          "square outputs " + std::to_string(output[i]) + " at sample " + std::to_string(i));
+            }
+            check(changes > 0, __func__, "shape " + std::to_string(static_cast<int>(shape)) + " never changes");
+        }
+    }
+
+    // src → g1 → p → d → g2, where every node is fusible. With `split`,
+    // meters on g1, p and d give each a second consumer, so nothing fuses.
+    std::vector<float> renderFusibleChain(const std::string &sourceType, bool split)
+    {
+        rau::AudioGraph graph;
+        graph.prepare(48000.0, 256, 2);
+
+        auto source = makeAddNode("src", sourceType);
+        if (sourceType == "lfo")
+            source.params = {{"rate", 30.0f}};
+        std::vector<rau::GraphOp> ops = {source, makeAddNode("g1", "gain"), makeAddNode("p", "pan"),
+                                         makeAddNode("d", "distortion"), makeAddNode("g2", "gain"),
+                                         makeConnect("src", "g1"), makeConnect("g1", "p"), makeConnect("p", "d"),
+                                         makeConnect("d", "g2"), makeSetOutput("g2")};
+        if (split)
+        {
+            for (const std::string id : {"g1", "p", "d"})
+            {
+                ops.push_back(makeAddNode(id + "Meter", "meter"));
+                ops.push_back(makeConnect(id, id + "Meter"));
+            }
+        }
+        graph.queueOps(ops);
+
+        // Ramps that run across block boundaries, then a bypassed member
+        // (which runs the chain unfused) and back
+        const std::vector<ParamChange> changes = {
+            {2, "g1", "gain", 0.5f},
+            {2, "p", "pan", -0.6f},
+            {4, "d", "drive", 4.0f},
+            {4, "g2", "gain", 1.5f},
+            {5, "d", "mix", 0.7f},
+            {6, "p", "bypass", 1.0f},
+            {7, "g1", "gain", 2.0f},
+            {8, "p", "bypass", 0.0f},
+            {8, "p", "pan", 0.8f},
+            {9, "d", "distortionType", 1.0f},
+        };
+        return render(graph, 2, 256, 12, applyChanges(graph, changes));
+    }
+
+    // A fused chain is bit-identical to the same nodes run one by one: on
+    // the tiled path, with a bypassed member, and with a mono source
+    // feeding the stereo pan (the mixed-width fallback)
+    void fusedChainMatchesUnfused()
+    {
+        for (const std::string source : {"input", "lfo"})
+        {
+            const auto fused = renderFusibleChain(source, false);
+            const auto unfused = renderFusibleChain(source, true);
+            const int diff = firstDifference(fused, unfused);
+            check(diff < 0, __func__, "from " + source + ", fused output differs at sample " + std::to_string(diff));
+        }
+    }
+
+    // The input, a filter and a distortion of it, all connected to one
+    // inlet of a gain with their own connection gains, which change at
+    // block 4. The junction sums them as if each ran alone.
+    void summingJunctionMatchesSum()
+    {
+        constexpr int numBlocks = 8;
+        constexpr int changeBlock = 4;
+        auto filter = makeAddNode("f", "filter");
+        filter.params = {{"cutoff", 800.0f}};
+        auto drive = makeAddNode("d", "distortion");
+        drive.params = {{"drive", 3.0f}};
+
+        struct Branch
+        {
+            rau::GraphOp node;
+            float gain, laterGain;
+        };
+        const std::vector<Branch> branches = {
+            {makeAddNode("in", "input"), 1.0f, 0.3f}, {filter, 0.5f, -1.0f}, {drive, -0.25f, 2.0f}};
+        auto feed = [](const std::string &from, float gain)
+        {
+            auto conn = makeConnect(from, "sum");
+            conn.gain = gain;
+            return conn;
+        };
+
+        rau::AudioGraph graph;
+        graph.prepare(48000.0, 256, 2);
+        std::vector<rau::GraphOp> ops = {makeAddNode("in", "input"), filter, drive, makeAddNode("sum", "gain"),
+                                         makeConnect("in", "f"), makeConnect("in", "d"), makeSetOutput("sum")};
+        for (auto &branch : branches)
+            ops.push_back(feed(branch.node.nodeId, branch.gain));
+        graph.queueOps(ops);
+        const auto summed = render(graph, 2, 256, numBlocks, [&](int block)
+                                   {
+                                       if (block == changeBlock)
+                                           for (auto &branch : branches)
+                                               graph.queueOp(feed(branch.node.nodeId, branch.laterGain)); });
+
+        std::vector<float> expected(summed.size(), 0.0f);
+        const size_t changeSample = static_cast<size_t>(changeBlock * 2 * 256);
+        for (auto &branch : branches)
+        {
+            rau::AudioGraph alone;
+            alone.prepare(48000.0, 256, 2);
+            std::vector<rau::GraphOp> aloneOps = {makeAddNode("in", "input")};
+            if (branch.node.nodeId != "in")
+                aloneOps.insert(aloneOps.end(), {branch.node, makeConnect("in", branch.node.nodeId)});
+            aloneOps.push_back(makeSetOutput(branch.node.nodeId));
+            alone.queueOps(aloneOps);
+
+            const auto output = render(alone, 2, 256, numBlocks);
+            for (size_t i = 0; i < expected.size(); ++i)
+                expected[i] += output[i] * (i < changeSample ? branch.gain : branch.laterGain);
+        }
+
+        const float error = maxDifference(summed, expected);
+        check(error < 1.0e-5f, __func__, "junction differs from the sum by " + std::to_string(error));
+    }
+
+    // An LFO into a gain's "gain" parameter, with each curve: at sample s
+    // the gain is its value plus offset + depth·curve(lfo[s]), following
+    // the LFO sample by sample within the block
+    void modulationFollowsItsSource()
+    {
+        constexpr int numBlocks = 6;
+        auto lfo = makeAddNode("m", "lfo");
+        lfo.params = {{"rate", 150.0f}, {"controlInterval", 1.0f}};
+
+        auto renderAlone = [&](const rau::GraphOp &node)
+        {
+            rau::AudioGraph graph;
+            graph.prepare(48000.0, 256, 1);
+            graph.queueOps({makeAddNode("in", "input"), node, makeSetOutput(node.nodeId)});
+            return render(graph, 1, 256, numBlocks);
+        };
+        const auto input = renderAlone(makeAddNode("in", "input"));
+        const auto source = renderAlone(lfo);
+
+        using Curve = rau::ModulationCurve;
+        for (const auto curve : {Curve::Linear, Curve::Exponential, Curve::Logarithmic})
+        {
+            constexpr float base = 0.5f, depth = 0.8f, offset = 0.1f;
+            auto gain = makeAddNode("g", "gain");
+            gain.params = {{"gain", base}};
+            auto modulation = makeConnect("m", "g");
+            modulation.toParam = "gain";
+            modulation.gain = depth;
+            modulation.offset = offset;
+            modulation.curve = curve;
+
+            rau::AudioGraph graph;
+            graph.prepare(48000.0, 256, 1);
+            graph.queueOps({makeAddNode("in", "input"), lfo, gain, makeConnect("in", "g"), modulation,
+                            makeSetOutput("g")});
+            const auto modulated = render(graph, 1, 256, numBlocks);
+
+            std::vector<float> expected(input.size());
+            for (size_t i = 0; i < expected.size(); ++i)
+            {
+                const float x = source[i];
+                const float shaped = curve == Curve::Linear        ? x
+                                     : curve == Curve::Exponential ? x * std::abs(x)
+                                                                   : std::copysign(std::sqrt(std::abs(x)), x);
+                expected[i] = input[i] * (base + (depth * shaped + offset));
+            }
+
+            const float error = maxDifference(modulated, expected);
+            check(error < 1.0e-5f, __func__,
+                  "curve " + std::to_string(static_cast<int>(curve)) + " differs by " + std::to_string(error));
+        }
+    }
+
+    // in → f → g with f's cutoff and g's gain driven either by bound host
+    // parameters or by setNodeParam() with the mapped values, changed
+    // before the same blocks
+    std::vector<float> renderHostAutomation(bool bound)
+    {
+        rau::AudioGraph graph;
+        graph.prepare(48000.0, 256, 2);
+        graph.queueOps({makeAddNode("in", "input"), makeAddNode("f", "filter"), makeAddNode("g", "gain"),
+                        makeConnect("in", "f"), makeConnect("f", "g"), makeSetOutput("g")});
+
+        struct Automation
+        {
+            std::string nodeId, param;
+            rau::ParamRange range;
+            std::vector<std::pair<int, float>> values; // block, normalised value
+            std::atomic<float> source{0.0f};
+        };
+        Automation gain{"g", "gain", {0.0f, 2.0f, 1.0f}, {{0, 0.5f}, {2, 0.1f}, {5, 0.9f}}};
+        Automation cutoff{"f", "cutoff", {20.0f, 20000.0f, 0.3f}, {{0, 0.6f}, {3, 0.2f}, {5, 0.8f}}};
+
+        if (bound)
+            for (auto *automation : {&gain, &cutoff})
+                graph.bindHostParam(automation->nodeId, automation->param, &automation->source, automation->range);
+
+        return render(graph, 2, 256, 8, [&](int block)
+                      {
+                          for (auto *automation : {&gain, &cutoff})
+                          {
+                              for (auto [at, value] : automation->values)
+                              {
+                                  if (at != block)
+                                      continue;
+                                  if (bound)
+                                      automation->source.store(value);
+                                  else
+                                      graph.setNodeParam(automation->nodeId, automation->param,
+                                                         automation->range.toActual(value));
+                              }
+                          } });
+    }
+
+    // A host parameter change lands in the block it's made before, like a
+    // parameter set directly; it doesn't wait for a round trip
+    void hostBindingLandsInItsBlock()
+    {
+        const auto bound = renderHostAutomation(true);
+        const auto direct = renderHostAutomation(false);
+        const int diff = firstDifference(bound, direct);
+        check(diff < 0, __func__, "bound output differs at sample " + std::to_string(diff));
+    }
+
+    // The four bands of a crossover, summed back into one inlet, are the
+    // input allpassed: flat at every frequency, across each split
+    void crossoverBandsSumToInput()
+    {
+        rau::AudioGraph graph;
+        graph.prepare(48000.0, 256, 1);
+        std::vector<rau::GraphOp> ops = {makeAddNode("in", "input"), makeAddNode("x", "crossover"),
+                                         makeAddNode("sum", "gain"), makeConnect("in", "x"), makeSetOutput("sum")};
+        for (int band = 0; band < 4; ++band)
+        {
+            auto conn = makeConnect("x", "sum");
+            conn.fromOutlet = band;
+            ops.push_back(conn);
+        }
+        graph.queueOps(ops);
+
+        const auto response = impulseResponse(graph, 16384);
+        for (const double frequency : {30.0, 150.0, 200.0, 450.0, 1000.0, 2500.0, 5000.0, 12000.0})
+        {
+            const double db = responseDb(response, frequency, 48000.0);
+            check(std::abs(db) < 0.05, __func__,
+                  "bands sum to " + std::to_string(db) + " dB at " + std::to_string(frequency) + " Hz");
+        }
+    }
+
+    // A ModDelay with no sweep is a static delay: every voice reads the
+    // same whole-sample tap, with the same feedback and mix
+    void unsweptModDelayMatchesDelay()
+    {
+        auto renderNode = [](const rau::GraphOp &node)
+        {
+            rau::AudioGraph graph;
+            graph.prepare(48000.0, 256, 2);
+            graph.queueOps({makeAddNode("in", "input"), node, makeConnect("in", node.nodeId),
+                            makeSetOutput(node.nodeId)});
+            return render(graph, 2, 256, 12);
+        };
+
+        auto delay = makeAddNode("d", "delay");
+        delay.params = {{"time", 15.0f}, {"maxTime", 100.0f}, {"feedback", 0.4f}, {"mix", 0.7f}};
+        const auto reference = renderNode(delay);
+
+        for (const float voices : {1.0f, 3.0f})
+        {
+            auto chorus = makeAddNode("d", "modDelay");
+            chorus.params = {{"time", 15.0f}, {"depth", 0.0f}, {"rate", 2.0f}, {"voices", voices},
+                             {"feedback", 0.4f}, {"mix", 0.7f}};
+            const float error = maxDifference(renderNode(chorus), reference);
+            check(error < 1.0e-5f, __func__,
+                  std::to_string(static_cast<int>(voices)) + " voices differ by " + std::to_string(error));
+        }
+    }
+
+    // A phaser with no mix passes its input through untouched; fully wet
+    // with no sweep or feedback it's a pure allpass cascade, flat at
+    // every frequency
+    void phaserIsAllpass()
+    {
+        auto dry = makeAddNode("p", "phaser");
+        dry.params = {{"mix", 0.0f}, {"feedback", 0.7f}, {"rate", 3.0f}};
+        rau::AudioGraph graph;
+        graph.prepare(48000.0, 256, 2);
+        graph.queueOps({makeAddNode("in", "input"), dry, makeConnect("in", "p"), makeSetOutput("p")});
+        const auto output = render(graph, 2, 256, 6);
+
+        rau::AudioGraph inputOnly;
+        inputOnly.prepare(48000.0, 256, 2);
+        inputOnly.queueOps({makeAddNode("in", "input"), makeSetOutput("in")});
+        const int diff = firstDifference(output, render(inputOnly, 2, 256, 6));
+        check(diff < 0, __func__, "with mix 0, output differs at sample " + std::to_string(diff));
+
+        for (const float stages : {2.0f, 6.0f, 12.0f})
+        {
+            auto wet = makeAddNode("p", "phaser");
+            wet.params = {{"mix", 1.0f}, {"depth", 0.0f}, {"feedback", 0.0f}, {"stages", stages}};
+            rau::AudioGraph allpass;
+            allpass.prepare(48000.0, 256, 1);
+            allpass.queueOps({makeAddNode("in", "input"), wet, makeConnect("in", "p"), makeSetOutput("p")});
+
+            const auto response = impulseResponse(allpass, 8192);
+            for (const double frequency : {50.0, 400.0, 1000.0, 3000.0, 15000.0})
+            {
+                const double db = responseDb(response, frequency, 48000.0);
+                check(std::abs(db) < 0.01, __func__,
+                      std::to_string(static_cast<int>(stages)) + " stages: " + std::to_string(db) + " dB at " +
+                          std::to_string(frequency) + " Hz");
+            }
+        }
+    }
+
+    // A bank of filters on the input, summed at the output. With
+    // `unbatched`, a zero-depth modulation edge into each filter's gainDb
+    // makes it run alone; its parameters are unchanged.
+    std::vector<float> renderFilterBank(bool unbatched)
+    {
+        constexpr int numFilters = 20; // a full batch and a partial one
+        auto id = [](int i) { return "f" + std::to_string(i); };
+
+        rau::AudioGraph graph;
+        graph.prepare(48000.0, 256, 2);
+
+        std::vector<rau::GraphOp> ops = {makeAddNode("in", "input"), makeAddNode("sum", "gain")};
+        for (int i = 0; i < numFilters; ++i)
+        {
+            auto filter = makeAddNode(id(i), "filter");
+            filter.params = {{"filterType", static_cast<float>(i % 4)},
+                             {"cutoff", 150.0f * static_cast<float>(i + 1)},
+                             {"resonance", 0.5f + 0.1f * static_cast<float>(i)}};
+            ops.push_back(filter);
+            ops.push_back(makeConnect("in", id(i)));
+            ops.push_back(makeConnect(id(i), "sum"));
+            if (unbatched)
+            {
+                auto modulation = makeConnect("in", id(i));
+                modulation.toParam = "gainDb";
+                modulation.gain = 0.0f;
+                ops.push_back(modulation);
+            }
+        }
+        ops.push_back(makeSetOutput("sum"));
+        graph.queueOps(ops);
+
+        const auto changes = applyChanges(graph, {
+                                                     {2, "f3", "bypass", 1.0f},
+                                                     {3, "f5", "cutoff", 3000.0f},
+                                                     {3, "f9", "resonance", 4.0f},
+                                                     {5, "f12", "filterType", 1.0f},
+                                                     {7, "f3", "bypass", 0.0f},
+                                                 });
+        return render(graph, 2, 256, 10, [&](int block)
+                      {
+                          changes(block);
+                          if (block == 4)
+                              graph.queueOp(makeRemoveNode(id(7)));
+                      });
+    }
+
+    // Batched filters are bit-identical to the same filters run one by
+    // one, with a member bypassed, parameters changed mid-run and a member
+    // removed
+    void batchedFiltersMatchUnbatched()
+    {
+        const auto batched = renderFilterBank(false);
+        const auto unbatched = renderFilterBank(true);
+        const int diff = firstDifference(batched, unbatched);
+        check(diff < 0, __func__, "batched output differs at sample " + std::to_string(diff));
+    }
+
+    // in → g → out, with a MIDI gate modulating g's gain, over host blocks
+    // of the given sizes. The notes and gain changes fall at the same
+    // stream positions whatever the blocks; each channel is returned whole.
+    std::vector<float> renderWithMidi(const std::vector<int> &hostBlocks)
+    {
+        constexpr int numChannels = 2;
+        rau::AudioGraph graph;
+        graph.prepare(48000.0, 128, numChannels);
+
+        auto gate = makeConnect("m", "g");
+        gate.toParam = "gain";
+        gate.gain = 0.5f;
+        graph.queueOps({makeAddNode("in", "input"), makeAddNode("m", "midi_input"), makeAddNode("g", "gain"),
+                        makeConnect("in", "g"), gate, makeSetOutput("g")});
+
+        // On a sub-block's first and last samples, and inside one
+        juce::MidiBuffer notes;
+        notes.addEvent(juce::MidiMessage::noteOn(1, 60, 1.0f), 200);
+        notes.addEvent(juce::MidiMessage::noteOff(1, 60), 383);
+        notes.addEvent(juce::MidiMessage::noteOn(1, 64, 1.0f), 384);
+        notes.addEvent(juce::MidiMessage::noteOff(1, 64), 700);
+        notes.addEvent(juce::MidiMessage::noteOn(1, 67, 1.0f), 1000);
+
+        // At host block starts in both runs
+        const std::vector<std::pair<int, float>> gains = {{0, 0.25f}, {512, 1.5f}, {812, 0.75f}};
+
+        int total = 0;
+        for (int size : hostBlocks)
+            total += size;
+        std::mt19937 rng(1);
+        std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+        std::vector<float> input(static_cast<size_t>(numChannels * total));
+        for (auto &v : input)
+            v = noise(rng);
+
+        std::vector<float> result(input.size());
+        juce::MidiBuffer midi;
+        int start = 0;
+        for (int size : hostBlocks)
+        {
+            for (auto &[position, value] : gains)
+                if (position == start)
+                    graph.setNodeParam("g", "gain", value);
+
+            juce::AudioBuffer<float> buffer(numChannels, size);
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < size; ++i)
+                    buffer.setSample(ch, i, input[static_cast<size_t>(ch * total + start + i)]);
+            midi.clear();
+            midi.addEvents(notes, start, size, -start);
+            graph.processBlock(buffer, midi);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < size; ++i)
+                    result[static_cast<size_t>(ch * total + start + i)] = buffer.getSample(ch, i);
+            start += size;
+        }
+        return result;
+    }
+
+    // A host block longer than the prepared size is split into prepared
+    // blocks, and runs exactly as if the host had sent those: MIDI lands
+    // at the same samples and parameters update at the same points
+    void oversizedHostBlockMatchesPreparedBlocks()
+    {
+        const auto split = renderWithMidi({512, 300, 512, 512});
+        const auto prepared = renderWithMidi({128, 128, 128, 128, 128, 128, 44, 128, 128, 128, 128, 128, 128, 128, 128});
+        const int difference = firstDifference(split, prepared);
+        check(difference < 0, __func__, "output differs at sample " + std::to_string(difference));
+
+        // By the end the 20 ms ramp has settled on 0.75 plus the held note's 0.5.
+        // Modulation sums into a pool buffer, so this also fails if the
+        // buffers carry anything over from an earlier sub-block.
+        const size_t last = split.size() / 2 - 1;
+        std::mt19937 rng(1);
+        std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+        float input = 0.0f;
+        for (size_t i = 0; i <= last; ++i)
+            input = noise(rng);
+        check(std::abs(split[last] - 1.25f * input) <= 1.0e-4f, __func__,
+              "the last sample is " + std::to_string(split[last]) + " for an input of " + std::to_string(input));
+    }
+
+    // A convolver's output, prepared for `preparedSize` and run in
+    // sub-blocks of `subBlockSize`
+    std::vector<float> renderConvolver(int preparedSize, int subBlockSize, int &headSize)
+    {
+        rau::AudioGraph graph;
+        graph.prepare(48000.0, preparedSize, 2);
+        auto convolver = makeAddNode("c", "convolver");
+        convolver.params = {{"mix", 1.0f}};
+        graph.queueOps({makeAddNode("in", "input"), convolver, makeConnect("in", "c"), makeSetOutput("c")});
+
+        rau::IRData ir;
+        ir.sampleRate = 48000.0;
+        ir.channels.assign(2, std::vector<float>(3000));
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<float> noise(-0.1f, 0.1f);
+        for (auto &channel : ir.channels)
+            for (auto &v : channel)
+                v = noise(rng);
+        auto *node = static_cast<rau::ConvolverNode *>(graph.getNode("c"));
+        node->loadIRSync(ir);
+
+        // The rebuilt engine is adopted at the top of the first block
+        graph.setSubBlockSize(subBlockSize);
+        juce::SharedResourcePointer<rau::BackgroundWorker>()->waitUntilIdle();
+        headSize = node->getHeadSize();
+        return render(graph, 2, 512, 8);
+    }
+
+    // Sub-blocks shorter than the prepared block get a head sized for
+    // them, as if the graph had been prepared at that size
+    void convolverHeadFollowsSubBlockSize()
+    {
+        int splitHead = 0, preparedHead = 0, wholeHead = 0;
+        const auto split = renderConvolver(512, 64, splitHead);
+        const auto prepared = renderConvolver(64, 0, preparedHead);
+        renderConvolver(512, 0, wholeHead);
+
+        check(wholeHead == 512, __func__, "whole blocks use a head of " + std::to_string(wholeHead));
+        check(splitHead == 64, __func__, "64-sample sub-blocks use a head of " + std::to_string(splitHead));
+        const int difference = firstDifference(split, prepared);
+        check(difference < 0, __func__, "output differs from a graph prepared at 64 at sample " +
+                                            std::to_string(difference));
+    }
+} // namespace
+
+int main()
+{
+    const std::vector<std::function<void()>> tests = {
+        feedbackEdgeIgnoresConnectionOrder,
+        feedbackEdgeSurvivesSaveAndRestore,
+        feedbackEdgesMatchFullSelection,
+        paramSetWithoutAudioIsSaved,
+        recycledNodePreparesInBackground,
+        retypedNodeIsReplaced,
+        setGraphKeepsMatchingNodes,
+        memoryReportFollowsNodesAndBudget,
+        float16DelayKeepsItsPrecision,
+        modulatorsIgnoreBlockSize,
+        steppedLfoShapesHold,
+        fusedChainMatchesUnfused,
+        summingJunctionMatchesSum,
+        modulationFollowsItsSource,
+        hostBindingLandsInItsBlock,
+        crossoverBandsSumToInput,
+        unsweptModDelayMatchesDelay,
+        phaserIsAllpass,
+        batchedFiltersMatchUnbatched,
+        oversizedHostBlockMatchesPreparedBlocks,
+        convolverHeadFollowsSubBlockSize,
+    };
+
+    for (auto &test : tests)
+        test();
+
+    if (numFailures == 0)
+        std::printf("All graph tests passed\n");
+    return numFailures == 0 ? 0 : 1;
+}